@@ -21,7 +21,6 @@
 
 #include "lib.h"
 #include <stdio.h>
-#include <math.h>
 #include "pico/platform.h"
 #include "hardware/sync.h"
 
@@ -40,8 +39,8 @@
 #define CENTER_X         64  // Center of 128 pixel wide display
 #define CENTER_Y         32  // Center of 64 pixel high display
 
-// EC11 has 20 detents per revolution; with X4 decoding that's 80 counts per rev
-#define ENCODER_COUNTS_PER_REV 80
+// EC11 has 20 detents per revolution; the driver steps once per detent
+#define ENCODER_COUNTS_PER_REV 20
 
 // Encoder mode configuration
 typedef enum {
@@ -64,26 +63,32 @@ static encoder_ec11_t encoder;
 static shape_t current_shape = SHAPE_SQUARE;
 static volatile bool display_needs_update = false;
 static sh1106_t *g_display = NULL;  // Global pointer for display access in callback
+static sh1106_async_t display_async;  // DMA update context (too large for the stack)
 
-// Encoder event callback - called from interrupt context
-void encoder_event_handler(encoder_event_t event, int32_t position) {
-    if (event == ENCODER_EVENT_BUTTON_PRESS) {
-        // Cycle through shapes on button press
-        current_shape = (shape_t)((current_shape + 1) % SHAPE_COUNT);
-        display_needs_update = true;
-    } else if (event == ENCODER_EVENT_CW || event == ENCODER_EVENT_CCW) {
-        // Mark display for update on rotation
-        display_needs_update = true;
+// Encoder events, pushed from interrupt context and handled in the main loop
+static hw_event_t event_storage[HW_EVENT_QUEUE_DEFAULT_CAPACITY];
+static hw_event_queue_t events;
+
+// Handle a batch of encoder events (main loop context)
+static void handle_events(const hw_event_t *batch, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (batch[i].type == ENCODER_EVENT_BUTTON_PRESS) {
+            // Cycle through shapes on button press
+            current_shape = (shape_t)((current_shape + 1) % SHAPE_COUNT);
+            display_needs_update = true;
+        } else if (batch[i].type == ENCODER_EVENT_CW || batch[i].type == ENCODER_EVENT_CCW) {
+            // Mark display for update on rotation
+            display_needs_update = true;
+        }
     }
 }
 
 // Draw a rotated square
-static void draw_rotated_square(sh1106_t *display, int cx, int cy, int size, float angle) {
-    // Calculate half size for convenience
-    float half = size / 2.0f;
+static void draw_rotated_square(sh1106_t *display, int cx, int cy, int size, fxp_angle_t angle) {
+    int16_t half = size / 2;
     
-    // Calculate corner points relative to center
-    float corners[4][2] = {
+    // Corner points relative to center, transformed in place
+    sh1106_point_t corners[4] = {
         {-half, -half},  // Top-left
         { half, -half},  // Top-right
         { half,  half},  // Bottom-right
@@ -91,83 +96,41 @@ static void draw_rotated_square(sh1106_t *display, int cx, int cy, int size, flo
     };
     
     // Rotate and translate each corner
-    int rotated[4][2];
-    for (int i = 0; i < 4; i++) {
-        float x = corners[i][0];
-        float y = corners[i][1];
-        
-        // Apply rotation
-        float cos_a = cosf(angle);
-        float sin_a = sinf(angle);
-        rotated[i][0] = (int)(cx + x * cos_a - y * sin_a);
-        rotated[i][1] = (int)(cy + x * sin_a + y * cos_a);
-    }
+    fxp_affine_t m;
+    fxp_affine_rotate_scale(&m, angle, FXP_Q16_ONE, cx, cy);
+    fxp_affine_apply_points(&m, &corners[0].x, &corners[0].x, 4);
     
-    // Draw lines between corners to form the square
-    for (int i = 0; i < 4; i++) {
-        int next = (i + 1) % 4;
-        sh1106_draw_line(display, 
-            rotated[i][0], rotated[i][1],
-            rotated[next][0], rotated[next][1], 
-            true);
-    }
+    // Draw the square as a closed outline
+    sh1106_draw_polyline(display, corners, 4, true, true);
     
 // Draw a small dot at the center
     sh1106_set_pixel(display, cx, cy, true);
 }
 
 // Draw a rotated isosceles triangle
-static void draw_rotated_triangle(sh1106_t *display, int cx, int cy, int size, float angle) {
-    float half = size / 2.0f;
-    float pts[3][2] = {
-        { 0.0f, -half}, // top
+static void draw_rotated_triangle(sh1106_t *display, int cx, int cy, int size, fxp_angle_t angle) {
+    int16_t half = size / 2;
+    sh1106_point_t pts[3] = {
+        {    0, -half}, // top
         {-half,  half}, // bottom-left
         { half,  half}  // bottom-right
     };
-    int r[3][2];
-    float c = cosf(angle), s = sinf(angle);
-    for (int i = 0; i < 3; i++) {
-        float x = pts[i][0], y = pts[i][1];
-        r[i][0] = (int)(cx + x * c - y * s);
-        r[i][1] = (int)(cy + x * s + y * c);
-    }
-    sh1106_draw_line(display, r[0][0], r[0][1], r[1][0], r[1][1], true);
-    sh1106_draw_line(display, r[1][0], r[1][1], r[2][0], r[2][1], true);
-    sh1106_draw_line(display, r[2][0], r[2][1], r[0][0], r[0][1], true);
-}
-
-// Midpoint circle (outline)
-static void draw_circle_outline(sh1106_t *display, int cx, int cy, int rr) {
-    int x = rr, y = 0; int err = 0;
-    while (x >= y) {
-        sh1106_set_pixel(display, cx + x, cy + y, true);
-        sh1106_set_pixel(display, cx + y, cy + x, true);
-        sh1106_set_pixel(display, cx - y, cy + x, true);
-        sh1106_set_pixel(display, cx - x, cy + y, true);
-        sh1106_set_pixel(display, cx - x, cy - y, true);
-        sh1106_set_pixel(display, cx - y, cy - x, true);
-        sh1106_set_pixel(display, cx + y, cy - x, true);
-        sh1106_set_pixel(display, cx + x, cy - y, true);
-        y++;
-        if (err <= 0) { err += 2*y + 1; }
-        else { x--; err += 2*(y - x) + 1; }
-    }
+    fxp_affine_t m;
+    fxp_affine_rotate_scale(&m, angle, FXP_Q16_ONE, cx, cy);
+    fxp_affine_apply_points(&m, &pts[0].x, &pts[0].x, 3);
+    sh1106_draw_polyline(display, pts, 3, true, true);
 }
 
 // Circle with rotating cross
-static void draw_circle_with_cross(sh1106_t *display, int cx, int cy, int size, float angle) {
-    int r = (int)(size / 2.0f);
-    draw_circle_outline(display, cx, cy, r);
-    float c = cosf(angle), s = sinf(angle);
+static void draw_circle_with_cross(sh1106_t *display, int cx, int cy, int size, fxp_angle_t angle) {
+    int r = size / 2;
+    sh1106_draw_circle(display, cx, cy, r, true);
+    int dx = fxp_mul_q15(r, fxp_cos(angle));
+    int dy = fxp_mul_q15(r, fxp_sin(angle));
     // first line
-    int x1 = (int)(cx + r * c), y1 = (int)(cy + r * s);
-    int x2 = (int)(cx - r * c), y2 = (int)(cy - r * s);
-    sh1106_draw_line(display, x1, y1, x2, y2, true);
-    // second line (perpendicular)
-    float c2 = cosf(angle + (float)M_PI/2.0f), s2 = sinf(angle + (float)M_PI/2.0f);
-    int x3 = (int)(cx + r * c2), y3 = (int)(cy + r * s2);
-    int x4 = (int)(cx - r * c2), y4 = (int)(cy - r * s2);
-    sh1106_draw_line(display, x3, y3, x4, y4, true);
+    sh1106_draw_line(display, cx + dx, cy + dy, cx - dx, cy - dy, true);
+    // second line (perpendicular: rotate (dx, dy) by 90 degrees)
+    sh1106_draw_line(display, cx - dy, cy + dx, cx + dy, cy - dx, true);
 }
 
 // Update display with current encoder state
@@ -180,8 +143,8 @@ static void update_display() {
     // Clear display buffer
     sh1106_clear(g_display);
     
-    // Calculate rotation angle
-    float angle = (current_position * 2.0f * M_PI) / ENCODER_COUNTS_PER_REV;
+    // Calculate rotation angle (binary radians; whole turns wrap for free)
+    fxp_angle_t angle = encoder_position_to_angle(current_position, ENCODER_COUNTS_PER_REV);
     
     // Draw the selected shape
     switch (current_shape) {
@@ -205,26 +168,28 @@ static void update_display() {
     sh1106_draw_string(g_display, 0, 0, status);
     
     // Draw angle at bottom
+    int raw_degrees = (current_position * 360) / ENCODER_COUNTS_PER_REV;
     int degrees;
     if (ENCODER_MODE == ENCODER_MODE_ABSOLUTE_360) {
-        // For absolute mode, ensure degrees stay 0-359
-        degrees = (int)((angle * 180.0f) / M_PI);
-        while (degrees < 0) degrees += 360;
-        while (degrees >= 360) degrees -= 360;
+        // For absolute mode, degrees stay 0-359
+        degrees = fxp_angle_to_deg(angle);
     } else {
         // For cumulative mode, allow negative and >360 degrees
-        degrees = (int)((angle * 180.0f) / M_PI);
+        degrees = raw_degrees;
     }
     snprintf(status, sizeof(status), "Angle: %03d deg", degrees);
     sh1106_draw_string(g_display, 0, 56, status);
     
-    // Update display
-    sh1106_update(g_display);
+    // Queue the changed columns by DMA; drawing above overlapped the previous transfer
+    sh1106_update_wait(g_display);
+    if (sh1106_update_async(g_display, false) == HW_INVALID_PARAM) {
+        sh1106_update_dirty(g_display);  // No DMA context
+    }
     
     // Print to serial for debugging
-    printf("Shape:%d Position:%d/%d Angle:%d deg (raw_angle:%.1f) Mode:%s\n", 
+    printf("Shape:%d Position:%d/%d Angle:%d deg (raw_angle:%d) Mode:%s\n", 
            (int)current_shape, current_position, ENCODER_COUNTS_PER_REV, degrees, 
-           (angle * 180.0f) / M_PI,
+           raw_degrees,
            (ENCODER_MODE == ENCODER_MODE_ABSOLUTE_360) ? "ABS" : "CUM");
 }
 
@@ -248,7 +213,6 @@ int main() {
         .pin_b = ENCODER_PIN_B,
         .pin_button = ENCODER_PUSH,
         .invert_direction = false,  // CW rotation gives positive values with corrected state table
-        .debounce_us = 50,   // Minimal debounce for maximum accuracy at normal speeds
         .button_debounce_us = 50000,
         .pull_up = true
     };
@@ -267,8 +231,9 @@ int main() {
         encoder_ec11_set_limits(&encoder, 0, 0, false);
     }
     
-    // Set callback for button events
-    encoder_ec11_set_callback(&encoder, encoder_event_handler);
+    // Queue rotation and button events for the main loop
+    hw_event_queue_init(&events, event_storage, ARRAY_SIZE(event_storage));
+    encoder_ec11_set_queue(&encoder, &events);
     
     // Enable interrupts for encoder
     encoder_ec11_enable_interrupts(&encoder);
@@ -286,6 +251,9 @@ int main() {
         }
     }
     g_display = &display;  // Store display pointer for callback access
+    if (sh1106_async_init(&display, &display_async) != HW_OK) {
+        printf("No DMA channel for OLED, falling back to blocking updates\n");
+    }
     printf("OLED initialized\n");
     
     // Initial display update
@@ -296,7 +264,14 @@ int main() {
     
     // Event-driven main loop
     while (true) {
-        // Check if display needs updating (set by interrupt callback)
+        // Handle everything the interrupts queued since the last pass
+        hw_event_t batch[8];
+        size_t count;
+        while ((count = hw_event_drain(&events, batch, ARRAY_SIZE(batch))) > 0) {
+            handle_events(batch, count);
+        }
+        
+        // Check if display needs updating
         if (display_needs_update) {
             display_needs_update = false;  // Clear flag
             update_display();
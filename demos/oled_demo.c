@@ -8,7 +8,7 @@
 
 #include "lib.h"
 #include <stdio.h>
-#include <math.h>
+#include <stdlib.h>
 
 // I2C Configuration - UPDATED based on testing
 // GP6/GP7 work with i2c1, NOT i2c0!
@@ -19,57 +19,40 @@
 
 // Animation variables
 static int animation_frame = 0;
+static sh1106_diff_t frame_diff;  // Shadow of the last frame sent (1 KiB, keep off the stack)
 
 // Function to draw a simple animation
 void draw_animation(sh1106_t *display, int frame) {
     // Clear previous animation area
-    sh1106_draw_rect(display, 80, 16, 48, 48, false);
+    sh1106_fill_rect(display, 80, 16, 48, 48, false);
     
     // Draw rotating box
     int cx = 104;  // Center X
     int cy = 40;   // Center Y
     int size = 15;
     
-    // Calculate rotation angle
-    float angle = frame * 0.1f;
-    float cos_a = cosf(angle);
-    float sin_a = sinf(angle);
+    // Calculate rotation angle (~0.1 rad per frame, in binary radians)
+    fxp_affine_t m;
+    fxp_affine_rotate_scale(&m, (fxp_angle_t)(frame * 1043), FXP_Q16_ONE, cx, cy);
     
     // Box corners relative to center
-    int corners[4][2] = {
+    sh1106_point_t corners[4] = {
         {-size, -size},
         {size, -size},
         {size, size},
         {-size, size}
     };
     
-    // Rotate and draw lines between corners
-    int rotated[4][2];
-    for (int i = 0; i < 4; i++) {
-        rotated[i][0] = cx + (int)(corners[i][0] * cos_a - corners[i][1] * sin_a);
-        rotated[i][1] = cy + (int)(corners[i][0] * sin_a + corners[i][1] * cos_a);
-    }
-    
-    // Draw the box
-    for (int i = 0; i < 4; i++) {
-        int next = (i + 1) % 4;
-        sh1106_draw_line(display, 
-                         rotated[i][0], rotated[i][1],
-                         rotated[next][0], rotated[next][1], true);
-    }
+    // Rotate and draw the box
+    fxp_affine_apply_points(&m, &corners[0].x, &corners[0].x, 4);
+    sh1106_draw_polyline(display, corners, 4, true, true);
     
-    // Draw a bouncing ball
-    int ball_x = 90 + (int)(10 * sinf(frame * 0.2f));
-    int ball_y = 40 + (int)(15 * fabsf(sinf(frame * 0.15f)));
+    // Draw a bouncing ball (~0.2 and ~0.15 rad per frame)
+    int ball_x = 90 + fxp_mul_q15(10, fxp_sin((fxp_angle_t)(frame * 2086)));
+    int ball_y = 40 + abs(fxp_mul_q15(15, fxp_sin((fxp_angle_t)(frame * 1565))));
     
-    // Draw ball (small filled circle approximation)
-    for (int dy = -2; dy <= 2; dy++) {
-        for (int dx = -2; dx <= 2; dx++) {
-            if (dx*dx + dy*dy <= 4) {
-                sh1106_set_pixel(display, ball_x + dx, ball_y + dy, true);
-            }
-        }
-    }
+    // Draw ball
+    sh1106_fill_circle(display, ball_x, ball_y, 2, true);
 }
 
 // Function to display system info
@@ -131,6 +114,7 @@ int main() {
     }
     
     printf("OLED initialized successfully!\n");
+    sh1106_diff_init(&frame_diff, NULL);
     
     // Quick test: Turn all pixels on briefly to verify display works
     printf("Testing display - all pixels ON for 1 second...\n");
@@ -187,6 +171,8 @@ int main() {
             case 2:
                 // Graphics demo
                 if (animation_frame == 0) {
+                    // Other screens used full updates, so the shadow is stale
+                    sh1106_diff_invalidate(&frame_diff);
                     sh1106_clear(&display);
                     sh1106_draw_string(&display, 0, 0, "Graphics Demo");
                     sh1106_draw_line(&display, 0, 10, 127, 10, true);
@@ -205,12 +191,15 @@ int main() {
                     sh1106_draw_line(&display, 45, 45, 35, 55, true);
                 }
                 
-                // Animate
+                // Animate, sending only the changed column runs
                 draw_animation(&display, animation_frame);
-                sh1106_update(&display);
+                sh1106_diff_update(&display, &frame_diff);
                 
                 animation_frame++;
                 if (animation_frame > 300) {
+                    printf("Diff transport: %lu frames, %lu segments, %lu bus bytes\n",
+                           (unsigned long)frame_diff.frames, (unsigned long)frame_diff.segments,
+                           (unsigned long)frame_diff.bus_bytes);
                     demo_state = 3;
                     next_state_change = make_timeout_time_ms(3000);
                 }
@@ -12,6 +12,10 @@
 #define LED_PIN 22     // Wukong 2040: NeoPixels (2x WS2812) on GP22
 #define NUM_LEDS 2
 
+// LED buffers sized at compile time (no heap)
+static uint32_t led_storage[HW_WS2812_STORAGE_WORDS(NUM_LEDS, 1, 24)];
+static uint32_t led_pipeline[HW_WS2812_PIPELINE_WORDS(NUM_LEDS, 1, 24)];
+
 // Debug callback for button events
 void button_debug_callback(button_event_t event, uint8_t click_count) {
     printf("*** BUTTON CALLBACK: Event=%s, Clicks=%d\n", 
@@ -75,25 +79,29 @@ int main() {
     };
 
     hw_ws2812_t ws;
-    if (hw_ws2812_init(&ws, &config) != HW_OK) {
+    if (hw_ws2812_init_static(&ws, &config, led_storage, ARRAY_SIZE(led_storage)) != HW_OK) {
         printf("Failed to initialize WS2812 LEDs!\n");
         return -1;
     }
 
-    // Define color palette (using brighter values)
+    // Dim globally rather than with small palette values: the output pipeline
+    // keeps full color depth at low brightness by dithering across frames
+    hw_ws2812_enable_pipeline_static(&ws, led_pipeline, ARRAY_SIZE(led_pipeline), true, true);
+    hw_ws2812_set_brightness(&ws, 64);
+
+    // Define color palette (full-scale values)
     const struct {
         uint8_t r, g, b;
     } palette[] = {
-        {64, 0, 0},   // Red
-        {0, 64, 0},   // Green
-        {0, 0, 64},   // Blue
-        {64, 64, 0},  // Yellow
-        {64, 0, 64},  // Magenta
-        {0, 64, 64},  // Cyan
-        {32, 32, 32}  // White (dimmer)
+        {255, 0, 0},     // Red
+        {0, 255, 0},     // Green
+        {0, 0, 255},     // Blue
+        {255, 255, 0},   // Yellow
+        {255, 0, 255},   // Magenta
+        {0, 255, 255},   // Cyan
+        {128, 128, 128}  // White (dimmer)
     };
     const int num_colors = ARRAY_SIZE(palette);
-    int color_idx = 0;
 
     // Test sequence - flash through all colors on startup
     printf("Running LED test sequence...\n");
@@ -109,16 +117,28 @@ int main() {
     hw_ws2812_clear(&ws);
     hw_ws2812_show(&ws);
     sleep_ms(200);
-    
-    // Set initial color
-    printf("Setting initial color: R=%d, G=%d, B=%d\n", 
-           palette[color_idx].r, palette[color_idx].g, palette[color_idx].b);
-    hw_ws2812_set_all(&ws, 
-                      palette[color_idx].r,
-                      palette[color_idx].g,
-                      palette[color_idx].b);
-    hw_ws2812_show(&ws);
-    printf("LEDs ready. Press button to cycle colors.\n");
+
+    // Effects cycled by the button, drawn on one layer by the engine
+    static led_effect_t effects[6];
+    static led_rgb_t layer_buf[NUM_LEDS];
+    static uint8_t fire_heat[NUM_LEDS];
+    led_effect_rainbow(&effects[0], 64, 128);
+    led_effect_breathing(&effects[1], (led_rgb_t){0, 128, 255}, 3000);
+    led_effect_chase(&effects[2], (led_rgb_t){255, 96, 0}, 1, 4, 24);
+    led_effect_twinkle(&effects[3], (led_rgb_t){255, 255, 255}, 8, 12);
+    led_effect_fire(&effects[4], fire_heat, 55, 120);
+    led_effect_gradient(&effects[5], (led_rgb_t){255, 0, 0}, (led_rgb_t){0, 0, 255});
+    const char *effect_names[] = {"rainbow", "breathing", "chase", "twinkle", "fire", "gradient"};
+    const int num_effects = ARRAY_SIZE(effects);
+    int effect_idx = 0;
+
+    led_engine_t engine;
+    if (led_engine_init(&engine, &ws, 60) != HW_OK ||
+        led_engine_add_layer(&engine, &effects[effect_idx], layer_buf, LED_BLEND_NORMAL, 255) != HW_OK) {
+        printf("Failed to initialize LED effects!\n");
+        return -1;
+    }
+    printf("LEDs ready (%s). Press button to cycle effects.\n", effect_names[effect_idx]);
 
     printf("Starting main loop. Initial button state:\n");
     printf("  - Raw GPIO pin %d = %d\n", BUTTON_PIN, gpio_get(BUTTON_PIN));
@@ -157,22 +177,15 @@ int main() {
                    loop_count, gpio_state, raw_state, pressed, wfi_ticks);
         }
         
-        // On button click, advance to next color
+        // On button click, advance to next effect
         if (event == BUTTON_EVENT_CLICK) {
-            printf("CLICK DETECTED! Changing color...\n");
-            
-            // Advance to next color
-            color_idx = (color_idx + 1) % num_colors;
-            
-            // Update LEDs
-            hw_ws2812_set_all(&ws,
-                             palette[color_idx].r,
-                             palette[color_idx].g,
-                             palette[color_idx].b);
-            hw_ws2812_show(&ws);
-            printf("Color index -> %d (R=%d, G=%d, B=%d)\n", color_idx,
-                   palette[color_idx].r, palette[color_idx].g, palette[color_idx].b);
+            effect_idx = (effect_idx + 1) % num_effects;
+            led_engine_set_layer_effect(&engine, 0, &effects[effect_idx]);
+            printf("Effect -> %s\n", effect_names[effect_idx]);
         }
+
+        // Render and send a frame when one is due; also keeps dithering running
+        led_engine_task(&engine);
         
         // Use WFI (Wait For Interrupt) to sleep until next interrupt
         // This puts the CPU into a low-power state until ANY interrupt occurs
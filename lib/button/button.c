@@ -8,31 +8,10 @@
 #include "hardware/gpio.h"
 #include "hardware/sync.h"
 
-// =============================================================================
-// Private Variables
-// =============================================================================
-
-// Store button instances for ISR access (max 8 buttons)
-#define MAX_BUTTONS 8
-static button_t *button_instances[MAX_BUTTONS] = {NULL};
-static uint8_t num_buttons = 0;
-
 // =============================================================================
 // Private Functions
 // =============================================================================
 
-/**
- * Find button instance by pin
- */
-static button_t* find_button_by_pin(uint gpio) {
-    for (int i = 0; i < num_buttons; i++) {
-        if (button_instances[i] && button_instances[i]->config.pin == gpio) {
-            return button_instances[i];
-        }
-    }
-    return NULL;
-}
-
 /**
  * Read button pin state accounting for active_low
  */
@@ -41,6 +20,22 @@ static bool read_button_state(button_t *button) {
     return button->config.active_low ? !pin_state : pin_state;
 }
 
+/**
+ * Deliver an event to the callback and the queue
+ */
+static void emit_event(button_t *button, button_event_t event, uint8_t clicks) {
+    if (button->event_callback) {
+        button->event_callback(event, clicks);
+    }
+    if (button->event_queue) {
+        // Poll runs in thread context; keep ISR producers out while pushing
+        uint32_t save = save_and_disable_interrupts();
+        hw_event_post(button->event_queue, HW_EVENT_SOURCE_BUTTON, event,
+                      button->config.pin, 0, clicks);
+        restore_interrupts(save);
+    }
+}
+
 /**
  * Process button state change
  * Note: This is called from button_poll() in normal context, NOT from interrupt!
@@ -54,9 +49,7 @@ static void process_state_change(button_t *button, bool new_state, uint64_t now)
         button->press_start_time = now;
         button->long_press_fired = false;
         
-        if (button->event_callback) {
-            button->event_callback(BUTTON_EVENT_PRESS, button->click_count);
-        }
+        emit_event(button, BUTTON_EVENT_PRESS, button->click_count);
     } else {  // Button released
         button->state = BUTTON_STATE_RELEASED;
         
@@ -81,9 +74,7 @@ static void process_state_change(button_t *button, bool new_state, uint64_t now)
             }
         }
         
-        if (button->event_callback) {
-            button->event_callback(BUTTON_EVENT_RELEASE, button->click_count);
-        }
+        emit_event(button, BUTTON_EVENT_RELEASE, button->click_count);
     }
 }
 
@@ -98,9 +89,7 @@ static void check_long_press(button_t *button, uint64_t now) {
             button->state = BUTTON_STATE_LONG_PRESSED;
             button->click_count = 0;  // Reset click count on long press
             
-            if (button->event_callback) {
-                button->event_callback(BUTTON_EVENT_LONG_PRESS, 0);
-            }
+            emit_event(button, BUTTON_EVENT_LONG_PRESS, 0);
         }
     }
 }
@@ -138,8 +127,8 @@ static button_event_t check_click_sequence(button_t *button, uint64_t now) {
             
             button->click_count = 0;  // Reset for next sequence
             
-            if (button->event_callback && event != BUTTON_EVENT_NONE) {
-                button->event_callback(event, clicks);
+            if (event != BUTTON_EVENT_NONE) {
+                emit_event(button, event, clicks);
             }
             
             return event;
@@ -149,13 +138,12 @@ static button_event_t check_click_sequence(button_t *button, uint64_t now) {
 }
 
 /**
- * GPIO interrupt handler
+ * GPIO interrupt handler (registered per pin with the button as context)
  * Note: This runs in interrupt context - keep it minimal!
  * Only updates raw state; actual processing happens in button_poll()
  */
-static void gpio_callback(uint gpio, uint32_t events) {
-    button_t *button = find_button_by_pin(gpio);
-    if (!button) return;
+static void gpio_irq_handler(uint gpio, uint32_t events, void *ctx) {
+    button_t *button = (button_t *)ctx;
     
     // Update raw state and timestamp atomically
     uint32_t save = save_and_disable_interrupts();
@@ -173,13 +161,8 @@ hw_result_t button_init(button_t *button, const button_config_t *config) {
         return HW_INVALID_PARAM;
     }
     
-    if (num_buttons >= MAX_BUTTONS) {
-        DEBUG_PRINT("Button init failed: max buttons (%d) reached", MAX_BUTTONS);
-        return HW_ERROR;
-    }
-    
     // Validate GPIO pin number (Pico has 30 GPIOs: 0-29)
-    if (config->pin >= 30) {
+    if (config->pin >= HW_GPIO_IRQ_NUM_PINS) {
         DEBUG_PRINT("Button init failed: invalid pin %u", config->pin);
         return HW_INVALID_PARAM;
     }
@@ -217,11 +200,7 @@ hw_result_t button_init(button_t *button, const button_config_t *config) {
     button->event_callback = NULL;
     button->pending_event = BUTTON_EVENT_NONE;
     button->pending_clicks = 0;
-    
-    // Store instance for ISR access (with critical section for thread safety)
-    uint32_t save = save_and_disable_interrupts();
-    button_instances[num_buttons++] = button;
-    restore_interrupts(save);
+    button->event_queue = NULL;
     
     return HW_OK;
 }
@@ -231,20 +210,6 @@ void button_deinit(button_t *button) {
     
     // Disable interrupts
     button_disable_interrupts(button);
-    
-    // Remove from instances (with critical section for thread safety)
-    uint32_t save = save_and_disable_interrupts();
-    for (int i = 0; i < num_buttons; i++) {
-        if (button_instances[i] == button) {
-            // Shift remaining instances
-            for (int j = i; j < num_buttons - 1; j++) {
-                button_instances[j] = button_instances[j + 1];
-            }
-            button_instances[--num_buttons] = NULL;
-            break;
-        }
-    }
-    restore_interrupts(save);
 }
 
 button_event_t button_poll(button_t *button) {
@@ -263,9 +228,7 @@ button_event_t button_poll(button_t *button) {
     // If we have a pending event (e.g., immediate CLICK), return it once
     if (button->pending_event != BUTTON_EVENT_NONE) {
         event = button->pending_event;
-        if (button->event_callback) {
-            button->event_callback(event, button->pending_clicks);
-        }
+        emit_event(button, event, button->pending_clicks);
         button->pending_event = BUTTON_EVENT_NONE;
         button->pending_clicks = 0;
         return event;
@@ -328,6 +291,23 @@ void button_set_callback(button_t *button,
     }
 }
 
+void button_set_queue(button_t *button, hw_event_queue_t *queue) {
+    if (button) {
+        button->event_queue = queue;
+    }
+}
+
+void button_process_sample(button_t *button, uint32_t gpio_state, uint64_t now) {
+    if (!button) return;
+    
+    bool level = (gpio_state >> button->config.pin) & 1;
+    bool pressed = button->config.active_low ? !level : level;
+    if (pressed != button->raw_state) {
+        button->raw_state = pressed;
+        button->state_change_time = now;
+    }
+}
+
 hw_result_t button_enable_interrupts(button_t *button) {
     if (!button) return HW_INVALID_PARAM;
     
@@ -336,19 +316,16 @@ hw_result_t button_enable_interrupts(button_t *button) {
     button->state_change_time = hw_time_us();
     
     // Enable interrupts on both edges
-    gpio_set_irq_enabled_with_callback(button->config.pin, 
-                                      GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                                      true, gpio_callback);
-    
-    return HW_OK;
+    return hw_gpio_irq_register(button->config.pin, 
+                                GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
+                                gpio_irq_handler, button);
 }
 
 void button_disable_interrupts(button_t *button) {
     if (!button) return;
     
-    gpio_set_irq_enabled(button->config.pin, 
-                        GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                        false);
+    // Only release the pin if this button owns it
+    hw_gpio_irq_unregister(button->config.pin, button);
 }
 
 void button_set_timing(button_t *button, uint32_t debounce_ms, 
@@ -96,6 +96,9 @@ typedef struct {
     // Pending event (used when multi-click is disabled to emit immediately)
     button_event_t pending_event;   ///< Pending event to return from poll
     uint8_t pending_clicks;         ///< Pending click count for the event
+
+    // Event queue (fed from button_poll() context, alongside the callback)
+    hw_event_queue_t *event_queue;  ///< Optional queue for button events
 } button_t;
 
 // =============================================================================
@@ -106,7 +109,7 @@ typedef struct {
  * Initialize button
  * @param button Pointer to button instance
  * @param config Pointer to configuration (set enable_multi_click/enable_long_press for features)
- * @return HW_OK on success, HW_ERROR if max buttons reached, HW_INVALID_PARAM if invalid config
+ * @return HW_OK on success, HW_INVALID_PARAM if invalid config
  */
 hw_result_t button_init(button_t *button, const button_config_t *config);
 
@@ -160,10 +163,33 @@ void button_reset(button_t *button);
 void button_set_callback(button_t *button, 
                         void (*callback)(button_event_t, uint8_t));
 
+/**
+ * Feed button events into a queue (alongside any callback)
+ * Events are pushed from button_poll() with interrupts briefly masked, so
+ * the queue may be shared with interrupt-driven producers such as encoders.
+ * The click count is reported in the event's position field.
+ * @param button Pointer to button instance
+ * @param queue Initialized queue (NULL to disable)
+ */
+void button_set_queue(button_t *button, hw_event_queue_t *queue);
+
+/**
+ * Update the raw state from a snapshot of all GPIO inputs
+ *
+ * The sampled alternative to button_enable_interrupts (see encoder_sampler):
+ * records the change and its time exactly as the pin interrupt would, for
+ * button_poll to debounce.
+ *
+ * @param button Pointer to button instance
+ * @param gpio_state Input levels, bit n = GPIO n (as gpio_get_all)
+ * @param now Time of the snapshot in microseconds
+ */
+void button_process_sample(button_t *button, uint32_t gpio_state, uint64_t now);
+
 /**
  * Enable interrupt-driven operation
  * @param button Pointer to button instance
- * @return HW_OK on success
+ * @return HW_OK on success, HW_BUSY if another driver owns the pin
  */
 hw_result_t button_enable_interrupts(button_t *button);
 
@@ -4,108 +4,272 @@
  */
 
 #include "../lib.h"
+#include <stdlib.h>
 #include "hardware/irq.h"
 #include "hardware/sync.h"
+#include "encoder_quadrature.pio.h"
+
+// Transition table entry for a change of both inputs
+#define TRANSITION_ILLEGAL 2
 
 // =============================================================================
 // Private Variables
 // =============================================================================
 
-// Store encoder instances for ISR access (max 4 encoders)
-#define MAX_ENCODERS 4
-static encoder_ec11_t *encoder_instances[MAX_ENCODERS] = {NULL};
-static uint8_t num_encoders = 0;
+// PIO backend encoders per PIO block sharing the decoder program at offset 0
+static uint8_t pio_program_users[NUM_PIOS] = {0};
 
 // =============================================================================
 // Private Functions
 // =============================================================================
 
 /**
- * Find encoder instance by pin
+ * Move the position by delta counts, clamping or wrapping at the limits
+ */
+static void apply_delta(encoder_ec11_t *encoder, int32_t delta) {
+    int32_t position = encoder->position + delta;
+    
+    // Apply limits if set (max_pos of 0 means no limits)
+    if (encoder->max_pos > encoder->min_pos) {
+        if (encoder->wrap_around) {
+            int32_t span = encoder->max_pos - encoder->min_pos + 1;
+            int32_t offset = (position - encoder->min_pos) % span;
+            if (offset < 0) {
+                offset += span;
+            }
+            position = encoder->min_pos + offset;
+        } else {
+            position = CONSTRAIN(position, encoder->min_pos, encoder->max_pos);
+        }
+    }
+    
+    encoder->position = position;
+}
+
+/**
+ * Whole detents ready to report, given the state just entered
+ *
+ * The detent count only lands on a multiple of counts_per_detent at a rest
+ * state, and bounce only ever moves it back and forth around one, so steps
+ * are reported at rest states. A missed edge (an illegal transition) leaves
+ * it two counts off; the hysteresis decides whether such a detent still
+ * counts, and the remainder is dropped so the error does not carry over.
  */
-static encoder_ec11_t* find_encoder_by_pin(uint gpio) {
-    for (int i = 0; i < num_encoders; i++) {
-        if (encoder_instances[i]) {
-            if (encoder_instances[i]->config.pin_a == gpio ||
-                encoder_instances[i]->config.pin_b == gpio ||
-                encoder_instances[i]->config.pin_button == gpio) {
-                return encoder_instances[i];
+static int32_t detent_steps(encoder_ec11_t *encoder, encoder_state_t state) {
+    int32_t per_detent = encoder->config.counts_per_detent;
+    int32_t count = encoder->detent_count;
+    
+    bool at_rest = per_detent == 1 || state == encoder->rest_state ||
+                   (per_detent == 2 && state == (encoder->rest_state ^ 3));
+    if (at_rest) {
+        int32_t steps = count / per_detent;
+        int32_t remainder = count - steps * per_detent;
+        if (remainder != 0) {
+            if (abs(remainder) >= per_detent - encoder->config.detent_hysteresis) {
+                steps += (remainder > 0) ? 1 : -1;
+            } else {
+                encoder->stats.partial_detents++;
             }
         }
+        encoder->detent_count = 0;
+        return steps;
+    }
+    
+    // A missed edge can skip the rest state: report whole detents anyway
+    if (abs(count) >= per_detent) {
+        int32_t steps = count / per_detent;
+        encoder->detent_count -= steps * per_detent;
+        return steps;
+    }
+    return 0;
+}
+
+/**
+ * Scale detent steps by the acceleration curve and move the position, then
+ * notify the callback and queue
+ */
+static void rotate(encoder_ec11_t *encoder, int32_t steps, uint64_t now) {
+    // Time whole detents, not edges: bounce around a detent never gets
+    // here, so it cannot look like a reversal to the estimator
+    encoder_velocity_add(&encoder->velocity, steps, now);
+    
+    if (encoder->accel_enabled) {
+        int32_t speed = encoder_velocity_get(&encoder->velocity, now);
+        steps = encoder_accel_scale(&encoder->accel, steps, speed, &encoder->accel_remainder);
+        if (steps == 0) return;
+    }
+    
+    apply_delta(encoder, steps);
+    encoder->unread_steps += steps;
+    
+    encoder_event_t event = (steps > 0) ? ENCODER_EVENT_CW : ENCODER_EVENT_CCW;
+    if (encoder->event_callback) {
+        encoder->event_callback(event, encoder->position);
+    }
+    if (encoder->event_queue) {
+        // The PIO backend gets here from thread context: keep the button
+        // interrupt from pushing concurrently
+        uint32_t save = save_and_disable_interrupts();
+        hw_event_post(encoder->event_queue, HW_EVENT_SOURCE_ENCODER, event,
+                      encoder->config.pin_a, steps, encoder->position);
+        restore_interrupts(save);
     }
-    return NULL;
 }
 
 /**
  * Update encoder position based on state transition
  */
-static void update_position(encoder_ec11_t *encoder, encoder_state_t new_state) {
-    // State transition table for quadrature decoding
-    // Each transition can be CW (+1), CCW (-1), or invalid (0)
-    // CW sequence: 00→01→11→10→00 (should increment)
-    // CCW sequence: 00→10→11→01→00 (should decrement)
-    static const int8_t state_table[4][4] = {
-        //         to: 00  01  10  11
-        /* from 00 */ { 0, -1, +1,  0},  // 00→01=CCW, 00→10=CW
-        /* from 01 */ {+1,  0,  0, -1},  // 01→00=CW, 01→11=CCW
-        /* from 10 */ {-1,  0,  0, +1},  // 10→00=CCW, 10→11=CW  
-        /* from 11 */ { 0, +1, -1,  0}   // 11→01=CW, 11→10=CCW
+static void update_position(encoder_ec11_t *encoder, encoder_state_t new_state, uint64_t now) {
+    // Quadrature transitions indexed by (from << 2) | to, state = (A << 1) | B
+    // CW sequence: 00→10→11→01→00 (+1)
+    // CCW sequence: 00→01→11→10→00 (-1)
+    // Both inputs changing at once means an edge was missed: direction unknown
+    static const int8_t transition_table[16] = {
+        //      to: 00  01  10  11
+        /* from 00 */  0, -1, +1, TRANSITION_ILLEGAL,
+        /* from 01 */ +1,  0, TRANSITION_ILLEGAL, -1,
+        /* from 10 */ -1, TRANSITION_ILLEGAL,  0, +1,
+        /* from 11 */ TRANSITION_ILLEGAL, +1, -1,  0,
     };
-    int8_t delta = state_table[encoder->state][new_state];
+    int8_t delta = transition_table[(encoder->state << 2) | new_state];
+    encoder->state = new_state;
     
-    if (delta != 0) {
+    if (delta == 0) {
+        // The inputs bounced back before the handler read them
+        encoder->stats.bounces++;
+        return;
+    }
+    
+    if (delta == TRANSITION_ILLEGAL) {
+        encoder->stats.illegal_transitions++;
+    } else {
         if (encoder->config.invert_direction) {
             delta = -delta;
         }
-        
-        encoder->position += delta;
-        
-        // Debug output
-        #ifdef ENCODER_DEBUG
-        DEBUG_PRINT("Encoder: %d->%d, delta=%d, pos=%ld", 
-                    encoder->state, new_state, delta, encoder->position);
-        #endif
-        
-        // Apply limits if set (max_pos of 0 means no limits)
-        if (encoder->max_pos > encoder->min_pos) {
-            if (encoder->position > encoder->max_pos) {
-                if (encoder->wrap_around) {
-                    encoder->position = encoder->min_pos;
-                } else {
-                    encoder->position = encoder->max_pos;
-                }
-            } else if (encoder->position < encoder->min_pos) {
-                if (encoder->wrap_around) {
-                    encoder->position = encoder->max_pos;
-                } else {
-                    encoder->position = encoder->min_pos;
-                }
-            }
+        encoder->detent_count += delta;
+    }
+    
+    // Debug output
+    #ifdef ENCODER_DEBUG
+    DEBUG_PRINT("Encoder: ->%d, delta=%d, count=%ld, pos=%ld", 
+                new_state, delta, encoder->detent_count, encoder->position);
+    #endif
+    
+    int32_t steps = detent_steps(encoder, new_state);
+    if (steps != 0) {
+        rotate(encoder, steps, now);
+    }
+}
+
+/**
+ * Fold the PIO backend's hardware count into the position
+ */
+static void pio_update_position(encoder_ec11_t *encoder) {
+    PIO pio = encoder->config.pio;
+    uint sm = encoder->config.sm;
+    
+    // The state machine pushes its count every loop without blocking, so the
+    // FIFO holds stale values; drain it and wait for one fresh push
+    uint n = pio_sm_get_rx_fifo_level(pio, sm) + 1;
+    uint32_t count = encoder->pio_count;
+    while (n--) {
+        count = pio_sm_get_blocking(pio, sm);
+    }
+    
+    // Y counts opposite to the IRQ backend's direction
+    int32_t delta = -(int32_t)(count - encoder->pio_count);
+    encoder->pio_count = count;
+    if (delta == 0) return;
+    
+    if (encoder->config.invert_direction) {
+        delta = -delta;
+    }
+    uint64_t now = hw_time_us();
+    
+    // The count is exact and started at a detent, so whole detents are
+    // multiples of counts_per_detent from there
+    encoder->detent_count += delta;
+    int32_t steps = encoder->detent_count / encoder->config.counts_per_detent;
+    encoder->detent_count -= steps * encoder->config.counts_per_detent;
+    if (steps != 0) {
+        rotate(encoder, steps, now);
+    }
+}
+
+static hw_result_t pio_init(encoder_ec11_t *encoder) {
+    const encoder_config_t *config = &encoder->config;
+    if (!config->pio || config->pin_b != config->pin_a + 1) {
+        return HW_INVALID_PARAM;
+    }
+    if (pio_sm_is_claimed(config->pio, config->sm)) {
+        return HW_BUSY;
+    }
+    
+    // The jump table must sit at offset 0; encoders on one PIO share it
+    uint index = pio_get_index(config->pio);
+    if (pio_program_users[index] == 0) {
+        if (!pio_can_add_program_at_offset(config->pio, &encoder_quadrature_program, 0)) {
+            return HW_ERROR;
         }
+        pio_add_program_at_offset(config->pio, &encoder_quadrature_program, 0);
+    }
+    pio_program_users[index]++;
+    
+    pio_sm_claim(config->pio, config->sm);
+    encoder_quadrature_program_init(config->pio, config->sm, config->pin_a);
+    encoder->pio_count = 0;
+    return HW_OK;
+}
+
+static void pio_deinit(encoder_ec11_t *encoder) {
+    PIO pio = encoder->config.pio;
+    uint sm = encoder->config.sm;
+    
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_unclaim(pio, sm);
+    
+    uint index = pio_get_index(pio);
+    if (--pio_program_users[index] == 0) {
+        pio_remove_program(pio, &encoder_quadrature_program, 0);
+    }
+}
+
+/**
+ * Debounce a button reading and report changes
+ */
+static void update_button(encoder_ec11_t *encoder, bool pressed, uint64_t now) {
+    if ((now - encoder->button_change_us) < encoder->config.button_debounce_us) {
+        return;
+    }
+    encoder->button_change_us = now;
+    
+    if (pressed != encoder->button_pressed) {
+        encoder->button_pressed = pressed;
         
-        // Call callback if set
+        encoder_event_t event = pressed ? ENCODER_EVENT_BUTTON_PRESS : 
+                                         ENCODER_EVENT_BUTTON_RELEASE;
         if (encoder->event_callback) {
-            encoder_event_t event = (delta > 0) ? ENCODER_EVENT_CW : ENCODER_EVENT_CCW;
             encoder->event_callback(event, encoder->position);
         }
+        if (encoder->event_queue) {
+            hw_event_post(encoder->event_queue, HW_EVENT_SOURCE_ENCODER, event,
+                          encoder->config.pin_button, 0, encoder->position);
+        }
     }
-    
-    encoder->state = new_state;
 }
 
 /**
- * GPIO interrupt handler
+ * GPIO interrupt handler (registered per pin with the encoder as context)
  */
-static void gpio_callback(uint gpio, uint32_t events) {
-    encoder_ec11_t *encoder = find_encoder_by_pin(gpio);
-    if (!encoder) return;
+static void gpio_irq_handler(uint gpio, uint32_t events, void *ctx) {
+    encoder_ec11_t *encoder = (encoder_ec11_t *)ctx;
     
     uint64_t now = hw_time_us();
     
     // Handle encoder rotation
     if (gpio == encoder->config.pin_a || gpio == encoder->config.pin_b) {
-        // Skip debounce for encoder rotation - quadrature signals are clean
-        // and we need maximum responsiveness for fast rotation
+        // No time-based debounce: the detent decoder absorbs contact bounce,
+        // and fast rotation needs every edge
         
         // Read current state
         bool a = gpio_get(encoder->config.pin_a);
@@ -113,28 +277,12 @@ static void gpio_callback(uint gpio, uint32_t events) {
         encoder_state_t new_state = (a << 1) | b;
         
         // Update position
-        update_position(encoder, new_state);
+        update_position(encoder, new_state, now);
     }
     
     // Handle button press
     if (gpio == encoder->config.pin_button) {
-        // Debounce
-        if ((now - encoder->button_change_us) < encoder->config.button_debounce_us) {
-            return;
-        }
-        encoder->button_change_us = now;
-        
-        bool pressed = !gpio_get(encoder->config.pin_button);  // Active low
-        
-        if (pressed != encoder->button_pressed) {
-            encoder->button_pressed = pressed;
-            
-            if (encoder->event_callback) {
-                encoder_event_t event = pressed ? ENCODER_EVENT_BUTTON_PRESS : 
-                                                 ENCODER_EVENT_BUTTON_RELEASE;
-                encoder->event_callback(event, encoder->position);
-            }
-        }
+        update_button(encoder, !gpio_get(encoder->config.pin_button), now);  // Active low
     }
 }
 
@@ -147,30 +295,42 @@ hw_result_t encoder_ec11_init(encoder_ec11_t *encoder, const encoder_config_t *c
         return HW_INVALID_PARAM;
     }
     
-    if (num_encoders >= MAX_ENCODERS) {
-        return HW_ERROR;
-    }
-    
     // Copy configuration
     encoder->config = *config;
     
-    // Set default debounce times if not specified
-    if (encoder->config.debounce_us == 0) {
-        encoder->config.debounce_us = ENCODER_DEFAULT_DEBOUNCE_US;
-    }
+    // Set default button debounce time if not specified
     if (encoder->config.button_debounce_us == 0) {
         encoder->config.button_debounce_us = ENCODER_DEFAULT_BUTTON_DEBOUNCE_US;
     }
     
+    // Detent geometry
+    if (encoder->config.counts_per_detent == 0) {
+        encoder->config.counts_per_detent = ENCODER_DEFAULT_COUNTS_PER_DETENT;
+    }
+    uint8_t per_detent = encoder->config.counts_per_detent;
+    if (per_detent != 1 && per_detent != 2 && per_detent != 4) {
+        return HW_INVALID_PARAM;
+    }
+    if (encoder->config.detent_hysteresis == 0 || encoder->config.detent_hysteresis >= per_detent) {
+        encoder->config.detent_hysteresis = per_detent / 2;
+    }
+    
     // Initialize state
     encoder->position = 0;
     encoder->min_pos = 0;
     encoder->max_pos = 0;
     encoder->wrap_around = false;
-    encoder->last_change_us = 0;
     encoder->button_pressed = false;
     encoder->button_change_us = 0;
     encoder->event_callback = NULL;
+    encoder->event_queue = NULL;
+    encoder_velocity_init(&encoder->velocity, NULL);
+    encoder->accel_enabled = false;
+    encoder->accel_remainder = 0;
+    encoder->detent_count = 0;
+    encoder->unread_steps = 0;
+    encoder->reported_button = false;
+    memset(&encoder->stats, 0, sizeof(encoder->stats));
     
     // Initialize GPIO pins for encoder
     if (config->pull_up) {
@@ -194,11 +354,15 @@ hw_result_t encoder_ec11_init(encoder_ec11_t *encoder, const encoder_config_t *c
     bool a = gpio_get(config->pin_a);
     bool b = gpio_get(config->pin_b);
     encoder->state = (a << 1) | b;
+    encoder->rest_state = encoder->state;
     
-    // Store instance for ISR access (with critical section for thread safety)
-    uint32_t save = save_and_disable_interrupts();
-    encoder_instances[num_encoders++] = encoder;
-    restore_interrupts(save);
+    // Start the hardware decoder
+    if (config->backend == ENCODER_BACKEND_PIO) {
+        hw_result_t result = pio_init(encoder);
+        if (result != HW_OK) {
+            return result;
+        }
+    }
     
     return HW_OK;
 }
@@ -209,23 +373,18 @@ void encoder_ec11_deinit(encoder_ec11_t *encoder) {
     // Disable interrupts
     encoder_ec11_disable_interrupts(encoder);
     
-    // Remove from instances (with critical section for thread safety)
-    uint32_t save = save_and_disable_interrupts();
-    for (int i = 0; i < num_encoders; i++) {
-        if (encoder_instances[i] == encoder) {
-            // Shift remaining instances
-            for (int j = i; j < num_encoders - 1; j++) {
-                encoder_instances[j] = encoder_instances[j + 1];
-            }
-            encoder_instances[--num_encoders] = NULL;
-            break;
-        }
+    if (encoder->config.backend == ENCODER_BACKEND_PIO) {
+        pio_deinit(encoder);
     }
-    restore_interrupts(save);
 }
 
 int32_t encoder_ec11_get_position(encoder_ec11_t *encoder) {
-    return encoder ? encoder->position : 0;
+    if (!encoder) return 0;
+    
+    if (encoder->config.backend == ENCODER_BACKEND_PIO) {
+        pio_update_position(encoder);
+    }
+    return encoder->position;
 }
 
 void encoder_ec11_set_position(encoder_ec11_t *encoder, int32_t position) {
@@ -257,24 +416,88 @@ void encoder_ec11_set_callback(encoder_ec11_t *encoder,
     }
 }
 
+void encoder_ec11_set_queue(encoder_ec11_t *encoder, hw_event_queue_t *queue) {
+    if (encoder) {
+        encoder->event_queue = queue;
+    }
+}
+
+int32_t encoder_ec11_get_velocity(encoder_ec11_t *encoder) {
+    if (!encoder) return 0;
+    
+    // Fold in the hardware count so the PIO backend's estimate is current
+    if (encoder->config.backend == ENCODER_BACKEND_PIO) {
+        pio_update_position(encoder);
+    }
+    
+    uint32_t save = save_and_disable_interrupts();
+    int32_t speed = encoder_velocity_get(&encoder->velocity, hw_time_us());
+    restore_interrupts(save);
+    return speed;
+}
+
+void encoder_ec11_set_velocity_config(encoder_ec11_t *encoder, const encoder_velocity_config_t *config) {
+    if (!encoder) return;
+    
+    uint32_t save = save_and_disable_interrupts();
+    encoder_velocity_init(&encoder->velocity, config);
+    restore_interrupts(save);
+}
+
+void encoder_ec11_set_acceleration(encoder_ec11_t *encoder, const encoder_accel_t *accel) {
+    if (!encoder) return;
+    
+    uint32_t save = save_and_disable_interrupts();
+    if (accel) {
+        encoder->accel = *accel;
+    }
+    encoder->accel_enabled = (accel != NULL);
+    encoder->accel_remainder = 0;
+    restore_interrupts(save);
+}
+
+void encoder_ec11_get_stats(encoder_ec11_t *encoder, encoder_stats_t *stats) {
+    if (!encoder || !stats) return;
+    
+    uint32_t save = save_and_disable_interrupts();
+    *stats = encoder->stats;
+    restore_interrupts(save);
+}
+
+void encoder_ec11_reset_stats(encoder_ec11_t *encoder) {
+    if (!encoder) return;
+    
+    uint32_t save = save_and_disable_interrupts();
+    memset(&encoder->stats, 0, sizeof(encoder->stats));
+    restore_interrupts(save);
+}
+
 encoder_event_t encoder_ec11_poll(encoder_ec11_t *encoder) {
     if (!encoder) return ENCODER_EVENT_NONE;
     
-    static int32_t last_position = 0;
-    static bool last_button = false;
+    if (encoder->config.backend == ENCODER_BACKEND_PIO) {
+        pio_update_position(encoder);
+    }
     
-    // Check for rotation
-    int32_t current_pos = encoder->position;
-    if (current_pos != last_position) {
-        int32_t delta = current_pos - last_position;
-        last_position = current_pos;
-        return (delta > 0) ? ENCODER_EVENT_CW : ENCODER_EVENT_CCW;
+    // Take one unread step, if any
+    encoder_event_t event = ENCODER_EVENT_NONE;
+    uint32_t save = save_and_disable_interrupts();
+    if (encoder->unread_steps > 0) {
+        encoder->unread_steps--;
+        event = ENCODER_EVENT_CW;
+    } else if (encoder->unread_steps < 0) {
+        encoder->unread_steps++;
+        event = ENCODER_EVENT_CCW;
+    }
+    restore_interrupts(save);
+    if (event != ENCODER_EVENT_NONE) {
+        return event;
     }
     
     // Check for button
     bool current_button = encoder->button_pressed;
-    if (current_button != last_button) {
-        last_button = current_button;
+    if (current_button != encoder->reported_button) {
+        encoder->reported_button = current_button;
         return current_button ? ENCODER_EVENT_BUTTON_PRESS : ENCODER_EVENT_BUTTON_RELEASE;
     }
     
@@ -284,50 +507,78 @@ encoder_event_t encoder_ec11_poll(encoder_ec11_t *encoder) {
 int32_t encoder_ec11_get_delta(encoder_ec11_t *encoder) {
     if (!encoder) return 0;
     
-    static int32_t last_position = 0;
-    int32_t current_pos = encoder->position;
-    int32_t delta = current_pos - last_position;
-    last_position = current_pos;
+    if (encoder->config.backend == ENCODER_BACKEND_PIO) {
+        pio_update_position(encoder);
+    }
+    
+    // Read and clear in one step so no rotation lands in between
+    uint32_t save = save_and_disable_interrupts();
+    int32_t delta = encoder->unread_steps;
+    encoder->unread_steps = 0;
+    restore_interrupts(save);
     
     return delta;
 }
 
+void encoder_ec11_process_sample(encoder_ec11_t *encoder, uint32_t gpio_state, uint64_t now) {
+    if (!encoder) return;
+    
+    encoder_state_t new_state = (((gpio_state >> encoder->config.pin_a) & 1) << 1) |
+                                ((gpio_state >> encoder->config.pin_b) & 1);
+    if (new_state != encoder->state) {
+        update_position(encoder, new_state, now);
+    }
+    
+    if (encoder->config.pin_button != (uint)-1) {
+        bool pressed = !((gpio_state >> encoder->config.pin_button) & 1);  // Active low
+        if (pressed != encoder->button_pressed) {
+            update_button(encoder, pressed, now);
+        }
+    }
+}
+
 hw_result_t encoder_ec11_enable_interrupts(encoder_ec11_t *encoder) {
     if (!encoder) return HW_INVALID_PARAM;
     
+    hw_result_t result = HW_OK;
+    
     // Enable interrupts on both edges for encoder pins
-    // Both pins need to trigger the callback to catch all state transitions
-    gpio_set_irq_enabled_with_callback(encoder->config.pin_a, 
-                                       GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                                       true, gpio_callback);
-    gpio_set_irq_enabled_with_callback(encoder->config.pin_b, 
-                                       GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                                       true, gpio_callback);
-    
-    // Enable button interrupt if used
-    if (encoder->config.pin_button != (uint)-1) {
-        gpio_set_irq_enabled(encoder->config.pin_button, 
-                             GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                             true);
+    // Both pins need to trigger the handler to catch all state transitions
+    // (with the PIO backend the state machine counts; only the button needs them)
+    if (encoder->config.backend == ENCODER_BACKEND_IRQ) {
+        result = hw_gpio_irq_register(encoder->config.pin_a, 
+                                      GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
+                                      gpio_irq_handler, encoder);
+        if (result == HW_OK) {
+            result = hw_gpio_irq_register(encoder->config.pin_b, 
+                                          GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
+                                          gpio_irq_handler, encoder);
+        }
     }
     
-    return HW_OK;
+    // Enable button interrupt if used (sampled encoders read it with A and B)
+    if (result == HW_OK && encoder->config.pin_button != (uint)-1 &&
+        encoder->config.backend != ENCODER_BACKEND_SAMPLED) {
+        result = hw_gpio_irq_register(encoder->config.pin_button, 
+                                      GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
+                                      gpio_irq_handler, encoder);
+    }
+    
+    // Pin owned by another driver: release whatever was registered
+    if (result != HW_OK) {
+        encoder_ec11_disable_interrupts(encoder);
+    }
+    return result;
 }
 
 void encoder_ec11_disable_interrupts(encoder_ec11_t *encoder) {
     if (!encoder) return;
     
-    // Disable all interrupts
-    gpio_set_irq_enabled(encoder->config.pin_a, 
-                         GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                         false);
-    gpio_set_irq_enabled(encoder->config.pin_b, 
-                         GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                         false);
+    // Disable all interrupts (pins this encoder does not own are left alone)
+    hw_gpio_irq_unregister(encoder->config.pin_a, encoder);
+    hw_gpio_irq_unregister(encoder->config.pin_b, encoder);
     
     if (encoder->config.pin_button != (uint)-1) {
-        gpio_set_irq_enabled(encoder->config.pin_button, 
-                             GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, 
-                             false);
+        hw_gpio_irq_unregister(encoder->config.pin_button, encoder);
     }
 }
\ No newline at end of file
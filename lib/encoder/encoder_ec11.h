@@ -2,24 +2,43 @@
  * @file encoder_ec11.h
  * @brief Driver for EC11 rotary encoder with push button
  * 
- * This driver provides interrupt-driven quadrature decoding for EC11-style
- * rotary encoders. It handles debouncing, direction detection, and optional
- * push button functionality.
+ * This driver provides quadrature decoding for EC11-style rotary encoders.
+ * It handles direction detection, contact bounce (in the detent decoder,
+ * with no time-based debounce) and an optional debounced push button.
+ *
+ * The position counts detents, not quadrature edges: an EC11 moves through
+ * all four input states (counts_per_detent = 4) between clicks, and a step
+ * is reported when the inputs settle back in the rest state the encoder was
+ * in at init, so contact bounce around a detent never produces steps. The
+ * encoder must be resting on a detent when it is initialized.
+ *
+ * Two decoding backends are available:
+ * - ENCODER_BACKEND_IRQ (default): a GPIO interrupt on every edge of A and B.
+ * - ENCODER_BACKEND_PIO: a PIO state machine decodes and counts in hardware,
+ *   so rotation costs no interrupts at any speed. The position is read from
+ *   the state machine when asked for, and rotation callbacks are delivered
+ *   from that read (thread context, one per read with the net direction).
+ *   Needs pin_b == pin_a + 1.
+ * - ENCODER_BACKEND_SAMPLED: no pin interrupts; an encoder_sampler reads all
+ *   GPIOs at once on a fixed timer tick and feeds every encoder (and button)
+ *   it serves, so the interrupt rate does not depend on rotation speed.
  */
 
 #ifndef ENCODER_EC11_H
 #define ENCODER_EC11_H
 
+#include "hardware/pio.h"
+
 // =============================================================================
 // Configuration
 // =============================================================================
 
-/** Default debounce time in microseconds */
-#define ENCODER_DEFAULT_DEBOUNCE_US 1000
-
 /** Default button debounce time in microseconds */
 #define ENCODER_DEFAULT_BUTTON_DEBOUNCE_US 50000
 
+/** Default quadrature counts per detent (EC11: one full cycle per click) */
+#define ENCODER_DEFAULT_COUNTS_PER_DETENT 4
+
 // =============================================================================
 // Type Definitions
 // =============================================================================
@@ -33,17 +52,35 @@ typedef enum {
     ENCODER_EVENT_BUTTON_RELEASE,///< Button released
 } encoder_event_t;
 
+/** Quadrature decoding backend */
+typedef enum {
+    ENCODER_BACKEND_IRQ = 0,    ///< GPIO edge interrupts
+    ENCODER_BACKEND_PIO,        ///< PIO state machine counts in hardware
+    ENCODER_BACKEND_SAMPLED,    ///< Inputs read by an encoder_sampler tick
+} encoder_backend_t;
+
 /** Encoder configuration */
 typedef struct {
     uint pin_a;                 ///< Encoder A pin (CLK)
     uint pin_b;                 ///< Encoder B pin (DT)
     uint pin_button;            ///< Push button pin (SW), set to -1 if not used
     bool invert_direction;      ///< Invert rotation direction
-    uint32_t debounce_us;       ///< Encoder debounce time in microseconds
     uint32_t button_debounce_us;///< Button debounce time in microseconds
     bool pull_up;               ///< Use internal pull-ups (true) or pull-downs (false)
+    encoder_backend_t backend;  ///< Decoding backend (zero-initialized: GPIO interrupts)
+    PIO pio;                    ///< PIO instance (ENCODER_BACKEND_PIO only)
+    uint sm;                    ///< State machine number (ENCODER_BACKEND_PIO only)
+    uint8_t counts_per_detent;  ///< Quadrature counts per detent: 1, 2 or 4 (0 = 4)
+    uint8_t detent_hysteresis;  ///< Counts a detent may fall short at rest and still register (0 = half a detent)
 } encoder_config_t;
 
+/** Decoder diagnostics (IRQ and sampled backends) */
+typedef struct {
+    uint32_t illegal_transitions; ///< Both inputs changed between reads (an edge was missed)
+    uint32_t bounces;           ///< Interrupts that found the inputs unchanged
+    uint32_t partial_detents;   ///< Detents abandoned at rest after a missed edge
+} encoder_stats_t;
+
 /** Encoder state machine states */
 typedef enum {
     ENCODER_STATE_00 = 0,
@@ -64,14 +101,30 @@ typedef struct {
     
     // State tracking
     encoder_state_t state;      ///< Current state machine state
-    uint64_t last_change_us;    ///< Last state change time
+    encoder_state_t rest_state; ///< Input state at a detent (sampled at init)
+    int32_t detent_count;       ///< Quadrature counts toward the next detent
+    encoder_stats_t stats;      ///< Decoder diagnostics
+    uint32_t pio_count;         ///< State machine count at the last read (PIO backend)
     
     // Button state
     volatile bool button_pressed; ///< Current button state
     uint64_t button_change_us;  ///< Last button change time
     
+    // Polling state
+    volatile int32_t unread_steps; ///< Rotation not yet taken by poll/get_delta
+    bool reported_button;       ///< Button state last returned by poll
+    
     // Event callback
     void (*event_callback)(encoder_event_t event, int32_t position); ///< Optional event callback
+    
+    // Event queue
+    hw_event_queue_t *event_queue; ///< Optional queue fed with rotation and button events
+    
+    // Speed and acceleration
+    encoder_velocity_t velocity; ///< Speed estimator (detents after invert_direction)
+    encoder_accel_t accel;      ///< Acceleration curve
+    bool accel_enabled;         ///< Scale steps by accel
+    int32_t accel_remainder;    ///< Fractional step carried between scaled steps (Q8)
 } encoder_ec11_t;
 
 // =============================================================================
@@ -82,7 +135,10 @@ typedef struct {
  * Initialize encoder
  * @param encoder Pointer to encoder instance
  * @param config Pointer to configuration
- * @return HW_OK on success, error code otherwise
+ * @return HW_OK on success, HW_INVALID_PARAM if counts_per_detent is not 1,
+ *         2 or 4 or the PIO backend's pins are not consecutive, HW_BUSY if
+ *         its state machine is claimed, HW_ERROR
+ *         if the PIO program does not fit
  */
 hw_result_t encoder_ec11_init(encoder_ec11_t *encoder, const encoder_config_t *config);
 
@@ -94,6 +150,10 @@ void encoder_ec11_deinit(encoder_ec11_t *encoder);
 
 /**
  * Get current position
+ *
+ * With the PIO backend this reads the hardware count, applies limits and
+ * delivers the rotation callback, so call it from thread context.
+ *
  * @param encoder Pointer to encoder instance
  * @return Current position value
  */
@@ -137,23 +197,112 @@ void encoder_ec11_set_callback(encoder_ec11_t *encoder,
                                void (*callback)(encoder_event_t, int32_t));
 
 /**
- * Poll for encoder events (alternative to interrupt-driven operation)
+ * Feed rotation and button events into a queue (alongside any callback)
+ *
+ * Rotation events carry the signed step count in delta (IRQ backend: one
+ * event per detent from the interrupt; PIO backend: one event per position
+ * read with the net delta) and pin_a as the pin. Button events carry
+ * pin_button.
+ *
+ * @param encoder Pointer to encoder instance
+ * @param queue Initialized queue (NULL to disable)
+ */
+void encoder_ec11_set_queue(encoder_ec11_t *encoder, hw_event_queue_t *queue);
+
+/**
+ * Get rotation speed
+ *
+ * Estimated from the times detents complete (see encoder_velocity.h), before
+ * acceleration. With the PIO backend detents are only timestamped when the
+ * position is read, so the estimate is only as fine as the rate of reads;
+ * this call reads it too.
+ *
+ * @param encoder Pointer to encoder instance
+ * @return Signed speed in detents per second (positive = CW); see
+ *         encoder_velocity_to_rpm (with detents per revolution)
+ */
+int32_t encoder_ec11_get_velocity(encoder_ec11_t *encoder);
+
+/**
+ * Change the speed estimator settings (resets the estimate)
+ * @param encoder Pointer to encoder instance
+ * @param config Settings (NULL for the defaults)
+ */
+void encoder_ec11_set_velocity_config(encoder_ec11_t *encoder, const encoder_velocity_config_t *config);
+
+/**
+ * Scale rotation by speed
+ *
+ * Detent steps (IRQ backend: each detent; PIO backend: each read) are
+ * multiplied by the curve's gain at the current speed, in detents per
+ * second, before they move the position and are reported to the callback
+ * and queue. Limits apply to the scaled position.
+ *
+ * @param encoder Pointer to encoder instance
+ * @param accel Curve, copied (NULL to disable)
+ */
+void encoder_ec11_set_acceleration(encoder_ec11_t *encoder, const encoder_accel_t *accel);
+
+/**
+ * Read the decoder diagnostics
+ *
+ * A steady rise in illegal transitions means edges arrive faster than the
+ * interrupt handler runs; bounces are harmless.
+ *
+ * @param encoder Pointer to encoder instance
+ * @param stats Receives the counters
+ */
+void encoder_ec11_get_stats(encoder_ec11_t *encoder, encoder_stats_t *stats);
+
+/**
+ * Zero the decoder diagnostics
+ * @param encoder Pointer to encoder instance
+ */
+void encoder_ec11_reset_stats(encoder_ec11_t *encoder);
+
+/**
+ * Poll for encoder events (alternative to callbacks and queues)
+ *
+ * Takes one unread step per call, so every detent is reported once; shares
+ * the unread steps with encoder_ec11_get_delta. The button is reported
+ * once there are no steps left.
+ *
  * @param encoder Pointer to encoder instance
  * @return Event type if an event occurred
  */
 encoder_event_t encoder_ec11_poll(encoder_ec11_t *encoder);
 
 /**
- * Get position change since last call
+ * Take all unread rotation
+ *
+ * Counts rotation (after acceleration) rather than position change, so
+ * limits, wrap-around and encoder_ec11_set_position do not show up in it.
+ * Read and cleared with interrupts masked, so steps arriving meanwhile are
+ * kept for the next call.
+ *
  * @param encoder Pointer to encoder instance
- * @return Position change (positive = CW, negative = CCW)
+ * @return Steps since the last call (positive = CW, negative = CCW)
  */
 int32_t encoder_ec11_get_delta(encoder_ec11_t *encoder);
 
 /**
- * Enable interrupt-driven operation
+ * Decode the encoder's pins from a snapshot of all GPIO inputs
+ *
+ * Called by encoder_sampler for ENCODER_BACKEND_SAMPLED encoders; the
+ * rotation and button paths are the same as the interrupt handler's, and
+ * so is the calling context (interrupt).
+ *
+ * @param encoder Pointer to encoder instance
+ * @param gpio_state Input levels, bit n = GPIO n (as gpio_get_all)
+ * @param now Time of the snapshot in microseconds
+ */
+void encoder_ec11_process_sample(encoder_ec11_t *encoder, uint32_t gpio_state, uint64_t now);
+
+/**
+ * Enable interrupt-driven operation (PIO backend: button interrupt only;
+ * sampled backend: none)
  * @param encoder Pointer to encoder instance
- * @return HW_OK on success
+ * @return HW_OK on success, HW_BUSY if another driver owns one of the pins
  */
 hw_result_t encoder_ec11_enable_interrupts(encoder_ec11_t *encoder);
 
@@ -187,4 +336,24 @@ static inline int32_t encoder_degrees_to_position(float degrees, int32_t counts_
     return (int32_t)((degrees * counts_per_rev) / 360.0f);
 }
 
+/**
+ * Convert encoder position to a fixed-point angle (no float math; whole turns wrap)
+ * @param position Encoder position
+ * @param counts_per_rev Encoder counts per revolution
+ * @return Angle in binary radians, ready for fxp_sin/fxp_cos
+ */
+static inline fxp_angle_t encoder_position_to_angle(int32_t position, int32_t counts_per_rev) {
+    return fxp_angle_from_ratio(position, counts_per_rev);
+}
+
+/**
+ * Convert a fixed-point angle to the nearest encoder position within one turn
+ * @param angle Angle in binary radians
+ * @param counts_per_rev Encoder counts per revolution
+ * @return Encoder position in 0..counts_per_rev-1
+ */
+static inline int32_t encoder_angle_to_position(fxp_angle_t angle, int32_t counts_per_rev) {
+    return fxp_angle_to_ratio(angle, counts_per_rev);
+}
+
 #endif // ENCODER_EC11_H
\ No newline at end of file
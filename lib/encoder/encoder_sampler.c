@@ -0,0 +1,105 @@
+/**
+ * @file encoder_sampler.c
+ * @brief Fixed-rate bulk sampling of encoders and buttons
+ */
+
+#include "../lib.h"
+
+// =============================================================================
+// Private Functions
+// =============================================================================
+
+static bool sampler_timer_callback(repeating_timer_t *timer) {
+    encoder_sampler_t *sampler = (encoder_sampler_t *)timer->user_data;
+    encoder_sampler_process(sampler, gpio_get_all(), hw_time_us());
+    return true;
+}
+
+// =============================================================================
+// Public Functions
+// =============================================================================
+
+void encoder_sampler_init(encoder_sampler_t *sampler) {
+    if (!sampler) return;
+    
+    memset(sampler, 0, sizeof(*sampler));
+}
+
+hw_result_t encoder_sampler_add_encoder(encoder_sampler_t *sampler, encoder_ec11_t *encoder) {
+    if (!sampler || !encoder || encoder->config.backend != ENCODER_BACKEND_SAMPLED) {
+        return HW_INVALID_PARAM;
+    }
+    if (sampler->num_encoders >= ENCODER_SAMPLER_MAX_ENCODERS) {
+        return HW_BUSY;
+    }
+    
+    uint32_t mask = BIT(encoder->config.pin_a) | BIT(encoder->config.pin_b);
+    if (encoder->config.pin_button != (uint)-1) {
+        mask |= BIT(encoder->config.pin_button);
+    }
+    
+    sampler->encoders[sampler->num_encoders] = encoder;
+    sampler->encoder_masks[sampler->num_encoders] = mask;
+    sampler->num_encoders++;
+    sampler->watch_mask |= mask;
+    return HW_OK;
+}
+
+hw_result_t encoder_sampler_add_button(encoder_sampler_t *sampler, button_t *button) {
+    if (!sampler || !button) {
+        return HW_INVALID_PARAM;
+    }
+    if (sampler->num_buttons >= ENCODER_SAMPLER_MAX_BUTTONS) {
+        return HW_BUSY;
+    }
+    
+    sampler->buttons[sampler->num_buttons] = button;
+    sampler->button_masks[sampler->num_buttons] = BIT(button->config.pin);
+    sampler->num_buttons++;
+    sampler->watch_mask |= BIT(button->config.pin);
+    return HW_OK;
+}
+
+void encoder_sampler_process(encoder_sampler_t *sampler, uint32_t gpio_state, uint64_t now) {
+    uint32_t changed = (gpio_state ^ sampler->last_state) & sampler->watch_mask;
+    sampler->last_state = gpio_state;
+    sampler->ticks++;
+    if (!changed) return;
+    
+    for (uint i = 0; i < sampler->num_encoders; i++) {
+        if (changed & sampler->encoder_masks[i]) {
+            encoder_ec11_process_sample(sampler->encoders[i], gpio_state, now);
+        }
+    }
+    for (uint i = 0; i < sampler->num_buttons; i++) {
+        if (changed & sampler->button_masks[i]) {
+            button_process_sample(sampler->buttons[i], gpio_state, now);
+        }
+    }
+}
+
+hw_result_t encoder_sampler_start(encoder_sampler_t *sampler, uint32_t period_us) {
+    if (!sampler) return HW_INVALID_PARAM;
+    
+    encoder_sampler_stop(sampler);
+    if (period_us == 0) {
+        period_us = ENCODER_SAMPLER_DEFAULT_PERIOD_US;
+    }
+    
+    // The drivers read their pins at init; start comparing from now
+    sampler->last_state = gpio_get_all();
+    
+    // Negative interval: start-to-start, so the tick rate is exact
+    sampler->running = true;
+    if (!add_repeating_timer_us(-(int64_t)period_us, sampler_timer_callback, sampler, &sampler->timer)) {
+        sampler->running = false;
+        return HW_ERROR;
+    }
+    return HW_OK;
+}
+
+void encoder_sampler_stop(encoder_sampler_t *sampler) {
+    if (!sampler || !sampler->running) return;
+    cancel_repeating_timer(&sampler->timer);
+    sampler->running = false;
+}
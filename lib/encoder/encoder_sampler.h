@@ -0,0 +1,105 @@
+/**
+ * @file encoder_sampler.h
+ * @brief Fixed-rate bulk sampling of encoders and buttons
+ *
+ * Instead of an interrupt per edge per pin, one repeating timer reads every
+ * GPIO input with a single gpio_get_all() per tick. Pins that changed since
+ * the previous tick are found with one XOR and mask, and only the encoders
+ * and buttons owning those pins are updated, each extracting its bits from
+ * the same snapshot. The interrupt rate is the tick rate, however fast the
+ * knobs turn.
+ *
+ * The tick must be shorter than the time between quadrature edges, or edges
+ * merge: a skipped state shows up as an illegal transition (see
+ * encoder_ec11_get_stats), which the detent decoder absorbs as long as it
+ * is occasional. A hand-turned EC11 rarely exceeds ~2000 edges/s, so a
+ * 250 us tick is a good default.
+ *
+ * Encoders use ENCODER_BACKEND_SAMPLED; buttons are polled with button_poll
+ * as usual but need no button_enable_interrupts.
+ */
+
+#ifndef ENCODER_SAMPLER_H
+#define ENCODER_SAMPLER_H
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Encoders one sampler can serve */
+#define ENCODER_SAMPLER_MAX_ENCODERS 8
+
+/** Buttons one sampler can serve */
+#define ENCODER_SAMPLER_MAX_BUTTONS 8
+
+/** Default tick in microseconds */
+#define ENCODER_SAMPLER_DEFAULT_PERIOD_US 250
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Sampler state (keep static: the tick timer refers to it) */
+typedef struct {
+    encoder_ec11_t *encoders[ENCODER_SAMPLER_MAX_ENCODERS]; ///< Served encoders
+    uint32_t encoder_masks[ENCODER_SAMPLER_MAX_ENCODERS];   ///< Pins of each encoder
+    button_t *buttons[ENCODER_SAMPLER_MAX_BUTTONS];         ///< Served buttons
+    uint32_t button_masks[ENCODER_SAMPLER_MAX_BUTTONS];     ///< Pin of each button
+    uint8_t num_encoders;        ///< Encoders in use
+    uint8_t num_buttons;         ///< Buttons in use
+    uint32_t watch_mask;         ///< Every served pin
+    uint32_t last_state;         ///< Previous snapshot
+    volatile bool running;       ///< Tick timer running
+    volatile uint32_t ticks;     ///< Snapshots taken
+    repeating_timer_t timer;     ///< Tick timer
+} encoder_sampler_t;
+
+// =============================================================================
+// API Functions
+// =============================================================================
+
+/**
+ * Initialize an empty sampler
+ * @param sampler Sampler state
+ */
+void encoder_sampler_init(encoder_sampler_t *sampler);
+
+/**
+ * Serve an encoder (stop the sampler first)
+ * @param sampler Sampler
+ * @param encoder Initialized encoder using ENCODER_BACKEND_SAMPLED
+ * @return HW_OK, HW_INVALID_PARAM for another backend, HW_BUSY if full
+ */
+hw_result_t encoder_sampler_add_encoder(encoder_sampler_t *sampler, encoder_ec11_t *encoder);
+
+/**
+ * Serve a button (stop the sampler first)
+ * @param sampler Sampler
+ * @param button Initialized button, without interrupts enabled
+ * @return HW_OK, HW_INVALID_PARAM on NULL, HW_BUSY if full
+ */
+hw_result_t encoder_sampler_add_button(encoder_sampler_t *sampler, button_t *button);
+
+/**
+ * Decode one snapshot (what each tick does, minus reading the pins)
+ * @param sampler Sampler
+ * @param gpio_state Input levels, bit n = GPIO n (as gpio_get_all)
+ * @param now Time of the snapshot in microseconds
+ */
+void encoder_sampler_process(encoder_sampler_t *sampler, uint32_t gpio_state, uint64_t now);
+
+/**
+ * Start sampling from a repeating timer
+ * @param sampler Sampler
+ * @param period_us Tick in microseconds (0 for ENCODER_SAMPLER_DEFAULT_PERIOD_US)
+ * @return HW_OK, HW_ERROR if no timer is available
+ */
+hw_result_t encoder_sampler_start(encoder_sampler_t *sampler, uint32_t period_us);
+
+/**
+ * Stop sampling
+ * @param sampler Sampler
+ */
+void encoder_sampler_stop(encoder_sampler_t *sampler);
+
+#endif // ENCODER_SAMPLER_H
@@ -0,0 +1,141 @@
+/**
+ * @file encoder_velocity.c
+ * @brief Encoder speed estimation and step acceleration
+ */
+
+#include "../lib.h"
+
+// =============================================================================
+// Velocity Estimation
+// =============================================================================
+
+/**
+ * Forget the speed and open a window at an edge
+ */
+static void restart(encoder_velocity_t *velocity, uint64_t now_us) {
+    velocity->last_edge_us = now_us;
+    velocity->window_start_us = now_us;
+    velocity->window_count = 0;
+    velocity->velocity_q8 = 0;
+    velocity->started = true;
+}
+
+void encoder_velocity_init(encoder_velocity_t *velocity, const encoder_velocity_config_t *config) {
+    if (!velocity) return;
+    
+    if (config) {
+        velocity->config = *config;
+    } else {
+        memset(&velocity->config, 0, sizeof(velocity->config));
+        velocity->config.smoothing = ENCODER_VELOCITY_DEFAULT_SMOOTHING;
+    }
+    if (velocity->config.window_us == 0) {
+        velocity->config.window_us = ENCODER_VELOCITY_DEFAULT_WINDOW_US;
+    }
+    if (velocity->config.timeout_us == 0) {
+        velocity->config.timeout_us = ENCODER_VELOCITY_DEFAULT_TIMEOUT_US;
+    }
+    if (velocity->config.smoothing > 15) {
+        velocity->config.smoothing = 15;
+    }
+    
+    velocity->last_edge_us = 0;
+    velocity->window_start_us = 0;
+    velocity->window_count = 0;
+    velocity->velocity_q8 = 0;
+    velocity->started = false;
+}
+
+void encoder_velocity_add(encoder_velocity_t *velocity, int32_t count, uint64_t now_us) {
+    if (!velocity || count == 0) return;
+    
+    // The first edge after a stop or a reversal only opens a window: the
+    // time since the previous edge says nothing about the new motion
+    bool reversed = (velocity->window_count != 0 && (velocity->window_count < 0) != (count < 0)) ||
+                    (velocity->velocity_q8 != 0 && (velocity->velocity_q8 < 0) != (count < 0));
+    if (!velocity->started || reversed ||
+        now_us - velocity->last_edge_us >= velocity->config.timeout_us) {
+        restart(velocity, now_us);
+        return;
+    }
+    
+    velocity->window_count += count;
+    velocity->last_edge_us = now_us;
+    
+    // Close the window at the first edge past window_us, so the count is
+    // always divided by the exact time between two edges
+    uint64_t elapsed = now_us - velocity->window_start_us;
+    if (elapsed < velocity->config.window_us) return;
+    
+    // One 32-bit divide (this runs in interrupt context): the rate per count
+    // is truncated by less than elapsed / 2^28 of itself, 0.1% at 250 ms
+    uint32_t span = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+    int32_t sample = velocity->window_count * (int32_t)((1000000u * 256u) / span);
+    if (velocity->velocity_q8 == 0) {
+        velocity->velocity_q8 = sample;
+    } else {
+        velocity->velocity_q8 += (sample - velocity->velocity_q8) >> velocity->config.smoothing;
+    }
+    
+    velocity->window_start_us = now_us;
+    velocity->window_count = 0;
+}
+
+int32_t encoder_velocity_get(const encoder_velocity_t *velocity, uint64_t now_us) {
+    if (!velocity || !velocity->started) return 0;
+    
+    uint64_t since = now_us - velocity->last_edge_us;
+    if (since >= velocity->config.timeout_us) return 0;
+    
+    int32_t speed = velocity->velocity_q8 / 256;
+    
+    // No edge for `since` means the encoder cannot be turning faster than
+    // one count per `since` (below timeout_us, so 32 bits suffice)
+    uint32_t since32 = (uint32_t)since;
+    if (since32 > 0) {
+        int32_t bound = (int32_t)(1000000u / since32);
+        speed = CONSTRAIN(speed, -bound, bound);
+    }
+    return speed;
+}
+
+// =============================================================================
+// Acceleration
+// =============================================================================
+
+uint32_t encoder_accel_gain(const encoder_accel_t *accel, int32_t speed) {
+    if (!accel) return ENCODER_ACCEL_GAIN_ONE;
+    
+    uint32_t magnitude = (speed < 0) ? 0u - (uint32_t)speed : (uint32_t)speed;
+    if (magnitude <= accel->min_speed) return ENCODER_ACCEL_GAIN_ONE;
+    if (magnitude >= accel->max_speed) return accel->max_gain;
+    
+    // Position along the ramp, Q8 (wide ramps drop the range's low bits
+    // rather than widen the product)
+    uint32_t offset = magnitude - accel->min_speed;
+    uint32_t range = accel->max_speed - accel->min_speed;
+    int32_t t = (range < (1u << 24)) ? (int32_t)((offset << 8) / range)
+                                     : (int32_t)MIN(offset / (range >> 8), 256u);
+    if (accel->curve == ENCODER_ACCEL_QUADRATIC) {
+        t = (t * t) >> 8;
+    }
+    
+    return (uint32_t)(ENCODER_ACCEL_GAIN_ONE +
+                      (((int32_t)accel->max_gain - ENCODER_ACCEL_GAIN_ONE) * t) / 256);
+}
+
+int32_t encoder_accel_scale(const encoder_accel_t *accel, int32_t delta, int32_t speed, int32_t *remainder) {
+    if (!accel || !remainder || delta == 0) return delta;
+    
+    // A fraction left over from the other direction would eat the first step
+    if (*remainder != 0 && (*remainder < 0) != (delta < 0)) {
+        *remainder = 0;
+    }
+    
+    // Bounded so the Q8 product fits 32 bits at any gain
+    delta = CONSTRAIN(delta, -32767, 32767);
+    int32_t total = delta * (int32_t)encoder_accel_gain(accel, speed) + *remainder;
+    int32_t steps = total / 256;
+    *remainder = total - steps * 256;
+    return steps;
+}
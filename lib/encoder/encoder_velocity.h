@@ -0,0 +1,139 @@
+/**
+ * @file encoder_velocity.h
+ * @brief Encoder speed estimation and speed-dependent step acceleration
+ *
+ * The estimator takes counts with their timestamps and never touches the
+ * hardware, so it runs unchanged on the host against synthetic edge streams.
+ * It works in whatever unit it is fed; encoder_ec11 feeds it detents, so
+ * contact bounce (which never completes a detent) cannot reverse it.
+ *
+ * Speed is measured M/T style: counts are accumulated until at least
+ * window_us has passed, and the estimate is the count divided by the time
+ * between the edges that closed the previous and current windows. Below
+ * one count per window every edge closes a window, so this is a period
+ * measurement; at speed it is a count-per-window measurement that averages
+ * out the uneven edge spacing of a mechanical encoder. Estimates are
+ * smoothed by a first-order filter, and between edges the reported speed is
+ * capped at what the time since the last edge allows, so it falls to zero
+ * when the knob stops instead of holding the last estimate.
+ *
+ * Everything here runs in interrupt context on a core without a 64-bit
+ * divider, so the arithmetic is 32-bit apart from the timestamps.
+ *
+ * Acceleration maps speed to a step gain (Q8, 256 = 1x) along a linear or
+ * quadratic ramp; scaled steps carry their fractional part forward so
+ * nothing is lost at gains between whole numbers.
+ */
+
+#ifndef ENCODER_VELOCITY_H
+#define ENCODER_VELOCITY_H
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Default minimum measurement window in microseconds */
+#define ENCODER_VELOCITY_DEFAULT_WINDOW_US 20000
+
+/** Default time without an edge after which the speed reads zero */
+#define ENCODER_VELOCITY_DEFAULT_TIMEOUT_US 250000
+
+/** Default smoothing: each estimate moves the output 1/2^n of the way */
+#define ENCODER_VELOCITY_DEFAULT_SMOOTHING 2
+
+/** Unity acceleration gain (Q8) */
+#define ENCODER_ACCEL_GAIN_ONE 256
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Estimator settings (zero fields take the defaults) */
+typedef struct {
+    uint32_t window_us;         ///< Minimum time a measurement spans
+    uint32_t timeout_us;        ///< No edge for this long reads as stopped
+    uint8_t smoothing;          ///< Filter shift (0 = unfiltered)
+} encoder_velocity_config_t;
+
+/** Estimator state */
+typedef struct {
+    encoder_velocity_config_t config; ///< Settings
+    uint64_t last_edge_us;      ///< Time of the latest count
+    uint64_t window_start_us;   ///< Edge that opened the current window
+    int32_t window_count;       ///< Counts since window_start_us
+    int32_t velocity_q8;        ///< Smoothed speed, counts/s in Q24.8 (signed)
+    bool started;               ///< At least one count seen
+} encoder_velocity_t;
+
+/** Acceleration ramp shape */
+typedef enum {
+    ENCODER_ACCEL_LINEAR = 0,   ///< Gain rises in proportion to speed
+    ENCODER_ACCEL_QUADRATIC,    ///< Gentle near min_speed, steep near max_speed
+} encoder_accel_curve_t;
+
+/** Acceleration curve */
+typedef struct {
+    uint32_t min_speed;         ///< Counts/s up to which steps pass unscaled
+    uint32_t max_speed;         ///< Counts/s at and above which max_gain applies
+    uint16_t max_gain;          ///< Step multiplier at max_speed, Q8 (256 = 1x)
+    encoder_accel_curve_t curve;///< Ramp between the two speeds
+} encoder_accel_t;
+
+// =============================================================================
+// Velocity Estimation
+// =============================================================================
+
+/**
+ * Reset an estimator
+ * @param velocity Estimator
+ * @param config Settings (NULL for the defaults)
+ */
+void encoder_velocity_init(encoder_velocity_t *velocity, const encoder_velocity_config_t *config);
+
+/**
+ * Record counts that arrived at a given time
+ * @param velocity Estimator
+ * @param count Signed counts (one edge: +-1; a batch read: the net count)
+ * @param now_us Timestamp in microseconds
+ */
+void encoder_velocity_add(encoder_velocity_t *velocity, int32_t count, uint64_t now_us);
+
+/**
+ * Current speed estimate
+ * @param velocity Estimator
+ * @param now_us Current time in microseconds
+ * @return Signed speed in counts per second
+ */
+int32_t encoder_velocity_get(const encoder_velocity_t *velocity, uint64_t now_us);
+
+/**
+ * Convert counts per second to RPM (exact below 35M counts/s)
+ */
+static inline int32_t encoder_velocity_to_rpm(int32_t counts_per_sec, int32_t counts_per_rev) {
+    return counts_per_sec * 60 / counts_per_rev;
+}
+
+// =============================================================================
+// Acceleration
+// =============================================================================
+
+/**
+ * Step gain for a speed
+ * @param accel Curve
+ * @param speed Speed in counts per second (sign ignored)
+ * @return Gain, Q8 (256 = 1x)
+ */
+uint32_t encoder_accel_gain(const encoder_accel_t *accel, int32_t speed);
+
+/**
+ * Scale a step by the gain for a speed
+ * @param accel Curve
+ * @param delta Raw counts (clamped to +-32767)
+ * @param speed Speed in counts per second
+ * @param remainder Fraction carried between calls (Q8, start at 0; reset on
+ *                  a change of direction)
+ * @return Scaled counts
+ */
+int32_t encoder_accel_scale(const encoder_accel_t *accel, int32_t delta, int32_t speed, int32_t *remainder);
+
+#endif // ENCODER_VELOCITY_H
@@ -0,0 +1,81 @@
+#include "../lib.h"
+#include "hardware/sync.h"
+
+hw_result_t hw_event_queue_init(hw_event_queue_t *queue, hw_event_t *buffer, size_t capacity) {
+    if (!queue || !buffer || capacity < 2 || (capacity & (capacity - 1)) || capacity > (1u << 31)) {
+        return HW_INVALID_PARAM;
+    }
+
+    queue->buffer = buffer;
+    queue->mask = (uint32_t)capacity - 1;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+    queue->high_water = 0;
+    return HW_OK;
+}
+
+// =============================================================================
+// Producer
+// =============================================================================
+
+bool hw_event_push(hw_event_queue_t *queue, const hw_event_t *event) {
+    uint32_t head = queue->head;
+    uint32_t used = head - queue->tail;
+    if (used > queue->mask) {
+        queue->dropped++;
+        return false;
+    }
+
+    queue->buffer[head & queue->mask] = *event;
+    __dmb();  // Entry must be visible before the consumer sees the new head
+    queue->head = head + 1;
+
+    if (used + 1 > queue->high_water) {
+        queue->high_water = used + 1;
+    }
+    return true;
+}
+
+bool hw_event_post(hw_event_queue_t *queue, hw_event_source_t source, uint8_t type,
+                   uint pin, int32_t delta, int32_t position) {
+    hw_event_t event = {
+        .time_us = (uint32_t)hw_time_us(),
+        .position = position,
+        .delta = delta,
+        .source = (uint8_t)source,
+        .type = type,
+        .pin = (uint8_t)pin,
+    };
+    return hw_event_push(queue, &event);
+}
+
+// =============================================================================
+// Consumer
+// =============================================================================
+
+bool hw_event_pop(hw_event_queue_t *queue, hw_event_t *event) {
+    return hw_event_drain(queue, event, 1) == 1;
+}
+
+size_t hw_event_drain(hw_event_queue_t *queue, hw_event_t *events, size_t max) {
+    uint32_t tail = queue->tail;
+    uint32_t n = queue->head - tail;
+    if (n > max) {
+        n = (uint32_t)max;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    __dmb();  // Read entries only after seeing the head that published them
+
+    // At most two runs: up to the end of the buffer, then from the start
+    uint32_t start = tail & queue->mask;
+    uint32_t first = MIN(n, queue->mask + 1 - start);
+    memcpy(events, &queue->buffer[start], first * sizeof(hw_event_t));
+    memcpy(events + first, queue->buffer, (n - first) * sizeof(hw_event_t));
+
+    __dmb();  // Finish reading before handing the slots back
+    queue->tail = tail + n;
+    return n;
+}
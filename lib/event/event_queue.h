@@ -0,0 +1,116 @@
+/**
+ * @file event_queue.h
+ * @brief Lock-free single-producer/single-consumer input event queue
+ *
+ * Interrupt handlers push timestamped events; the main loop drains them in
+ * batches and handles them outside interrupt context. Neither side blocks
+ * or disables interrupts to touch the queue: the producer only writes head,
+ * the consumer only writes tail, and a memory barrier orders each entry
+ * against its index.
+ *
+ * "Single producer" means pushes must not preempt each other. Handlers of
+ * one IRQ (e.g. every GPIO callback on one core) qualify; a thread-context
+ * producer sharing a queue with an ISR masks interrupts around its push, as
+ * button_poll does. The consumer may run on either core.
+ */
+
+#ifndef PICO_HW_EVENT_QUEUE_H
+#define PICO_HW_EVENT_QUEUE_H
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Suggested capacity (must be a power of two) */
+#define HW_EVENT_QUEUE_DEFAULT_CAPACITY 32
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Driver that produced an event */
+typedef enum {
+    HW_EVENT_SOURCE_ENCODER = 0,  ///< encoder_ec11 (type is an encoder_event_t)
+    HW_EVENT_SOURCE_BUTTON,       ///< button (type is a button_event_t)
+} hw_event_source_t;
+
+/** Input event (16 bytes) */
+typedef struct {
+    uint32_t time_us;       ///< Low 32 bits of hw_time_us() when the event occurred
+    int32_t position;       ///< Encoder: position after the event; button: click count
+    int32_t delta;          ///< Encoder: signed steps in this event; button: 0
+    uint8_t source;         ///< hw_event_source_t
+    uint8_t type;           ///< encoder_event_t or button_event_t
+    uint8_t pin;            ///< GPIO identifying the device (encoder pin A or button pin)
+} hw_event_t;
+
+/** Queue state */
+typedef struct {
+    hw_event_t *buffer;           ///< Entry storage (caller-owned)
+    uint32_t mask;                ///< Capacity - 1
+    volatile uint32_t head;       ///< Entries ever pushed (producer only)
+    volatile uint32_t tail;       ///< Entries ever popped (consumer only)
+    volatile uint32_t dropped;    ///< Events lost to a full queue (producer only)
+    volatile uint32_t high_water; ///< Most entries ever queued at once (producer only)
+} hw_event_queue_t;
+
+// =============================================================================
+// API Functions
+// =============================================================================
+
+/**
+ * Initialize an empty queue
+ * @param queue Queue state
+ * @param buffer Entry storage; must outlive the queue
+ * @param capacity Entries in buffer, a power of two (at least 2)
+ * @return HW_INVALID_PARAM if capacity is not a power of two
+ */
+hw_result_t hw_event_queue_init(hw_event_queue_t *queue, hw_event_t *buffer, size_t capacity);
+
+/**
+ * Push an event (producer side)
+ * @param queue Queue
+ * @param event Event to copy in
+ * @return false if the queue was full (the event is counted in dropped)
+ */
+bool hw_event_push(hw_event_queue_t *queue, const hw_event_t *event);
+
+/**
+ * Timestamp and push an event (producer side)
+ * @return false if the queue was full
+ */
+bool hw_event_post(hw_event_queue_t *queue, hw_event_source_t source, uint8_t type,
+                   uint pin, int32_t delta, int32_t position);
+
+/**
+ * Pop the oldest event (consumer side)
+ * @param queue Queue
+ * @param event Receives the event
+ * @return false if the queue was empty
+ */
+bool hw_event_pop(hw_event_queue_t *queue, hw_event_t *event);
+
+/**
+ * Pop up to max events in one go (consumer side)
+ * @param queue Queue
+ * @param events Receives the events, oldest first
+ * @param max Capacity of events
+ * @return Events copied
+ */
+size_t hw_event_drain(hw_event_queue_t *queue, hw_event_t *events, size_t max);
+
+/**
+ * Events waiting (consumer side; more may arrive at any moment)
+ */
+static inline uint32_t hw_event_queue_count(const hw_event_queue_t *queue) {
+    return queue->head - queue->tail;
+}
+
+/**
+ * Total events lost to a full queue since init
+ */
+static inline uint32_t hw_event_queue_dropped(const hw_event_queue_t *queue) {
+    return queue->dropped;
+}
+
+#endif // PICO_HW_EVENT_QUEUE_H
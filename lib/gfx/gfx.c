@@ -0,0 +1,364 @@
+#include "../lib.h"
+#include <stdlib.h>
+
+// =============================================================================
+// Clipping helpers
+// =============================================================================
+
+// Report the clipped bounding box of a primitive; returns false if fully off-surface
+static bool begin(const gfx_target_t *t, int x0, int y0, int x1, int y1) {
+    if (x1 < 0 || y1 < 0 || x0 >= t->width || y0 >= t->height) return false;
+    if (t->bbox) {
+        t->bbox(t->ctx, MAX(x0, 0), MAX(y0, 0), MIN(x1, t->width - 1), MIN(y1, t->height - 1));
+    }
+    return true;
+}
+
+// True if the bounding box lies entirely on the surface (no per-pixel clipping needed)
+static inline bool inside(const gfx_target_t *t, int x0, int y0, int x1, int y1) {
+    return x0 >= 0 && y0 >= 0 && x1 < t->width && y1 < t->height;
+}
+
+// Plot with bounds checked only when clip is set
+static inline void plot(const gfx_target_t *t, int x, int y, bool clip) {
+    if (clip && ((unsigned)x >= (unsigned)t->width || (unsigned)y >= (unsigned)t->height)) return;
+    t->plot(t->ctx, x, y);
+}
+
+// Horizontal span x0..x1 on row y, clipped
+static void span(const gfx_target_t *t, int x0, int x1, int y) {
+    if ((unsigned)y >= (unsigned)t->height) return;
+    x0 = MAX(x0, 0);
+    x1 = MIN(x1, t->width - 1);
+    if (x0 > x1) return;
+    if (t->span) {
+        t->span(t->ctx, x0, x1, y);
+    } else {
+        for (int x = x0; x <= x1; x++) t->plot(t->ctx, x, y);
+    }
+}
+
+// Cohen-Sutherland outcodes
+#define CLIP_LEFT   1
+#define CLIP_RIGHT  2
+#define CLIP_TOP    4
+#define CLIP_BOTTOM 8
+
+static inline int outcode(const gfx_target_t *t, int x, int y) {
+    int code = 0;
+    if (x < 0) code |= CLIP_LEFT;
+    else if (x >= t->width) code |= CLIP_RIGHT;
+    if (y < 0) code |= CLIP_TOP;
+    else if (y >= t->height) code |= CLIP_BOTTOM;
+    return code;
+}
+
+// =============================================================================
+// Primitives
+// =============================================================================
+
+// Clipped to the surface once, then plotted unchecked
+void gfx_line(const gfx_target_t *t, int16_t x0_in, int16_t y0_in, int16_t x1_in, int16_t y1_in) {
+    int x0 = x0_in, y0 = y0_in, x1 = x1_in, y1 = y1_in;
+    int c0 = outcode(t, x0, y0);
+    int c1 = outcode(t, x1, y1);
+
+    while (c0 | c1) {
+        if (c0 & c1) return;  // Entirely off one side
+
+        int c = c0 ? c0 : c1;
+        int x, y;
+        if (c & CLIP_BOTTOM) {
+            x = x0 + (x1 - x0) * (t->height - 1 - y0) / (y1 - y0);
+            y = t->height - 1;
+        } else if (c & CLIP_TOP) {
+            x = x0 + (x1 - x0) * (0 - y0) / (y1 - y0);
+            y = 0;
+        } else if (c & CLIP_RIGHT) {
+            y = y0 + (y1 - y0) * (t->width - 1 - x0) / (x1 - x0);
+            x = t->width - 1;
+        } else {
+            y = y0 + (y1 - y0) * (0 - x0) / (x1 - x0);
+            x = 0;
+        }
+
+        if (c == c0) {
+            x0 = x; y0 = y; c0 = outcode(t, x0, y0);
+        } else {
+            x1 = x; y1 = y; c1 = outcode(t, x1, y1);
+        }
+    }
+
+    begin(t, MIN(x0, x1), MIN(y0, y1), MAX(x0, x1), MAX(y0, y1));
+
+    // Horizontal runs go through the span callback
+    if (y0 == y1) {
+        span(t, MIN(x0, x1), MAX(x0, x1), y0);
+        return;
+    }
+
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+
+    while (1) {
+        t->plot(t->ctx, x0, y0);
+        if (x0 == x1 && y0 == y1) break;
+
+        int e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void gfx_fill_rect(const gfx_target_t *t, int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    if (w == 0 || h == 0) return;
+    int x1 = x + w - 1;
+    int y1 = y + h - 1;
+    if (!begin(t, x, y, x1, y1)) return;
+
+    for (int row = MAX(y, 0); row <= MIN(y1, t->height - 1); row++) {
+        span(t, x, x1, row);
+    }
+}
+
+void gfx_circle(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r) {
+    if (!begin(t, cx - r, cy - r, cx + r, cy + r)) return;
+    bool clip = !inside(t, cx - r, cy - r, cx + r, cy + r);
+
+    int x = r;
+    int y = 0;
+    int err = 1 - x;
+    while (x >= y) {
+        plot(t, cx + x, cy + y, clip);
+        plot(t, cx + y, cy + x, clip);
+        plot(t, cx - y, cy + x, clip);
+        plot(t, cx - x, cy + y, clip);
+        plot(t, cx - x, cy - y, clip);
+        plot(t, cx - y, cy - x, clip);
+        plot(t, cx + y, cy - x, clip);
+        plot(t, cx + x, cy - y, clip);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void gfx_fill_circle(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r) {
+    if (!begin(t, cx - r, cy - r, cx + r, cy + r)) return;
+
+    int x = r;
+    int y = 0;
+    int err = 1 - x;
+    while (x >= y) {
+        // Rows cy +/- y get a new width every step
+        span(t, cx - x, cx + x, cy + y);
+        if (y != 0) span(t, cx - x, cx + x, cy - y);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            // Rows cy +/- x are final once x is about to change
+            if (x >= y) {
+                span(t, cx - (y - 1), cx + (y - 1), cy + x);
+                span(t, cx - (y - 1), cx + (y - 1), cy - x);
+            }
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+// Midpoint ellipse; outline plots four points per step, fill emits one span per row
+static void ellipse(const gfx_target_t *t, int cx, int cy, int rx, int ry, bool fill) {
+    if (!begin(t, cx - rx, cy - ry, cx + rx, cy + ry)) return;
+    bool clip = !inside(t, cx - rx, cy - ry, cx + rx, cy + ry);
+
+    int32_t rx2 = (int32_t)rx * rx;
+    int32_t ry2 = (int32_t)ry * ry;
+    int32_t x = 0;
+    int32_t y = ry;
+    int32_t px = 0;
+    int32_t py = 2 * rx2 * y;
+
+    // Region 1: slope > -1, x advances every step
+    int32_t p = ry2 - rx2 * ry + rx2 / 4;
+    while (px < py) {
+        if (!fill) {
+            plot(t, cx + x, cy + y, clip);
+            plot(t, cx - x, cy + y, clip);
+            plot(t, cx + x, cy - y, clip);
+            plot(t, cx - x, cy - y, clip);
+        }
+        x++;
+        px += 2 * ry2;
+        if (p < 0) {
+            p += ry2 + px;
+        } else {
+            // Row y is final before stepping to the next one
+            if (fill) {
+                span(t, cx - (x - 1), cx + (x - 1), cy + y);
+                span(t, cx - (x - 1), cx + (x - 1), cy - y);
+            }
+            y--;
+            py -= 2 * rx2;
+            p += ry2 + px - py;
+        }
+    }
+
+    // Region 2: y advances every step
+    p = ry2 * (2 * x + 1) * (2 * x + 1) / 4 + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+    while (y >= 0) {
+        if (fill) {
+            span(t, cx - x, cx + x, cy + y);
+            if (y != 0) span(t, cx - x, cx + x, cy - y);
+        } else {
+            plot(t, cx + x, cy + y, clip);
+            plot(t, cx - x, cy + y, clip);
+            plot(t, cx + x, cy - y, clip);
+            plot(t, cx - x, cy - y, clip);
+        }
+        y--;
+        py -= 2 * rx2;
+        if (p > 0) {
+            p += rx2 - py;
+        } else {
+            x++;
+            px += 2 * ry2;
+            p += rx2 - py + px;
+        }
+    }
+}
+
+void gfx_ellipse(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry) {
+    ellipse(t, cx, cy, rx, ry, false);
+}
+
+void gfx_fill_ellipse(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry) {
+    ellipse(t, cx, cy, rx, ry, true);
+}
+
+// The angle test uses cross products against the two end directions, so the
+// only trig is two fixed-point sin/cos lookups per arc.
+void gfx_arc(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r, int16_t start_deg, int16_t end_deg) {
+    int sweep = end_deg - start_deg;
+    if (sweep <= 0) return;
+    if (sweep >= 360) {
+        gfx_circle(t, cx, cy, r);
+        return;
+    }
+    if (!begin(t, cx - r, cy - r, cx + r, cy + r)) return;
+    bool clip = !inside(t, cx - r, cy - r, cx + r, cy + r);
+
+    fxp_angle_t start = fxp_angle_from_deg(start_deg);
+    fxp_angle_t end = fxp_angle_from_deg(end_deg);
+    int32_t sx = fxp_cos(start);
+    int32_t sy = fxp_sin(start);
+    int32_t ex = fxp_cos(end);
+    int32_t ey = fxp_sin(end);
+    bool narrow = sweep <= 180;
+
+    int x = r;
+    int y = 0;
+    int err = 1 - x;
+    while (x >= y) {
+        const int pts[8][2] = {
+            { x,  y}, { y,  x}, {-y,  x}, {-x,  y},
+            {-x, -y}, {-y, -x}, { y, -x}, { x, -y},
+        };
+        for (int i = 0; i < 8; i++) {
+            int32_t px = pts[i][0];
+            int32_t py = pts[i][1];
+            bool after_start = sx * py - sy * px >= 0;
+            bool before_end = px * ey - py * ex >= 0;
+            bool in_arc = narrow ? (after_start && before_end) : (after_start || before_end);
+            if (in_arc) {
+                plot(t, cx + px, cy + py, clip);
+            }
+        }
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void gfx_polyline(const gfx_target_t *t, const gfx_point_t *pts, uint8_t count, bool closed) {
+    if (!pts || count == 0) return;
+    if (count == 1) {
+        gfx_line(t, pts[0].x, pts[0].y, pts[0].x, pts[0].y);
+        return;
+    }
+    for (uint8_t i = 0; i + 1 < count; i++) {
+        gfx_line(t, pts[i].x, pts[i].y, pts[i + 1].x, pts[i + 1].y);
+    }
+    if (closed && count > 2) {
+        gfx_line(t, pts[count - 1].x, pts[count - 1].y, pts[0].x, pts[0].y);
+    }
+}
+
+void gfx_fill_polygon(const gfx_target_t *t, const gfx_point_t *pts, uint8_t count) {
+    if (!pts || count < 3 || count > GFX_POLY_MAX_VERTICES) return;
+
+    int x_min = pts[0].x, x_max = pts[0].x;
+    int y_min = pts[0].y, y_max = pts[0].y;
+    for (uint8_t i = 1; i < count; i++) {
+        x_min = MIN(x_min, pts[i].x);
+        x_max = MAX(x_max, pts[i].x);
+        y_min = MIN(y_min, pts[i].y);
+        y_max = MAX(y_max, pts[i].y);
+    }
+    if (!begin(t, x_min, y_min, x_max, y_max)) return;
+
+    y_min = MAX(y_min, 0);
+    y_max = MIN(y_max, t->height - 1);
+
+    int16_t nodes[GFX_POLY_MAX_VERTICES];
+    for (int y = y_min; y <= y_max; y++) {
+        // Collect edge crossings for this row
+        uint8_t n = 0;
+        for (uint8_t i = 0, j = count - 1; i < count; j = i++) {
+            // Walk each edge top to bottom so an edge shared by two polygons
+            // rounds the same way in both and they tile without overlap
+            const gfx_point_t *a = &pts[i], *b = &pts[j];
+            if (a->y > b->y) {
+                const gfx_point_t *tmp = a;
+                a = b;
+                b = tmp;
+            }
+            if (a->y <= y && y < b->y) {
+                nodes[n++] = a->x + (int32_t)(y - a->y) * (b->x - a->x) / (b->y - a->y);
+            }
+        }
+
+        // Insertion sort (n is tiny)
+        for (uint8_t i = 1; i < n; i++) {
+            int16_t v = nodes[i];
+            int k = i - 1;
+            while (k >= 0 && nodes[k] > v) {
+                nodes[k + 1] = nodes[k];
+                k--;
+            }
+            nodes[k + 1] = v;
+        }
+
+        for (uint8_t i = 0; i + 1 < n; i += 2) {
+            span(t, nodes[i], nodes[i + 1] - 1, y);
+        }
+    }
+}
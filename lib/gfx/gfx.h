@@ -0,0 +1,123 @@
+/**
+ * @file gfx.h
+ * @brief Device-independent shape rasterizers
+ *
+ * Lines, circles, ellipses, arcs and polygons rasterized onto any surface
+ * that can plot a pixel and fill a horizontal span. The SH1106 driver and
+ * the WS2812 matrix canvas share these through a gfx_target_t.
+ *
+ * Coordinates are signed and may lie off the surface. Clipping is decided
+ * once per primitive: shapes fully inside are plotted without per-pixel
+ * bounds checks, and callbacks only ever see on-surface coordinates.
+ */
+
+#ifndef GFX_H
+#define GFX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Maximum vertex count accepted by gfx_fill_polygon (bounds the per-row crossing list) */
+#define GFX_POLY_MAX_VERTICES 32
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Signed point; vertices may lie off the surface and are clipped */
+typedef struct {
+    int16_t x;
+    int16_t y;
+} gfx_point_t;
+
+/** Drawing surface: size plus pixel and span callbacks */
+typedef struct {
+    int16_t width;    ///< Surface width in pixels
+    int16_t height;   ///< Surface height in pixels
+
+    /** Set one pixel (always on-surface) */
+    void (*plot)(void *ctx, int16_t x, int16_t y);
+
+    /** Fill x0..x1 inclusive on row y (on-surface, x0 <= x1); NULL falls back to plot */
+    void (*span)(void *ctx, int16_t x0, int16_t x1, int16_t y);
+
+    /** Optional: called once per primitive with its clipped bounding box (e.g. dirty tracking) */
+    void (*bbox)(void *ctx, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+    void *ctx;        ///< Passed to the callbacks
+} gfx_target_t;
+
+// =============================================================================
+// Primitives
+// =============================================================================
+
+/**
+ * Line between two points (Cohen-Sutherland clip, then Bresenham)
+ */
+void gfx_line(const gfx_target_t *t, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/**
+ * Filled rectangle as one span per row
+ * @param t Target
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width
+ * @param h Height
+ */
+void gfx_fill_rect(const gfx_target_t *t, int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+/**
+ * Circle outline (midpoint algorithm)
+ */
+void gfx_circle(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r);
+
+/**
+ * Filled circle, one span per row
+ */
+void gfx_fill_circle(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r);
+
+/**
+ * Axis-aligned ellipse outline (midpoint algorithm)
+ */
+void gfx_ellipse(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry);
+
+/**
+ * Filled axis-aligned ellipse, one span per row
+ */
+void gfx_fill_ellipse(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry);
+
+/**
+ * Circular arc from start_deg to end_deg, clockwise on screen from 3 o'clock
+ * @param t Target
+ * @param cx Centre X
+ * @param cy Centre Y
+ * @param r Radius
+ * @param start_deg Start angle in degrees
+ * @param end_deg End angle in degrees (a sweep of 360 or more draws the full circle)
+ */
+void gfx_arc(const gfx_target_t *t, int16_t cx, int16_t cy, uint8_t r, int16_t start_deg, int16_t end_deg);
+
+/**
+ * Connected line segments through pts
+ * @param t Target
+ * @param pts Vertices
+ * @param count Number of vertices
+ * @param closed Join the last vertex back to the first
+ */
+void gfx_polyline(const gfx_target_t *t, const gfx_point_t *pts, uint8_t count, bool closed);
+
+/**
+ * Scanline polygon fill (even-odd rule, so concave and self-intersecting
+ * shapes work). Coverage is half-open on both axes, so polygons sharing an
+ * edge tile without overlap.
+ * @param t Target
+ * @param pts Vertices
+ * @param count Number of vertices (3..GFX_POLY_MAX_VERTICES)
+ */
+void gfx_fill_polygon(const gfx_target_t *t, const gfx_point_t *pts, uint8_t count);
+
+#endif // GFX_H
@@ -0,0 +1,148 @@
+#include "../lib.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/address_mapped.h"
+#include "hardware/structs/io_bank0.h"
+
+#define ALL_PINS_MASK ((1u << HW_GPIO_IRQ_NUM_PINS) - 1)
+#define ALL_EVENTS (GPIO_IRQ_LEVEL_LOW | GPIO_IRQ_LEVEL_HIGH | GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+// A pin's handler and context. Records are immutable while published: a
+// change is written into the pin's other record and swapped in whole.
+typedef struct {
+    hw_gpio_irq_handler_t handler;
+    void *ctx;
+} pin_record_t;
+
+// Published record per pin (NULL = free), read with one atomic load
+static const pin_record_t *slots[HW_GPIO_IRQ_NUM_PINS];
+
+// Two records per pin, alternated so the published one is never rewritten
+static pin_record_t records[HW_GPIO_IRQ_NUM_PINS][2];
+
+// Holds a pin between claiming it and publishing its first record; its NULL
+// handler makes the dispatcher skip the pin meanwhile
+static const pin_record_t claiming = {NULL, NULL};
+
+static bool dispatcher_installed = false;
+
+static inline const pin_record_t *load_slot(uint gpio) {
+    return __atomic_load_n(&slots[gpio], __ATOMIC_ACQUIRE);
+}
+
+static inline bool swap_slot(uint gpio, const pin_record_t *expected, const pin_record_t *desired) {
+    return __atomic_compare_exchange_n(&slots[gpio], &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// The pin's record that is not currently published
+static inline pin_record_t *spare_record(uint gpio, const pin_record_t *published) {
+    return (published == &records[gpio][0]) ? &records[gpio][1] : &records[gpio][0];
+}
+
+static inline io_bank0_irq_ctrl_hw_t *irq_ctrl(void) {
+    return get_core_num() ? &io_bank0_hw->proc1_irq_ctrl : &io_bank0_hw->proc0_irq_ctrl;
+}
+
+// Set a pin's enabled events without acknowledging anything: unlike
+// gpio_set_irq_enabled, edges already latched stay pending
+static void set_pin_events(uint gpio, uint32_t events) {
+    volatile uint32_t *inte = &irq_ctrl()->inte[gpio / 8];
+    uint shift = 4 * (gpio % 8);
+    hw_clear_bits(inte, (ALL_EVENTS & ~events) << shift);
+    hw_set_bits(inte, (events & ALL_EVENTS) << shift);
+}
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+static void __isr gpio_irq_dispatch(void) {
+    io_bank0_irq_ctrl_hw_t *ctrl = irq_ctrl();
+
+    // Each status register holds 4 event bits for each of 8 pins
+    for (uint reg = 0; reg < (HW_GPIO_IRQ_NUM_PINS + 7) / 8; reg++) {
+        uint32_t pending = ctrl->ints[reg];
+        if (!pending) continue;
+
+        // Clear every edge in this register at once (level bits ignore the write)
+        io_bank0_hw->intr[reg] = pending;
+
+        while (pending) {
+            uint shift = (__builtin_ctz(pending) / 4) * 4;
+            uint32_t events = (pending >> shift) & 0xF;
+            pending &= ~(0xFu << shift);
+
+            // One load gets a consistent handler and ctx, whatever the
+            // other core is registering
+            uint gpio = reg * 8 + shift / 4;
+            const pin_record_t *record = load_slot(gpio);
+            if (record && record->handler) {
+                record->handler(gpio, events, record->ctx);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Registration
+// =============================================================================
+
+hw_result_t hw_gpio_irq_register(uint gpio, uint32_t events, hw_gpio_irq_handler_t handler, void *ctx) {
+    if (gpio >= HW_GPIO_IRQ_NUM_PINS || !handler) {
+        return HW_INVALID_PARAM;
+    }
+
+    if (!dispatcher_installed) {
+        gpio_add_raw_irq_handler_masked(ALL_PINS_MASK, gpio_irq_dispatch);
+        irq_set_enabled(IO_IRQ_BANK0, true);
+        dispatcher_installed = true;
+    }
+
+    // Ownership is claimed by compare-and-swap on the slot, so two cores
+    // cannot both take a free pin; the context identifies the owner
+    for (;;) {
+        const pin_record_t *current = load_slot(gpio);
+
+        if (current == NULL) {
+            if (!swap_slot(gpio, NULL, &claiming)) continue;
+
+            // A new owner starts clean; its events go on once it is published
+            pin_record_t *record = spare_record(gpio, NULL);
+            record->handler = handler;
+            record->ctx = ctx;
+            gpio_acknowledge_irq(gpio, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+            __atomic_store_n(&slots[gpio], record, __ATOMIC_RELEASE);
+            set_pin_events(gpio, events);
+            return HW_OK;
+        }
+
+        if (current == &claiming || current->ctx != ctx) {
+            return HW_BUSY;
+        }
+
+        // Same owner: swap in a new record; pending edges stay latched
+        pin_record_t *record = spare_record(gpio, current);
+        record->handler = handler;
+        record->ctx = ctx;
+        if (!swap_slot(gpio, current, record)) continue;
+        set_pin_events(gpio, events);
+        return HW_OK;
+    }
+}
+
+void hw_gpio_irq_unregister(uint gpio, void *ctx) {
+    if (gpio >= HW_GPIO_IRQ_NUM_PINS) return;
+
+    const pin_record_t *current = load_slot(gpio);
+    if (!current || current == &claiming || current->ctx != ctx) return;
+
+    set_pin_events(gpio, 0);
+    swap_slot(gpio, current, NULL);
+}
+
+bool hw_gpio_irq_is_registered(uint gpio) {
+    if (gpio >= HW_GPIO_IRQ_NUM_PINS) return false;
+    const pin_record_t *record = load_slot(gpio);
+    return record && record->handler;
+}
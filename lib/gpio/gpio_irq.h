@@ -0,0 +1,87 @@
+/**
+ * @file gpio_irq.h
+ * @brief Shared GPIO interrupt dispatcher
+ *
+ * The SDK keeps one GPIO callback per core, so drivers that each call
+ * gpio_set_irq_enabled_with_callback replace one another's handler. This
+ * dispatcher owns the bank's interrupt instead: drivers register a handler
+ * and context per pin, and one raw interrupt handler reads each pending-
+ * events register once, acknowledges its edges in a single write and calls
+ * the handler of every pin that fired. Finding the owner of a pin is a
+ * table lookup rather than a search.
+ *
+ * Registration is lock-free. Each pin publishes an immutable handler and
+ * context record through one pointer, so the dispatcher takes no lock and
+ * does one atomic load per pin. Ownership is claimed by compare-and-swap on
+ * that pointer, so two cores cannot both take a free pin. A change is
+ * written into the pin's spare record and swapped in. Each pin has two
+ * records, so a dispatcher read is only torn if the pin changes twice
+ * within the few instructions between its load and its call.
+ *
+ * Register and unregister from the core that takes the interrupts: the
+ * events are enabled on the calling core. A handler already running on the
+ * other core may still complete after hw_gpio_irq_unregister returns.
+ *
+ * Once a pin is registered, the dispatcher serves every bank pin, so use it
+ * rather than gpio_set_irq_callback for all GPIO interrupts.
+ */
+
+#ifndef PICO_HW_GPIO_IRQ_H
+#define PICO_HW_GPIO_IRQ_H
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Pins served by the dispatcher (GPIO 0-29) */
+#define HW_GPIO_IRQ_NUM_PINS 30
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/**
+ * Pin interrupt handler (interrupt context)
+ * @param gpio Pin that fired
+ * @param events GPIO_IRQ_* events pending on the pin (already acknowledged)
+ * @param ctx Context given at registration (typically the driver instance)
+ */
+typedef void (*hw_gpio_irq_handler_t)(uint gpio, uint32_t events, void *ctx);
+
+// =============================================================================
+// API Functions
+// =============================================================================
+
+/**
+ * Route a pin's interrupts to a handler and enable them
+ *
+ * The context identifies the owner: registering again with the same context
+ * swaps the handler and events in place, without acknowledging or dropping
+ * edges already pending on the pin. A new owner starts with the pin's
+ * latched edges cleared.
+ *
+ * @param gpio Pin (0 to HW_GPIO_IRQ_NUM_PINS - 1)
+ * @param events GPIO_IRQ_* events to enable
+ * @param handler Handler
+ * @param ctx Passed to the handler
+ * @return HW_OK, HW_INVALID_PARAM on a bad pin or NULL handler, HW_BUSY if
+ *         another context owns the pin
+ */
+hw_result_t hw_gpio_irq_register(uint gpio, uint32_t events, hw_gpio_irq_handler_t handler, void *ctx);
+
+/**
+ * Disable a pin's interrupts and release it
+ * @param gpio Pin
+ * @param ctx Context it was registered with; no-op if the pin is free or
+ *            owned by another context
+ */
+void hw_gpio_irq_unregister(uint gpio, void *ctx);
+
+/**
+ * Check whether a pin has a handler
+ * @param gpio Pin
+ * @return true if registered
+ */
+bool hw_gpio_irq_is_registered(uint gpio);
+
+#endif // PICO_HW_GPIO_IRQ_H
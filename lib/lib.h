@@ -186,10 +186,21 @@ static inline hw_result_t hw_i2c_scan(i2c_inst_t *i2c, uint8_t *found_addrs, uin
 // =============================================================================
 
 // Include individual peripheral driver headers
+#include "math/fxp.h"
+#include "gfx/gfx.h"
+#include "gpio/gpio_irq.h"
+#include "event/event_queue.h"
 #include "button/button.h"
 #include "oled/sh1106.h"
+#include "oled/sh1106_font.h"
+#include "oled/sh1106_diff.h"
 #include "stepper/stepper_28byj48.h"
+#include "encoder/encoder_velocity.h"
 #include "encoder/encoder_ec11.h"
+#include "encoder/encoder_sampler.h"
 #include "rgb_led/ws2812.h"
+#include "rgb_led/led_effects.h"
+#include "rgb_led/led_matrix.h"
+#include "rgb_led/led_clip.h"
 
 #endif // PICO_HW_LIB_H
@@ -0,0 +1,155 @@
+/**
+ * @file fxp.c
+ * @brief Fixed-point trigonometry and 2D affine transforms
+ */
+
+#include "../lib.h"
+
+// =============================================================================
+// Private Data
+// =============================================================================
+
+// Quarter-wave sine, 256 steps over 0..90 degrees plus the endpoint:
+// round(32767 * sin(i * pi / 512)), i = 0..256
+static const int16_t sin_quarter[257] = {
+        0,   201,   402,   603,   804,  1005,  1206,  1407,
+     1608,  1809,  2009,  2210,  2410,  2611,  2811,  3012,
+     3212,  3412,  3612,  3811,  4011,  4210,  4410,  4609,
+     4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+     6393,  6590,  6786,  6983,  7179,  7375,  7571,  7767,
+     7962,  8157,  8351,  8545,  8739,  8933,  9126,  9319,
+     9512,  9704,  9896, 10087, 10278, 10469, 10659, 10849,
+    11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+    12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828,
+    14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+    15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673,
+    16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+    18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357,
+    19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+    20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+    22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+    23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143,
+    24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+    25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198,
+    26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+    27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001,
+    28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+    28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534,
+    29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+    30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783,
+    30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+    31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736,
+    31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+    32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382,
+    32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717,
+    32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+    32767,
+};
+
+// =============================================================================
+// Angle Conversion
+// =============================================================================
+
+fxp_angle_t fxp_angle_from_ratio(int32_t num, int32_t den) {
+    // Whole turns wrap, so only the remainder matters: |rem| < den
+    int32_t rem = num % den;
+    uint32_t u = (uint32_t)(rem < 0 ? -rem : rem);
+    uint32_t d = (uint32_t)den;
+
+    // Keep d below 2^24 so each step's shifted dividend fits in 32 bits
+    while (d >= (1u << 24)) {
+        d >>= 1;
+        u >>= 1;
+    }
+
+    // u * 65536 / d as two 8-bit long-division steps
+    uint32_t hi = (u << 8) / d;
+    uint32_t lo = (((u << 8) % d) << 8) / d;
+    uint32_t angle = (hi << 8) | lo;
+
+    return (fxp_angle_t)(rem < 0 ? -angle : angle);
+}
+
+// =============================================================================
+// Trigonometry
+// =============================================================================
+
+fxp_q15_t fxp_sin(fxp_angle_t angle) {
+    // Angle bits: [15:14] quadrant, [13:6] table index, [5:0] interpolation fraction
+    uint16_t quadrant = angle >> 14;
+    uint16_t pos = angle & 0x3FFF;
+    if (quadrant & 1) {
+        pos = FXP_ANGLE_QUARTER - pos;  // Mirror: 0..0x4000 inclusive
+    }
+
+    uint16_t index = pos >> 6;
+    int32_t frac = pos & 0x3F;
+    int32_t s0 = sin_quarter[index];
+    int32_t value = s0;
+    if (frac) {
+        value += ((sin_quarter[index + 1] - s0) * frac + 32) >> 6;
+    }
+
+    return (fxp_q15_t)((quadrant & 2) ? -value : value);
+}
+
+// =============================================================================
+// Affine Transforms
+// =============================================================================
+
+void fxp_affine_identity(fxp_affine_t *m) {
+    if (!m) return;
+
+    m->a = FXP_Q16_ONE;
+    m->b = 0;
+    m->tx = 0;
+    m->c = 0;
+    m->d = FXP_Q16_ONE;
+    m->ty = 0;
+}
+
+void fxp_affine_rotate_scale(fxp_affine_t *m, fxp_angle_t angle, int32_t scale, int16_t tx, int16_t ty) {
+    if (!m) return;
+
+    // Q15 * Q16.16 >> 15 = Q16.16; split the scale so the product stays in 32 bits
+    int32_t s = fxp_sin(angle);
+    int32_t c = fxp_cos(angle);
+    int32_t cs = c * (scale >> 15) + ((c * (scale & 0x7FFF)) >> 15);
+    int32_t ss = s * (scale >> 15) + ((s * (scale & 0x7FFF)) >> 15);
+
+    m->a = cs;
+    m->b = -ss;
+    m->tx = FXP_Q16(tx);
+    m->c = ss;
+    m->d = cs;
+    m->ty = FXP_Q16(ty);
+}
+
+// Q16.16 product with rounding
+static inline int32_t mul_q16(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b + (FXP_Q16_ONE / 2)) >> 16);
+}
+
+void fxp_affine_multiply(fxp_affine_t *out, const fxp_affine_t *outer, const fxp_affine_t *inner) {
+    if (!out || !outer || !inner) return;
+
+    fxp_affine_t r;
+    r.a = mul_q16(outer->a, inner->a) + mul_q16(outer->b, inner->c);
+    r.b = mul_q16(outer->a, inner->b) + mul_q16(outer->b, inner->d);
+    r.tx = mul_q16(outer->a, inner->tx) + mul_q16(outer->b, inner->ty) + outer->tx;
+    r.c = mul_q16(outer->c, inner->a) + mul_q16(outer->d, inner->c);
+    r.d = mul_q16(outer->c, inner->b) + mul_q16(outer->d, inner->d);
+    r.ty = mul_q16(outer->c, inner->tx) + mul_q16(outer->d, inner->ty) + outer->ty;
+    *out = r;
+}
+
+void fxp_affine_apply_points(const fxp_affine_t *m, const int16_t *in, int16_t *out, uint16_t count) {
+    if (!m || !in || !out) return;
+
+    for (uint16_t i = 0; i < count; i++) {
+        int16_t x = in[2 * i];
+        int16_t y = in[2 * i + 1];
+        fxp_affine_apply(m, x, y, &out[2 * i], &out[2 * i + 1]);
+    }
+}
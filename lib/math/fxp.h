@@ -0,0 +1,182 @@
+/**
+ * @file fxp.h
+ * @brief Fixed-point trigonometry and 2D affine transforms
+ *
+ * Integer replacements for the per-frame sinf/cosf calls used for rotated
+ * drawing. The RP2040 has no FPU, so soft-float trig costs hundreds of cycles
+ * per call; a table lookup with linear interpolation costs a few dozen.
+ *
+ * Angles are binary radians (fxp_angle_t): a full turn is 65536, so wrapping
+ * is free and any 16-bit value is a valid angle. Sine and cosine are Q15
+ * (32767 = 1.0). Transform coefficients are Q16.16.
+ */
+
+#ifndef FXP_H
+#define FXP_H
+
+#include <stdint.h>
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Binary-radian constants */
+#define FXP_ANGLE_FULL    65536UL  ///< One full turn (wraps to 0 in fxp_angle_t)
+#define FXP_ANGLE_HALF    0x8000   ///< 180 degrees
+#define FXP_ANGLE_QUARTER 0x4000   ///< 90 degrees
+
+/** Q15 unity (largest representable value; 1.0 exactly is not) */
+#define FXP_Q15_ONE 32767
+
+/** Q16.16 unity */
+#define FXP_Q16_ONE 65536
+
+/** Convert an integer to Q16.16 */
+#define FXP_Q16(n) ((int32_t)(n) * FXP_Q16_ONE)
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Angle in binary radians: 65536 per turn, wraps naturally */
+typedef uint16_t fxp_angle_t;
+
+/** Q15 fraction in [-1, 1) */
+typedef int16_t fxp_q15_t;
+
+/**
+ * 2x3 affine transform, Q16.16:
+ *   x' = a*x + b*y + tx
+ *   y' = c*x + d*y + ty
+ */
+typedef struct {
+    int32_t a, b, tx;
+    int32_t c, d, ty;
+} fxp_affine_t;
+
+// =============================================================================
+// Angle Conversion
+// =============================================================================
+
+/**
+ * Convert whole degrees to an angle (any integer, wraps)
+ * @param degrees Angle in degrees
+ * @return Angle in binary radians
+ */
+static inline fxp_angle_t fxp_angle_from_deg(int32_t degrees) {
+    return (fxp_angle_t)(((degrees % 360) * (int32_t)FXP_ANGLE_FULL) / 360);
+}
+
+/**
+ * Convert an angle to whole degrees, rounded to nearest
+ * @param angle Angle in binary radians
+ * @return Degrees in 0..359
+ */
+static inline uint16_t fxp_angle_to_deg(fxp_angle_t angle) {
+    return (uint16_t)((((uint32_t)angle * 360) + (FXP_ANGLE_FULL / 2)) / FXP_ANGLE_FULL) % 360;
+}
+
+/**
+ * Convert a fraction of a turn to an angle (e.g. counts / counts-per-rev).
+ * Uses only 32-bit divides; exact (truncated toward zero) for den < 2^24.
+ * @param num Numerator (any sign; whole turns wrap)
+ * @param den Counts per full turn (must be > 0)
+ * @return Angle in binary radians
+ */
+fxp_angle_t fxp_angle_from_ratio(int32_t num, int32_t den);
+
+/**
+ * Convert an angle to a count in 0..den-1 (inverse of fxp_angle_from_ratio)
+ * @param angle Angle in binary radians
+ * @param den Counts per full turn (1..65535)
+ * @return Count, rounded to nearest
+ */
+static inline int32_t fxp_angle_to_ratio(fxp_angle_t angle, int32_t den) {
+    return (int32_t)((((uint32_t)angle * (uint32_t)den) + (FXP_ANGLE_FULL / 2)) / FXP_ANGLE_FULL) % den;
+}
+
+// =============================================================================
+// Trigonometry
+// =============================================================================
+
+/**
+ * Sine of an angle (quarter-wave table with linear interpolation, error < 1 LSB)
+ * @param angle Angle in binary radians
+ * @return sin(angle) in Q15
+ */
+fxp_q15_t fxp_sin(fxp_angle_t angle);
+
+/**
+ * Cosine of an angle
+ * @param angle Angle in binary radians
+ * @return cos(angle) in Q15
+ */
+static inline fxp_q15_t fxp_cos(fxp_angle_t angle) {
+    return fxp_sin((fxp_angle_t)(angle + FXP_ANGLE_QUARTER));
+}
+
+/**
+ * Multiply an integer by a Q15 fraction, rounded to nearest (32-bit multiply)
+ * @param value Integer value, |value| < 65536
+ * @param frac Q15 fraction
+ * @return value * frac
+ */
+static inline int32_t fxp_mul_q15(int32_t value, fxp_q15_t frac) {
+    return (value * frac + (1 << 14)) >> 15;
+}
+
+// =============================================================================
+// Affine Transforms
+// =============================================================================
+
+/**
+ * Set to the identity transform
+ * @param m Transform to initialize
+ */
+void fxp_affine_identity(fxp_affine_t *m);
+
+/**
+ * Set to rotate about the origin, scale, then translate: the usual
+ * "draw this shape rotated at (tx, ty)" transform in one call.
+ * @param m Transform to initialize
+ * @param angle Rotation (positive is clockwise on screen, y pointing down)
+ * @param scale Uniform scale in Q16.16 (FXP_Q16_ONE for none)
+ * @param tx Translation X in pixels
+ * @param ty Translation Y in pixels
+ */
+void fxp_affine_rotate_scale(fxp_affine_t *m, fxp_angle_t angle, int32_t scale, int16_t tx, int16_t ty);
+
+/**
+ * Compose two transforms: out = outer * inner (inner is applied first).
+ * out may alias either input.
+ * @param out Result
+ * @param outer Transform applied second
+ * @param inner Transform applied first
+ */
+void fxp_affine_multiply(fxp_affine_t *out, const fxp_affine_t *outer, const fxp_affine_t *inner);
+
+/**
+ * Transform a point, rounding to the nearest pixel. Arithmetic is 32-bit, so
+ * input coordinates times the scale must stay below 16384 in magnitude.
+ * @param m Transform
+ * @param x Input X
+ * @param y Input Y
+ * @param out_x Output X
+ * @param out_y Output Y
+ */
+static inline void fxp_affine_apply(const fxp_affine_t *m, int16_t x, int16_t y,
+                                    int16_t *out_x, int16_t *out_y) {
+    *out_x = (int16_t)((m->a * x + m->b * y + m->tx + (FXP_Q16_ONE / 2)) >> 16);
+    *out_y = (int16_t)((m->c * x + m->d * y + m->ty + (FXP_Q16_ONE / 2)) >> 16);
+}
+
+/**
+ * Transform an array of interleaved x,y pairs (e.g. sh1106_point_t[])
+ * @param m Transform
+ * @param in Input points as x0, y0, x1, y1, ...
+ * @param out Output points (may equal in)
+ * @param count Number of points
+ */
+void fxp_affine_apply_points(const fxp_affine_t *m, const int16_t *in, int16_t *out, uint16_t count);
+
+#endif // FXP_H
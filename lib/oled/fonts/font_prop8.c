@@ -0,0 +1,208 @@
+// Generated by tools/bdf2font.py from prop8.bdf - do not edit.
+// 95 glyphs, 8px high, 419 bitmap bytes
+
+#include "../../lib.h"
+
+static const uint8_t sh1106_font_prop8_bitmap[] = {
+    0x5F, // !
+    0x07, 0x00, 0x07, // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14, // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, // %
+    0x36, 0x49, 0x55, 0x22, 0x50, // &
+    0x05, 0x03, // quote
+    0x1C, 0x22, 0x41, // (
+    0x41, 0x22, 0x1C, // )
+    0x14, 0x08, 0x3E, 0x08, 0x14, // *
+    0x08, 0x08, 0x3E, 0x08, 0x08, // +
+    0x50, 0x30, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, // -
+    0x60, 0x60, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E, // 0
+    0x42, 0x7F, 0x40, // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, // 2
+    0x21, 0x41, 0x45, 0x4B, 0x31, // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10, // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30, // 6
+    0x01, 0x71, 0x09, 0x05, 0x03, // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E, // 9
+    0x36, 0x36, // :
+    0x56, 0x36, // ;
+    0x08, 0x14, 0x22, 0x41, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, // =
+    0x41, 0x22, 0x14, 0x08, // >
+    0x02, 0x01, 0x51, 0x09, 0x06, // ?
+    0x32, 0x49, 0x79, 0x41, 0x3E, // @
+    0x7E, 0x11, 0x11, 0x11, 0x7E, // A
+    0x7F, 0x49, 0x49, 0x49, 0x36, // B
+    0x3E, 0x41, 0x41, 0x41, 0x22, // C
+    0x7F, 0x41, 0x41, 0x22, 0x1C, // D
+    0x7F, 0x49, 0x49, 0x49, 0x41, // E
+    0x7F, 0x09, 0x09, 0x09, 0x01, // F
+    0x3E, 0x41, 0x49, 0x49, 0x7A, // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F, // H
+    0x41, 0x7F, 0x41, // I
+    0x20, 0x40, 0x41, 0x3F, 0x01, // J
+    0x7F, 0x08, 0x14, 0x22, 0x41, // K
+    0x7F, 0x40, 0x40, 0x40, 0x40, // L
+    0x7F, 0x02, 0x0C, 0x02, 0x7F, // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F, // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E, // O
+    0x7F, 0x09, 0x09, 0x09, 0x06, // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E, // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46, // R
+    0x46, 0x49, 0x49, 0x49, 0x31, // S
+    0x01, 0x01, 0x7F, 0x01, 0x01, // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F, // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F, // V
+    0x3F, 0x40, 0x38, 0x40, 0x3F, // W
+    0x63, 0x14, 0x08, 0x14, 0x63, // X
+    0x07, 0x08, 0x70, 0x08, 0x07, // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, // Z
+    0x7F, 0x41, 0x41, // [
+    0x02, 0x04, 0x08, 0x10, 0x20, // backslash
+    0x41, 0x41, 0x7F, // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, // _
+    0x01, 0x02, 0x04, // `
+    0x20, 0x54, 0x54, 0x54, 0x78, // a
+    0x7F, 0x48, 0x44, 0x44, 0x38, // b
+    0x38, 0x44, 0x44, 0x44, 0x20, // c
+    0x38, 0x44, 0x44, 0x48, 0x7F, // d
+    0x38, 0x54, 0x54, 0x54, 0x18, // e
+    0x08, 0x7E, 0x09, 0x01, 0x02, // f
+    0x0C, 0x52, 0x52, 0x52, 0x3E, // g
+    0x7F, 0x08, 0x04, 0x04, 0x78, // h
+    0x44, 0x7D, 0x40, // i
+    0x20, 0x40, 0x44, 0x3D, // j
+    0x7F, 0x10, 0x28, 0x44, // k
+    0x41, 0x7F, 0x40, // l
+    0x7C, 0x04, 0x18, 0x04, 0x78, // m
+    0x7C, 0x08, 0x04, 0x04, 0x78, // n
+    0x38, 0x44, 0x44, 0x44, 0x38, // o
+    0x7C, 0x14, 0x14, 0x14, 0x08, // p
+    0x08, 0x14, 0x14, 0x18, 0x7C, // q
+    0x7C, 0x08, 0x04, 0x04, 0x08, // r
+    0x48, 0x54, 0x54, 0x54, 0x20, // s
+    0x04, 0x3F, 0x44, 0x40, 0x20, // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C, // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C, // v
+    0x3C, 0x40, 0x30, 0x40, 0x3C, // w
+    0x44, 0x28, 0x10, 0x28, 0x44, // x
+    0x0C, 0x50, 0x50, 0x50, 0x3C, // y
+    0x44, 0x64, 0x54, 0x4C, 0x44, // z
+    0x08, 0x36, 0x41, // {
+    0x7F, // |
+    0x41, 0x36, 0x08, // }
+    0x10, 0x08, 0x08, 0x10, 0x08, // ~
+};
+
+static const sh1106_glyph_t sh1106_font_prop8_glyphs[] = {
+    {    0,  0,  3}, //  
+    {    0,  1,  2}, // !
+    {    1,  3,  4}, // "
+    {    4,  5,  6}, // #
+    {    9,  5,  6}, // $
+    {   14,  5,  6}, // %
+    {   19,  5,  6}, // &
+    {   24,  2,  3}, // quote
+    {   26,  3,  4}, // (
+    {   29,  3,  4}, // )
+    {   32,  5,  6}, // *
+    {   37,  5,  6}, // +
+    {   42,  2,  3}, // ,
+    {   44,  5,  6}, // -
+    {   49,  2,  3}, // .
+    {   51,  5,  6}, // /
+    {   56,  5,  6}, // 0
+    {   61,  3,  4}, // 1
+    {   64,  5,  6}, // 2
+    {   69,  5,  6}, // 3
+    {   74,  5,  6}, // 4
+    {   79,  5,  6}, // 5
+    {   84,  5,  6}, // 6
+    {   89,  5,  6}, // 7
+    {   94,  5,  6}, // 8
+    {   99,  5,  6}, // 9
+    {  104,  2,  3}, // :
+    {  106,  2,  3}, // ;
+    {  108,  4,  5}, // <
+    {  112,  5,  6}, // =
+    {  117,  4,  5}, // >
+    {  121,  5,  6}, // ?
+    {  126,  5,  6}, // @
+    {  131,  5,  6}, // A
+    {  136,  5,  6}, // B
+    {  141,  5,  6}, // C
+    {  146,  5,  6}, // D
+    {  151,  5,  6}, // E
+    {  156,  5,  6}, // F
+    {  161,  5,  6}, // G
+    {  166,  5,  6}, // H
+    {  171,  3,  4}, // I
+    {  174,  5,  6}, // J
+    {  179,  5,  6}, // K
+    {  184,  5,  6}, // L
+    {  189,  5,  6}, // M
+    {  194,  5,  6}, // N
+    {  199,  5,  6}, // O
+    {  204,  5,  6}, // P
+    {  209,  5,  6}, // Q
+    {  214,  5,  6}, // R
+    {  219,  5,  6}, // S
+    {  224,  5,  6}, // T
+    {  229,  5,  6}, // U
+    {  234,  5,  6}, // V
+    {  239,  5,  6}, // W
+    {  244,  5,  6}, // X
+    {  249,  5,  6}, // Y
+    {  254,  5,  6}, // Z
+    {  259,  3,  4}, // [
+    {  262,  5,  6}, // backslash
+    {  267,  3,  4}, // ]
+    {  270,  5,  6}, // ^
+    {  275,  5,  6}, // _
+    {  280,  3,  4}, // `
+    {  283,  5,  6}, // a
+    {  288,  5,  6}, // b
+    {  293,  5,  6}, // c
+    {  298,  5,  6}, // d
+    {  303,  5,  6}, // e
+    {  308,  5,  6}, // f
+    {  313,  5,  6}, // g
+    {  318,  5,  6}, // h
+    {  323,  3,  4}, // i
+    {  326,  4,  5}, // j
+    {  330,  4,  5}, // k
+    {  334,  3,  4}, // l
+    {  337,  5,  6}, // m
+    {  342,  5,  6}, // n
+    {  347,  5,  6}, // o
+    {  352,  5,  6}, // p
+    {  357,  5,  6}, // q
+    {  362,  5,  6}, // r
+    {  367,  5,  6}, // s
+    {  372,  5,  6}, // t
+    {  377,  5,  6}, // u
+    {  382,  5,  6}, // v
+    {  387,  5,  6}, // w
+    {  392,  5,  6}, // x
+    {  397,  5,  6}, // y
+    {  402,  5,  6}, // z
+    {  407,  3,  4}, // {
+    {  410,  1,  2}, // |
+    {  411,  3,  4}, // }
+    {  414,  5,  6}, // ~
+};
+
+const sh1106_font_t sh1106_font_prop8 = {
+    .bitmap = sh1106_font_prop8_bitmap,
+    .glyphs = sh1106_font_prop8_glyphs,
+    .first = 32,
+    .last = 126,
+    .fallback = 63,
+    .height = 8,
+};
@@ -0,0 +1,59 @@
+// Generated by tools/bdf2font.py from seg24.bdf - do not edit.
+// 27 glyphs, 24px high, 408 bitmap bytes
+
+#include "../../lib.h"
+
+static const uint8_t sh1106_font_seg24_bitmap[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0, // .
+    0xFE, 0xFE, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, // 1
+    0x00, 0x00, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0xF0, 0xF0, 0xFC, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x0F, 0x0F, 0x7F, 0x7F, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0x00, 0x00, // 2
+    0x00, 0x00, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 3
+    0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x0F, 0x0F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, // 4
+    0xFE, 0xFE, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x00, 0x00, 0x0F, 0x0F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFC, 0xF0, 0xF0, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 5
+    0xFE, 0xFE, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFC, 0xF0, 0xF0, 0x7F, 0x7F, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 6
+    0x00, 0x00, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, // 7
+    0xFE, 0xFE, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 8
+    0xFE, 0xFE, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFE, 0xFE, 0x0F, 0x0F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0x7F, 0x7F, // 9
+    0xC0, 0xC0, 0xC0, 0x81, 0x81, 0x81, 0x03, 0x03, 0x03, // :
+};
+
+static const sh1106_glyph_t sh1106_font_seg24_glyphs[] = {
+    {    0,  0, 14}, //  
+    {    0,  0, 14}, // !
+    {    0,  0, 14}, // "
+    {    0,  0, 14}, // #
+    {    0,  0, 14}, // $
+    {    0,  0, 14}, // %
+    {    0,  0, 14}, // &
+    {    0,  0, 14}, // quote
+    {    0,  0, 14}, // (
+    {    0,  0, 14}, // )
+    {    0,  0, 14}, // *
+    {    0,  0, 14}, // +
+    {    0,  0, 14}, // ,
+    {    0, 10, 14}, // -
+    {   30,  3,  5}, // .
+    {    0,  0, 14}, // /
+    {   39, 12, 14}, // 0
+    {   75, 12, 14}, // 1
+    {  111, 12, 14}, // 2
+    {  147, 12, 14}, // 3
+    {  183, 12, 14}, // 4
+    {  219, 12, 14}, // 5
+    {  255, 12, 14}, // 6
+    {  291, 12, 14}, // 7
+    {  327, 12, 14}, // 8
+    {  363, 12, 14}, // 9
+    {  399,  3,  5}, // :
+};
+
+const sh1106_font_t sh1106_font_seg24 = {
+    .bitmap = sh1106_font_seg24_bitmap,
+    .glyphs = sh1106_font_seg24_glyphs,
+    .first = 32,
+    .last = 58,
+    .fallback = 32,
+    .height = 24,
+};
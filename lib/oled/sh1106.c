@@ -1,4 +1,7 @@
 #include "../lib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -102,12 +105,40 @@ static const uint8_t font5x7[][5] = {
     {0x78, 0x46, 0x41, 0x46, 0x78}  // DEL
 };
 
+// Async contexts for DMA IRQ access (one per I2C instance)
+#define MAX_ASYNC_DISPLAYS 2
+static sh1106_t *async_instances[MAX_ASYNC_DISPLAYS] = {NULL};
+static bool dma_irq_installed = false;
+static bool i2c_irq_installed[2] = {false, false};
+
+// Mark a page as matching the panel contents
+static inline void mark_page_clean(sh1106_t *display, uint8_t page) {
+    display->dirty_x0[page] = 0xFF;
+    display->dirty_x1[page] = 0;
+}
+
+// Widen a page's dirty range to include columns x0..x1 (inclusive, pre-clipped)
+static inline void extend_dirty(sh1106_t *display, uint8_t page, uint8_t x0, uint8_t x1) {
+    if (x0 < display->dirty_x0[page]) display->dirty_x0[page] = x0;
+    if (x1 > display->dirty_x1[page]) display->dirty_x1[page] = x1;
+}
+
+// Send several commands in one transaction (single control byte, then command bytes)
+hw_result_t sh1106_command_list(sh1106_t *display, const uint8_t *cmds, uint8_t len) {
+    if (len == 0 || len > SH1106_CMD_LIST_MAX) return HW_INVALID_PARAM;
+    if (sh1106_update_busy(display)) return HW_BUSY;
+
+    // Use 0x00 control byte - confirmed working with your display
+    uint8_t data[1 + SH1106_CMD_LIST_MAX];
+    data[0] = SH1106_CTRL_CMD_STREAM;
+    memcpy(&data[1], cmds, len);
+    int ret = i2c_write_timeout_us(display->i2c, display->addr, data, 1 + len, false, SH1106_I2C_TIMEOUT_US);
+    return (ret == 1 + len) ? HW_OK : HW_ERROR;
+}
+
 // Send command to display
 hw_result_t sh1106_command(sh1106_t *display, uint8_t cmd) {
-    // Use 0x00 control byte - confirmed working with your display
-    uint8_t data[2] = {0x00, cmd};
-    int ret = i2c_write_timeout_us(display->i2c, display->addr, data, 2, false, SH1106_I2C_TIMEOUT_US);
-    return (ret == 2) ? HW_OK : HW_ERROR;
+    return sh1106_command_list(display, &cmd, 1);
 }
 
 // Initialize the display
@@ -115,6 +146,12 @@ hw_result_t sh1106_init(sh1106_t *display, i2c_inst_t *i2c, uint8_t addr, uint8_
     // Store configuration
     display->i2c = i2c;
     display->addr = addr;
+    display->async = NULL;
+    display->start_line = 0;
+    display->start_line_pending = false;
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        mark_page_clean(display, page);
+    }
     
     // Initialize I2C
     i2c_init(i2c, SH1106_I2C_FREQ);
@@ -135,77 +172,47 @@ hw_result_t sh1106_init(sh1106_t *display, i2c_inst_t *i2c, uint8_t addr, uint8_
     // Initialize display with correct command sequence
     // IMPORTANT: This display requires SSD1306-style charge pump commands (0x8D/0x14)
     // even though it's labeled as SH1106. This is critical for power-on reliability.
+    static const uint8_t init_timing[] = {
+        SH1106_CMD_SET_DISPLAY_CLOCK, 0x80,     // Clock divide ratio/oscillator frequency
+        SH1106_CMD_SET_MULTIPLEX, 0x3F,         // Multiplex ratio: 64 lines
+        SH1106_CMD_SET_DISPLAY_OFFSET, 0x00,    // No display offset
+        SH1106_CMD_SET_START_LINE | 0,          // Start line 0
+        // CRITICAL: Enable charge pump using SSD1306 commands
+        // This module requires these specific commands to work after power cycle
+        SSD1306_CMD_CHARGE_PUMP, SSD1306_CHARGE_PUMP_ENABLE,
+    };
+    static const uint8_t init_panel[] = {
+        SH1106_CMD_SET_SEGMENT_REMAP | 0x01,    // Column address 127 mapped to SEG0
+        SH1106_CMD_SET_COM_SCAN_DIR | 0x08,     // COM output scan direction (remapped mode)
+        SH1106_CMD_SET_COM_PINS, 0x12,          // COM pins hardware configuration
+        SH1106_CMD_SET_CONTRAST, 0xFF,          // Maximum contrast
+        SH1106_CMD_SET_PRECHARGE, 0xF1,         // Pre-charge period
+        SH1106_CMD_SET_VCOM_DESELECT, 0x40,     // VCOMH deselect level
+        SH1106_CMD_RESUME_FROM_RAM,             // Display RAM content
+        SH1106_CMD_SET_NORMAL_DISPLAY,          // Normal display mode (not inverted)
+    };
     
     // Display off
-    uint8_t cmd_off[2] = {0x00, 0xAE};
-    i2c_write_blocking(display->i2c, display->addr, cmd_off, 2, false);
+    if (sh1106_command(display, SH1106_CMD_DISPLAY_OFF) != HW_OK) {
+        return HW_ERROR;
+    }
     sleep_ms(10);
     
-    // Set display clock divide ratio/oscillator frequency
-    uint8_t clock[3] = {0x00, 0xD5, 0x80};
-    i2c_write_blocking(display->i2c, display->addr, clock, 3, false);
-    
-    // Set multiplex ratio (1 to 64)
-    uint8_t mux[3] = {0x00, 0xA8, 0x3F};  // 64 lines
-    i2c_write_blocking(display->i2c, display->addr, mux, 3, false);
-    
-    // Set display offset
-    uint8_t offset[3] = {0x00, 0xD3, 0x00};
-    i2c_write_blocking(display->i2c, display->addr, offset, 3, false);
-    
-    // Set start line address
-    uint8_t startline[2] = {0x00, 0x40};
-    i2c_write_blocking(display->i2c, display->addr, startline, 2, false);
-    
-    // CRITICAL: Enable charge pump using SSD1306 commands
-    // This module requires these specific commands to work after power cycle
-    uint8_t pump_cmd[2] = {0x00, 0x8D};  // Charge pump command
-    i2c_write_blocking(display->i2c, display->addr, pump_cmd, 2, false);
-    uint8_t pump_enable[2] = {0x00, 0x14};  // Enable charge pump
-    i2c_write_blocking(display->i2c, display->addr, pump_enable, 2, false);
+    if (sh1106_command_list(display, init_timing, sizeof(init_timing)) != HW_OK) {
+        return HW_ERROR;
+    }
     sleep_ms(100);  // Wait for charge pump to stabilize
     
-    // Set segment remap (column address 127 mapped to SEG0)
-    uint8_t remap[2] = {0x00, 0xA1};
-    i2c_write_blocking(display->i2c, display->addr, remap, 2, false);
-    
-    // Set COM output scan direction (remapped mode)
-    uint8_t comscan[2] = {0x00, 0xC8};
-    i2c_write_blocking(display->i2c, display->addr, comscan, 2, false);
-    
-    // Set COM pins hardware configuration
-    uint8_t compins[3] = {0x00, 0xDA, 0x12};
-    i2c_write_blocking(display->i2c, display->addr, compins, 3, false);
-    
-    // Set contrast control
-    uint8_t contrast[3] = {0x00, 0x81, 0xFF};  // Maximum contrast
-    i2c_write_blocking(display->i2c, display->addr, contrast, 3, false);
-    
-    // Set pre-charge period
-    uint8_t precharge[3] = {0x00, 0xD9, 0xF1};
-    i2c_write_blocking(display->i2c, display->addr, precharge, 3, false);
-    
-    // Set VCOMH deselect level
-    uint8_t vcomh[3] = {0x00, 0xDB, 0x40};
-    i2c_write_blocking(display->i2c, display->addr, vcomh, 3, false);
-    
-    // Display RAM content (resume from RAM)
-    uint8_t resume[2] = {0x00, 0xA4};
-    i2c_write_blocking(display->i2c, display->addr, resume, 2, false);
-    
-    // Normal display mode (not inverted)
-    uint8_t normal[2] = {0x00, 0xA6};
-    i2c_write_blocking(display->i2c, display->addr, normal, 2, false);
+    if (sh1106_command_list(display, init_panel, sizeof(init_panel)) != HW_OK) {
+        return HW_ERROR;
+    }
     
     // Clear the buffer
     sh1106_clear(display);
     sh1106_update(display);
     
     // Turn on display
-    uint8_t cmd_on[2] = {0x00, 0xAF};
-    i2c_write_blocking(display->i2c, display->addr, cmd_on, 2, false);
-    
-    return HW_OK;
+    return sh1106_command(display, SH1106_CMD_DISPLAY_ON);
 }
 
 // Turn display on or off
@@ -225,65 +232,172 @@ hw_result_t sh1106_invert(sh1106_t *display, bool invert) {
 
 // Set display contrast
 hw_result_t sh1106_set_contrast(sh1106_t *display, uint8_t contrast) {
-    hw_result_t ret = sh1106_command(display, SH1106_CMD_SET_CONTRAST);
-    if (ret != HW_OK) return ret;
-    return sh1106_command(display, contrast);
+    uint8_t cmds[2] = {SH1106_CMD_SET_CONTRAST, contrast};
+    return sh1106_command_list(display, cmds, sizeof(cmds));
 }
 
 // Clear the display buffer
 void sh1106_clear(sh1106_t *display) {
+    // Only columns that actually held lit pixels need to be resent
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        const uint8_t *row = &display->buffer[page * SH1106_WIDTH];
+        int first = 0;
+        int last = SH1106_WIDTH - 1;
+        while (first <= last && row[first] == 0) first++;
+        while (last >= first && row[last] == 0) last--;
+        if (first <= last) {
+            extend_dirty(display, page, first, last);
+        }
+    }
     memset(display->buffer, 0, sizeof(display->buffer));
 }
 
-// Update the display with buffer contents (chunked writes for compatibility)
-hw_result_t sh1106_update(sh1106_t *display) {
-    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
-        // Set page address
-        if (sh1106_command(display, SH1106_CMD_SET_PAGE_ADDR | page) != HW_OK) {
+// Write columns x..x+len-1 of one page to the panel (chunked writes for compatibility)
+hw_result_t sh1106_write_span(sh1106_t *display, uint8_t page, uint8_t x, uint8_t len) {
+    if (page >= SH1106_PAGES || x >= SH1106_WIDTH || len > SH1106_WIDTH - x) return HW_INVALID_PARAM;
+
+    // Set page address and column start in one transaction
+    // (column offset: many SH1106 modules use 2)
+    uint8_t col = x + SH1106_COL_OFFSET;
+    uint8_t cmds[3] = {
+        SH1106_CMD_SET_PAGE_ADDR | page,
+        SH1106_CMD_SET_COLUMN_ADDR_HIGH | ((col >> 4) & 0x0F),
+        SH1106_CMD_SET_COLUMN_ADDR_LOW | (col & 0x0F),
+    };
+    if (sh1106_command_list(display, cmds, sizeof(cmds)) != HW_OK) {
+        return HW_ERROR;
+    }
+
+    // Write page data in small chunks
+    const uint8_t *src = &display->buffer[page * SH1106_WIDTH + x];
+    while (len > 0) {
+        uint8_t n = (len < SH1106_WRITE_CHUNK) ? len : SH1106_WRITE_CHUNK;
+        uint8_t data[1 + SH1106_WRITE_CHUNK];
+        data[0] = SH1106_CTRL_DATA_STREAM;  // Data control byte
+        memcpy(&data[1], src, n);
+
+        int ret = i2c_write_timeout_us(display->i2c, display->addr, data, 1 + n, false, SH1106_I2C_TIMEOUT_US);
+        if (ret != (1 + n)) {
             return HW_ERROR;
         }
+        src += n;
+        len -= n;
+    }
+    return HW_OK;
+}
+
+// Apply a queued start line change once the scrolled-in band has been sent
+static hw_result_t flush_start_line(sh1106_t *display) {
+    if (!display->start_line_pending) return HW_OK;
+    if (sh1106_command(display, SH1106_CMD_SET_START_LINE | display->start_line) != HW_OK) {
+        return HW_ERROR;
+    }
+    display->start_line_pending = false;
+    return HW_OK;
+}
 
-        // Set column start based on offset (many SH1106 modules use 2)
-        if (sh1106_command(display, SH1106_CMD_SET_COLUMN_ADDR_HIGH | ((SH1106_COL_OFFSET >> 4) & 0x0F)) != HW_OK) {
+// Update the display with buffer contents
+hw_result_t sh1106_update(sh1106_t *display) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        if (sh1106_write_span(display, page, 0, SH1106_WIDTH) != HW_OK) {
             return HW_ERROR;
         }
-        if (sh1106_command(display, SH1106_CMD_SET_COLUMN_ADDR_LOW | (SH1106_COL_OFFSET & 0x0F)) != HW_OK) {
+        mark_page_clean(display, page);
+    }
+    return flush_start_line(display);
+}
+
+// Update only the column spans modified since the last update
+hw_result_t sh1106_update_dirty(sh1106_t *display) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        uint8_t x0 = display->dirty_x0[page];
+        uint8_t x1 = display->dirty_x1[page];
+        if (x0 > x1) continue;
+
+        // Leave the page dirty on failure so the next call retries it
+        if (sh1106_write_span(display, page, x0, x1 - x0 + 1) != HW_OK) {
             return HW_ERROR;
         }
+        mark_page_clean(display, page);
+    }
+    return flush_start_line(display);
+}
 
-        // Write page data in small chunks (16 bytes)
-        const uint8_t chunk = 16;
-        for (uint8_t x = 0; x < SH1106_WIDTH; x += chunk) {
-            uint8_t len = (x + chunk <= SH1106_WIDTH) ? chunk : (SH1106_WIDTH - x);
-            uint8_t data[1 + 16];
-            data[0] = SH1106_CTRL_DATA_STREAM;  // Data control byte
-            memcpy(&data[1], &display->buffer[page * SH1106_WIDTH + x], len);
-            
-            int ret = i2c_write_timeout_us(display->i2c, display->addr, data, 1 + len, false, SH1106_I2C_TIMEOUT_US);
-            if (ret != (1 + len)) {
-                return HW_ERROR;
-            }
-        }
+// Set the RAM row shown at the top of the panel
+hw_result_t sh1106_set_start_line(sh1106_t *display, uint8_t line) {
+    display->start_line = line % SH1106_HEIGHT;
+    display->start_line_pending = true;
+    return flush_start_line(display);
+}
+
+// Hardware scroll: move content up by rows and clear the band that scrolls in
+// at the bottom (the RAM rows leaving the top). The start line change is sent
+// by the next update, after the redrawn band, so stale rows never show.
+void sh1106_scroll_up(sh1106_t *display, uint8_t rows) {
+    rows %= SH1106_HEIGHT;
+    if (rows == 0) return;
+
+    uint8_t band = display->start_line;
+    uint8_t first = MIN(rows, SH1106_HEIGHT - band);
+    sh1106_fill_rect(display, 0, band, SH1106_WIDTH, first, false);
+    if (first < rows) {
+        sh1106_fill_rect(display, 0, 0, SH1106_WIDTH, rows - first, false);
+    }
+
+    display->start_line = (band + rows) % SH1106_HEIGHT;
+    display->start_line_pending = true;
+}
+
+// Force columns x0..x1 of a page to be resent on the next partial update
+void sh1106_mark_dirty(sh1106_t *display, uint8_t page, uint8_t x0, uint8_t x1) {
+    if (page >= SH1106_PAGES || x0 > x1 || x0 >= SH1106_WIDTH) return;
+    if (x1 >= SH1106_WIDTH) x1 = SH1106_WIDTH - 1;
+    extend_dirty(display, page, x0, x1);
+}
+
+// Mark the whole buffer as matching the panel
+void sh1106_mark_clean(sh1106_t *display) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        mark_page_clean(display, page);
     }
-    return HW_OK;
+}
+
+// Check whether any page has pending changes
+bool sh1106_is_dirty(const sh1106_t *display) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        if (display->dirty_x0[page] <= display->dirty_x1[page]) return true;
+    }
+    return false;
 }
 
 // Set a pixel in the buffer
 void sh1106_set_pixel(sh1106_t *display, uint8_t x, uint8_t y, bool on) {
     if (x >= SH1106_WIDTH || y >= SH1106_HEIGHT) return;
     
-    uint16_t index = (y / 8) * SH1106_WIDTH + x;
+    uint8_t page = y / 8;
+    uint16_t index = page * SH1106_WIDTH + x;
     uint8_t bit = y % 8;
+    uint8_t old = display->buffer[index];
+    uint8_t val = on ? (old | (1 << bit)) : (old & ~(1 << bit));
     
-    if (on) {
-        display->buffer[index] |= (1 << bit);
-    } else {
-        display->buffer[index] &= ~(1 << bit);
+    if (val != old) {
+        display->buffer[index] = val;
+        extend_dirty(display, page, x, x);
     }
 }
 
 // Draw a line using Bresenham's algorithm
 void sh1106_draw_line(sh1106_t *display, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool on) {
+    // Axis-aligned lines go through the span kernels
+    if (y0 == y1) {
+        sh1106_draw_hline(display, MIN(x0, x1), y0, abs(x1 - x0) + 1, on);
+        return;
+    }
+    if (x0 == x1) {
+        sh1106_draw_vline(display, x0, MIN(y0, y1), abs(y1 - y0) + 1, on);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
     int sx = x0 < x1 ? 1 : -1;
@@ -307,45 +421,214 @@ void sh1106_draw_line(sh1106_t *display, uint8_t x0, uint8_t y0, uint8_t x1, uin
     }
 }
 
+// =============================================================================
+// Span kernels (operate directly on the page-major buffer)
+// =============================================================================
+
+// 32-bit view of the byte buffer for word-wide fills
+typedef uint32_t __attribute__((may_alias)) sh1106_word_t;
+
+// Set (on) or clear the mask bits in len consecutive bytes of one page
+static void page_fill(uint8_t *dst, uint8_t len, uint8_t mask, bool on) {
+    // Byte-wise until word aligned (buffer[] itself is not word aligned)
+    while (len > 0 && ((uintptr_t)dst & 3)) {
+        *dst = on ? (*dst | mask) : (*dst & ~mask);
+        dst++;
+        len--;
+    }
+
+    uint32_t wmask = mask * 0x01010101u;
+    sh1106_word_t *w = (sh1106_word_t *)dst;
+    if (mask == 0xFF) {
+        uint32_t fill = on ? 0xFFFFFFFFu : 0;
+        for (; len >= 4; len -= 4) *w++ = fill;
+    } else if (on) {
+        for (; len >= 4; len -= 4, w++) *w |= wmask;
+    } else {
+        for (; len >= 4; len -= 4, w++) *w &= ~wmask;
+    }
+
+    dst = (uint8_t *)w;
+    while (len--) {
+        *dst = on ? (*dst | mask) : (*dst & ~mask);
+        dst++;
+    }
+}
+
+// Fill a rectangle: clipped once, then one masked span per page
+void sh1106_fill_rect(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool on) {
+    if (x >= SH1106_WIDTH || y >= SH1106_HEIGHT || w == 0 || h == 0) return;
+
+    uint8_t x1 = MIN(x + w, SH1106_WIDTH) - 1;
+    uint8_t y1 = MIN(y + h, SH1106_HEIGHT) - 1;
+    uint8_t len = x1 - x + 1;
+    uint8_t first = y / 8;
+    uint8_t last = y1 / 8;
+
+    for (uint8_t page = first; page <= last; page++) {
+        uint8_t mask = 0xFF;
+        if (page == first) mask &= 0xFF << (y % 8);
+        if (page == last) mask &= 0xFF >> (7 - (y1 % 8));
+
+        page_fill(&display->buffer[page * SH1106_WIDTH + x], len, mask, on);
+        extend_dirty(display, page, x, x1);
+    }
+}
+
+// Horizontal line of w pixels starting at (x, y)
+void sh1106_draw_hline(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, bool on) {
+    sh1106_fill_rect(display, x, y, w, 1, on);
+}
+
+// Vertical line of h pixels starting at (x, y)
+void sh1106_draw_vline(sh1106_t *display, uint8_t x, uint8_t y, uint8_t h, bool on) {
+    sh1106_fill_rect(display, x, y, 1, h, on);
+}
+
+// Draw a 1bpp page-major bitmap (ceil(h/8) rows of w column bytes, LSB = top).
+// Any y offset is handled by splitting each source byte across two pages.
+void sh1106_blit(sh1106_t *display, uint8_t x, uint8_t y, const uint8_t *bitmap,
+                 uint8_t w, uint8_t h, bool opaque) {
+    if (!bitmap || x >= SH1106_WIDTH || y >= SH1106_HEIGHT || w == 0 || h == 0) return;
+
+    uint8_t cw = MIN(w, SH1106_WIDTH - x);
+    uint8_t x1 = x + cw - 1;
+    uint8_t shift = y % 8;
+    uint8_t page0 = y / 8;
+    uint8_t src_pages = (h + 7) / 8;
+
+    for (uint8_t sp = 0; sp < src_pages; sp++) {
+        uint8_t rows = h - sp * 8;
+        uint8_t valid = (rows >= 8) ? 0xFF : (uint8_t)((1u << rows) - 1);
+        const uint8_t *src = &bitmap[sp * w];
+
+        // Upper part of each source byte lands in this page
+        uint8_t page = page0 + sp;
+        if (page >= SH1106_PAGES) break;
+        uint8_t mask = (uint8_t)(valid << shift);
+        uint8_t *dst = &display->buffer[page * SH1106_WIDTH + x];
+        for (uint8_t i = 0; i < cw; i++) {
+            uint8_t bits = (uint8_t)((src[i] & valid) << shift);
+            dst[i] = opaque ? ((dst[i] & ~mask) | bits) : (dst[i] | bits);
+        }
+        extend_dirty(display, page, x, x1);
+
+        // Remainder spills into the next page when y is not page aligned
+        if (shift == 0 || page + 1 >= SH1106_PAGES) continue;
+        mask = valid >> (8 - shift);
+        if (mask == 0) continue;
+        dst += SH1106_WIDTH;
+        for (uint8_t i = 0; i < cw; i++) {
+            uint8_t bits = (src[i] & valid) >> (8 - shift);
+            dst[i] = opaque ? ((dst[i] & ~mask) | bits) : (dst[i] | bits);
+        }
+        extend_dirty(display, page + 1, x, x1);
+    }
+}
+
 // Draw a rectangle
 void sh1106_draw_rect(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool fill) {
     if (fill) {
-        for (uint8_t i = 0; i < h; i++) {
-            for (uint8_t j = 0; j < w; j++) {
-                sh1106_set_pixel(display, x + j, y + i, true);
-            }
-        }
-    } else {
+        sh1106_fill_rect(display, x, y, w, h, true);
+    } else if (w > 0 && h > 0) {
         // Top and bottom lines
-        for (uint8_t i = 0; i < w; i++) {
-            sh1106_set_pixel(display, x + i, y, true);
-            sh1106_set_pixel(display, x + i, y + h - 1, true);
-        }
+        sh1106_draw_hline(display, x, y, w, true);
+        sh1106_draw_hline(display, x, y + h - 1, w, true);
         // Left and right lines
-        for (uint8_t i = 0; i < h; i++) {
-            sh1106_set_pixel(display, x, y + i, true);
-            sh1106_set_pixel(display, x + w - 1, y + i, true);
-        }
+        sh1106_draw_vline(display, x, y, h, true);
+        sh1106_draw_vline(display, x + w - 1, y, h, true);
     }
 }
 
-// Draw a character at specified position
-void sh1106_draw_char(sh1106_t *display, uint8_t x, uint8_t y, char c) {
+// =============================================================================
+// Shape primitives (rasterized by lib/gfx onto the page-major buffer)
+// =============================================================================
+
+typedef struct {
+    sh1106_t *display;
+    bool on;
+} shape_ctx_t;
+
+static void shape_plot(void *ctx, int16_t x, int16_t y) {
+    shape_ctx_t *c = ctx;
+    uint8_t *p = &c->display->buffer[(y / 8) * SH1106_WIDTH + x];
+    uint8_t bit = 1 << (y % 8);
+    *p = c->on ? (*p | bit) : (*p & ~bit);
+}
+
+static void shape_span(void *ctx, int16_t x0, int16_t x1, int16_t y) {
+    shape_ctx_t *c = ctx;
+    page_fill(&c->display->buffer[(y / 8) * SH1106_WIDTH + x0], x1 - x0 + 1, 1 << (y % 8), c->on);
+}
+
+// Dirty tracking is per primitive bounding box rather than per pixel
+static void shape_bbox(void *ctx, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    shape_ctx_t *c = ctx;
+    for (int page = y0 / 8; page <= y1 / 8; page++) {
+        extend_dirty(c->display, page, x0, x1);
+    }
+}
+
+#define SHAPE_TARGET(display, on)                                               \
+    shape_ctx_t ctx_ = {(display), (on)};                                        \
+    const gfx_target_t target_ = {SH1106_WIDTH, SH1106_HEIGHT, shape_plot,       \
+                                  shape_span, shape_bbox, &ctx_}
+
+void sh1106_draw_circle(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_circle(&target_, cx, cy, r);
+}
+
+void sh1106_fill_circle(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_fill_circle(&target_, cx, cy, r);
+}
+
+void sh1106_draw_ellipse(sh1106_t *display, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_ellipse(&target_, cx, cy, rx, ry);
+}
+
+void sh1106_fill_ellipse(sh1106_t *display, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_fill_ellipse(&target_, cx, cy, rx, ry);
+}
+
+void sh1106_draw_arc(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r,
+                     int16_t start_deg, int16_t end_deg, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_arc(&target_, cx, cy, r, start_deg, end_deg);
+}
+
+void sh1106_draw_polyline(sh1106_t *display, const sh1106_point_t *pts, uint8_t count,
+                          bool closed, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_polyline(&target_, pts, count, closed);
+}
+
+void sh1106_fill_polygon(sh1106_t *display, const sh1106_point_t *pts, uint8_t count, bool on) {
+    SHAPE_TARGET(display, on);
+    gfx_fill_polygon(&target_, pts, count);
+}
+
+// Glyph columns map 1:1 onto page bytes, so a character is a 1bpp blit.
+// Opaque glyphs also cover the spacing column and bottom row of the 6x8 cell.
+static void draw_glyph(sh1106_t *display, uint8_t x, uint8_t y, char c, bool opaque) {
     // Limit to printable ASCII
     if (c < 32 || c > 127) c = 32;
-    
-    for (uint8_t col = 0; col < 5; col++) {
-        uint8_t column = font5x7[c - 32][col];
-        for (uint8_t row = 0; row < 8; row++) {
-            if (column & (1 << row)) {
-                sh1106_set_pixel(display, x + col, y + row, true);
-            }
-        }
+
+    if (opaque) {
+        uint8_t cell[6];
+        memcpy(cell, font5x7[c - 32], 5);
+        cell[5] = 0x00;
+        sh1106_blit(display, x, y, cell, 6, 8, true);
+    } else {
+        sh1106_blit(display, x, y, font5x7[c - 32], 5, 8, false);
     }
 }
 
-// Draw a string at specified position
-void sh1106_draw_string(sh1106_t *display, uint8_t x, uint8_t y, const char *str) {
+// Lay out a string in 6-pixel cells, wrapping at the right edge
+static void draw_text(sh1106_t *display, uint8_t x, uint8_t y, const char *str, bool opaque) {
     uint8_t x_pos = x;
     while (*str) {
         if (x_pos + 5 > SH1106_WIDTH) {
@@ -353,8 +636,288 @@ void sh1106_draw_string(sh1106_t *display, uint8_t x, uint8_t y, const char *str
             y += 8;
             if (y + 8 > SH1106_HEIGHT) break;
         }
-        sh1106_draw_char(display, x_pos, y, *str);
+        draw_glyph(display, x_pos, y, *str, opaque);
         x_pos += 6;  // Character width + spacing
         str++;
     }
 }
+
+// Draw a character at specified position
+void sh1106_draw_char(sh1106_t *display, uint8_t x, uint8_t y, char c) {
+    draw_glyph(display, x, y, c, false);
+}
+
+// Draw a character, overwriting its 6x8 cell background
+void sh1106_draw_char_opaque(sh1106_t *display, uint8_t x, uint8_t y, char c) {
+    draw_glyph(display, x, y, c, true);
+}
+
+// Draw a string at specified position
+void sh1106_draw_string(sh1106_t *display, uint8_t x, uint8_t y, const char *str) {
+    draw_text(display, x, y, str, false);
+}
+
+// Draw a string, overwriting stale pixels behind each character cell
+void sh1106_draw_string_opaque(sh1106_t *display, uint8_t x, uint8_t y, const char *str) {
+    draw_text(display, x, y, str, true);
+}
+
+// =============================================================================
+// Async (DMA) update
+// =============================================================================
+
+static void async_finish(sh1106_t *display, hw_result_t result);
+
+// The bus has finished once the TX FIFO has drained and the controller is idle
+static inline bool bus_idle(const i2c_hw_t *hw) {
+    return (hw->status & I2C_IC_STATUS_TFE_BITS) && !(hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// DMA completion: the last byte has been handed to the I2C TX FIFO, but the
+// controller is still sending. Watch for the final STOP to finish the frame.
+static void sh1106_dma_irq_handler(void) {
+    for (int i = 0; i < MAX_ASYNC_DISPLAYS; i++) {
+        sh1106_t *display = async_instances[i];
+        if (!display) continue;
+
+        sh1106_async_t *async = display->async;
+        if (dma_channel_get_irq0_status(async->dma_chan)) {
+            dma_channel_acknowledge_irq0(async->dma_chan);
+
+            // Earlier pages latched STOP_DET too; clear it, then catch a STOP
+            // that landed before the interrupt was unmasked
+            i2c_hw_t *hw = i2c_get_hw(display->i2c);
+            (void)hw->clr_stop_det;
+            hw->intr_mask = I2C_IC_INTR_MASK_M_TX_ABRT_BITS | I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+            if (bus_idle(hw)) {
+                async_finish(display, HW_OK);
+            }
+        }
+    }
+}
+
+// I2C interrupt: final STOP sent (frame done) or transfer aborted (NACK, lost arbitration)
+static void sh1106_i2c_irq_handler(void) {
+    for (int i = 0; i < MAX_ASYNC_DISPLAYS; i++) {
+        sh1106_t *display = async_instances[i];
+        if (!display || !display->async->busy) continue;
+
+        i2c_hw_t *hw = i2c_get_hw(display->i2c);
+        uint32_t stat = hw->intr_stat;
+        if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+            dma_channel_abort(display->async->dma_chan);
+            (void)hw->clr_tx_abrt;
+            async_finish(display, HW_ERROR);
+        } else if (stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+            (void)hw->clr_stop_det;
+            if (bus_idle(hw)) {
+                async_finish(display, HW_OK);
+            }
+        }
+    }
+}
+
+// Append one I2C transaction (control byte + payload) to the word stream
+static uint16_t *encode_transaction(uint16_t *w, uint8_t ctrl, const uint8_t *payload, uint16_t len) {
+    *w++ = ctrl;
+    for (uint16_t i = 0; i < len; i++) {
+        *w++ = payload[i];
+    }
+    w[-1] |= I2C_IC_DATA_CMD_STOP_BITS;  // STOP after the last byte; the next word issues a new START
+    return w;
+}
+
+// Append page/column addressing plus column data for one span
+static uint16_t *encode_page_span(uint16_t *w, const sh1106_t *display, uint8_t page, uint8_t x, uint8_t len) {
+    uint8_t col = x + SH1106_COL_OFFSET;
+    uint8_t cmds[3] = {
+        SH1106_CMD_SET_PAGE_ADDR | page,
+        SH1106_CMD_SET_COLUMN_ADDR_HIGH | ((col >> 4) & 0x0F),
+        SH1106_CMD_SET_COLUMN_ADDR_LOW | (col & 0x0F),
+    };
+    w = encode_transaction(w, SH1106_CTRL_CMD_STREAM, cmds, sizeof(cmds));
+    return encode_transaction(w, SH1106_CTRL_DATA_STREAM, &display->buffer[page * SH1106_WIDTH + x], len);
+}
+
+// Finish a transfer; on error, force the whole frame to be resent. The IRQs and
+// sh1106_update_busy may both see the end, so only the first caller completes it.
+static void async_finish(sh1106_t *display, hw_result_t result) {
+    sh1106_async_t *async = display->async;
+
+    uint32_t save = save_and_disable_interrupts();
+    bool finished = async->busy;
+    if (finished) {
+        i2c_get_hw(display->i2c)->intr_mask = 0;
+        async->result = result;
+        if (result != HW_OK) {
+            for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+                extend_dirty(display, page, 0, SH1106_WIDTH - 1);
+            }
+            display->start_line_pending = true;
+        }
+        async->busy = false;
+    }
+    restore_interrupts(save);
+
+    // Called with busy clear, so the callback may queue the next frame
+    if (finished && async->done_callback) {
+        async->done_callback(async->user_data);
+    }
+}
+
+hw_result_t sh1106_async_init(sh1106_t *display, sh1106_async_t *async) {
+    if (!display || !async) return HW_INVALID_PARAM;
+
+    int slot = -1;
+    for (int i = 0; i < MAX_ASYNC_DISPLAYS; i++) {
+        if (!async_instances[i]) { slot = i; break; }
+    }
+    if (slot < 0) return HW_ERROR;
+
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) return HW_BUSY;
+
+    async->dma_chan = chan;
+    async->busy = false;
+    async->result = HW_OK;
+    async->done_callback = NULL;
+    async->user_data = NULL;
+
+    // 16-bit words into IC_DATA_CMD, paced by the I2C TX DREQ
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(display->i2c, true));
+    dma_channel_configure(chan, &c, &i2c_get_hw(display->i2c)->data_cmd, async->words, 0, false);
+
+    // I2C interrupts stay masked except while a frame is in flight
+    i2c_get_hw(display->i2c)->intr_mask = 0;
+
+    display->async = async;
+
+    // Store instance for IRQ access (with critical section for thread safety)
+    uint32_t save = save_and_disable_interrupts();
+    async_instances[slot] = display;
+    restore_interrupts(save);
+
+    if (!dma_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, sh1106_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        dma_irq_installed = true;
+    }
+    uint i2c_index = i2c_get_index(display->i2c);
+    if (!i2c_irq_installed[i2c_index]) {
+        irq_add_shared_handler(I2C0_IRQ + i2c_index, sh1106_i2c_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(I2C0_IRQ + i2c_index, true);
+        i2c_irq_installed[i2c_index] = true;
+    }
+    dma_channel_set_irq0_enabled(chan, true);
+
+    return HW_OK;
+}
+
+void sh1106_async_deinit(sh1106_t *display) {
+    if (!display || !display->async) return;
+
+    sh1106_update_wait(display);
+    dma_channel_set_irq0_enabled(display->async->dma_chan, false);
+    dma_channel_unclaim(display->async->dma_chan);
+
+    // Remove from instances (with critical section for thread safety)
+    uint32_t save = save_and_disable_interrupts();
+    for (int i = 0; i < MAX_ASYNC_DISPLAYS; i++) {
+        if (async_instances[i] == display) {
+            async_instances[i] = NULL;
+        }
+    }
+    restore_interrupts(save);
+
+    display->async = NULL;
+}
+
+void sh1106_async_set_callback(sh1106_t *display, void (*callback)(void *), void *user_data) {
+    if (!display || !display->async) return;
+    display->async->done_callback = callback;
+    display->async->user_data = user_data;
+}
+
+// Snapshot the frame (or just its dirty spans) and start streaming it
+hw_result_t sh1106_update_async(sh1106_t *display, bool full) {
+    if (!display || !display->async) return HW_INVALID_PARAM;
+    if (sh1106_update_busy(display)) return HW_BUSY;
+
+    sh1106_async_t *async = display->async;
+    uint16_t *w = async->words;
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        uint8_t x0 = full ? 0 : display->dirty_x0[page];
+        uint8_t x1 = full ? SH1106_WIDTH - 1 : display->dirty_x1[page];
+        if (x0 <= x1) {
+            w = encode_page_span(w, display, page, x0, x1 - x0 + 1);
+        }
+        mark_page_clean(display, page);
+    }
+    if (display->start_line_pending) {
+        uint8_t cmd = SH1106_CMD_SET_START_LINE | display->start_line;
+        w = encode_transaction(w, SH1106_CTRL_CMD_STREAM, &cmd, 1);
+        display->start_line_pending = false;
+    }
+
+    // Nothing to send: no transfer starts, so the callback will not run
+    uint32_t count = w - async->words;
+    if (count == 0) return HW_NOT_FOUND;
+
+    // Target address lives in IC_TAR and can only change while the block is disabled
+    i2c_hw_t *hw = i2c_get_hw(display->i2c);
+    hw->enable = 0;
+    hw->tar = display->addr;
+    hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+
+    // Abort is watched for the whole frame; STOP_DET only once DMA has drained
+    (void)hw->clr_tx_abrt;
+    async->busy = true;
+    async->result = HW_OK;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+    dma_channel_transfer_from_buffer_now(async->dma_chan, async->words, count);
+    return HW_OK;
+}
+
+// Poll transfer state; the frame is done once DMA has drained and the bus is idle.
+// The I2C IRQ normally finishes the frame first; polling covers a masked IRQ.
+bool sh1106_update_busy(sh1106_t *display) {
+    if (!display || !display->async || !display->async->busy) return false;
+
+    sh1106_async_t *async = display->async;
+    i2c_hw_t *hw = i2c_get_hw(display->i2c);
+
+    // NACK or arbitration loss: the controller flushed its FIFO, drop the rest of the frame
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        dma_channel_abort(async->dma_chan);
+        (void)hw->clr_tx_abrt;
+        async_finish(display, HW_ERROR);
+        return false;
+    }
+
+    if (dma_channel_is_busy(async->dma_chan)) return true;
+    if (!bus_idle(hw)) return true;
+
+    async_finish(display, HW_OK);
+    return false;
+}
+
+// Block until the in-flight transfer (if any) completes
+hw_result_t sh1106_update_wait(sh1106_t *display) {
+    if (!display || !display->async) return HW_OK;
+
+    uint64_t start = hw_time_us();
+    while (sh1106_update_busy(display)) {
+        // Generous bound: a full frame is ~25 ms at 400 kHz
+        if (hw_timeout_elapsed(start, SH1106_I2C_TIMEOUT_US * SH1106_PAGES)) {
+            dma_channel_abort(display->async->dma_chan);
+            async_finish(display, HW_TIMEOUT);
+            break;
+        }
+        tight_loop_contents();
+    }
+    return display->async->result;
+}
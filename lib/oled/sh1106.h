@@ -53,26 +53,114 @@
 #define SH1106_I2C_RETRY_COUNT  3       // Number of retries for I2C operations
 #define SH1106_I2C_FREQ         400000  // Default I2C frequency (400kHz)
 
+// Maximum number of command bytes batched into one transaction by sh1106_command_list
+#define SH1106_CMD_LIST_MAX     32
+
+// Data bytes per transaction in sh1106_write_span (each chunk repeats address + control byte)
+#define SH1106_WRITE_CHUNK      16
+
+// Async (DMA) update: one IC_DATA_CMD word per bus byte. Each page costs one
+// addressing transaction (control byte + 3 commands) plus one data transaction.
+// A queued start line change adds one 2-byte command transaction.
+#define SH1106_ASYNC_FRAME_WORDS (SH1106_PAGES * ((1 + 3) + (1 + SH1106_WIDTH)) + 2)
+
+// Maximum vertex count accepted by sh1106_fill_polygon (bounds the per-row crossing list)
+#define SH1106_POLY_MAX_VERTICES GFX_POLY_MAX_VERTICES
+
+// Signed point for shape primitives; vertices may lie off-screen and are clipped
+typedef gfx_point_t sh1106_point_t;
+
+// Async update context (caller-owned; large, so keep it static rather than on the stack)
+typedef struct {
+    int dma_chan;                               // Claimed DMA channel
+    volatile bool busy;                         // Transfer in flight
+    volatile hw_result_t result;                // Result of the last completed transfer
+    void (*done_callback)(void *user_data);     // Called once the frame has left the bus or failed (see result)
+    void *user_data;                            // Passed to done_callback
+    uint16_t words[SH1106_ASYNC_FRAME_WORDS];   // Encoded frame snapshot streamed by DMA
+} sh1106_async_t;
+
 // SH1106 structure
 typedef struct {
     i2c_inst_t *i2c;
     uint8_t addr;
     uint8_t buffer[SH1106_WIDTH * SH1106_PAGES];  // Display buffer
+
+    // Per-page dirty column range (inclusive). A page is clean when
+    // dirty_x0 > dirty_x1; columns outside the range match the panel.
+    uint8_t dirty_x0[SH1106_PAGES];
+    uint8_t dirty_x1[SH1106_PAGES];
+
+    sh1106_async_t *async;  // Optional DMA update context (NULL = blocking only)
+
+    // Hardware scroll: buffer[] mirrors panel RAM, and RAM row start_line is
+    // shown at the top. A pending change is sent by the next update.
+    uint8_t start_line;
+    bool start_line_pending;
 } sh1106_t;
 
 // Function prototypes
 hw_result_t sh1106_init(sh1106_t *display, i2c_inst_t *i2c, uint8_t addr, uint8_t sda_pin, uint8_t scl_pin);
 hw_result_t sh1106_command(sh1106_t *display, uint8_t cmd);
+hw_result_t sh1106_command_list(sh1106_t *display, const uint8_t *cmds, uint8_t len);
 hw_result_t sh1106_display_on(sh1106_t *display, bool on);
 hw_result_t sh1106_set_contrast(sh1106_t *display, uint8_t contrast);
 hw_result_t sh1106_entire_display(sh1106_t *display, bool on);
 hw_result_t sh1106_invert(sh1106_t *display, bool invert);
 void sh1106_clear(sh1106_t *display);
 hw_result_t sh1106_update(sh1106_t *display);
+hw_result_t sh1106_update_dirty(sh1106_t *display);
+hw_result_t sh1106_write_span(sh1106_t *display, uint8_t page, uint8_t x, uint8_t len);
+void sh1106_mark_dirty(sh1106_t *display, uint8_t page, uint8_t x0, uint8_t x1);
+void sh1106_mark_clean(sh1106_t *display);
+bool sh1106_is_dirty(const sh1106_t *display);
+
+// Hardware vertical scroll. After sh1106_scroll_up, draw the new bottom band at
+// sh1106_scroll_y(display, y) and call an update: only the band's pages are sent.
+// Scrolling in multiples of 8 keeps 8-row text from straddling the RAM wrap.
+hw_result_t sh1106_set_start_line(sh1106_t *display, uint8_t line);
+void sh1106_scroll_up(sh1106_t *display, uint8_t rows);
+
+// Map a visible row to its row in buffer[] under the current start line
+static inline uint8_t sh1106_scroll_y(const sh1106_t *display, uint8_t y) {
+    return (uint8_t)((y + display->start_line) % SH1106_HEIGHT);
+}
+
+// Non-blocking DMA updates. The frame is snapshotted when queued, so drawing into
+// buffer[] may continue immediately. Blocking calls return HW_BUSY while a transfer runs.
+// The callback runs from the I2C IRQ after the final STOP, with busy already clear,
+// so it may queue the next frame. sh1106_update_async returns HW_NOT_FOUND when
+// nothing is dirty: no transfer is started and the callback does not run.
+hw_result_t sh1106_async_init(sh1106_t *display, sh1106_async_t *async);
+void sh1106_async_deinit(sh1106_t *display);
+void sh1106_async_set_callback(sh1106_t *display, void (*callback)(void *), void *user_data);
+hw_result_t sh1106_update_async(sh1106_t *display, bool full);
+bool sh1106_update_busy(sh1106_t *display);
+hw_result_t sh1106_update_wait(sh1106_t *display);
 void sh1106_set_pixel(sh1106_t *display, uint8_t x, uint8_t y, bool on);
 void sh1106_draw_line(sh1106_t *display, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool on);
 void sh1106_draw_rect(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool fill);
+void sh1106_fill_rect(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool on);
+void sh1106_draw_hline(sh1106_t *display, uint8_t x, uint8_t y, uint8_t w, bool on);
+void sh1106_draw_vline(sh1106_t *display, uint8_t x, uint8_t y, uint8_t h, bool on);
+
+// Shape primitives (rasterized by lib/gfx). Centres and vertices are signed and
+// may lie off-screen; clipping is decided once per primitive. Arc angles are in degrees, clockwise
+// on screen from 3 o'clock, drawn from start_deg to end_deg.
+void sh1106_draw_circle(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r, bool on);
+void sh1106_fill_circle(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r, bool on);
+void sh1106_draw_ellipse(sh1106_t *display, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry, bool on);
+void sh1106_fill_ellipse(sh1106_t *display, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry, bool on);
+void sh1106_draw_arc(sh1106_t *display, int16_t cx, int16_t cy, uint8_t r,
+                     int16_t start_deg, int16_t end_deg, bool on);
+void sh1106_draw_polyline(sh1106_t *display, const sh1106_point_t *pts, uint8_t count,
+                          bool closed, bool on);
+void sh1106_fill_polygon(sh1106_t *display, const sh1106_point_t *pts, uint8_t count, bool on);
+void sh1106_blit(sh1106_t *display, uint8_t x, uint8_t y, const uint8_t *bitmap,
+                 uint8_t w, uint8_t h, bool opaque);
 void sh1106_draw_char(sh1106_t *display, uint8_t x, uint8_t y, char c);
 void sh1106_draw_string(sh1106_t *display, uint8_t x, uint8_t y, const char *str);
+void sh1106_draw_char_opaque(sh1106_t *display, uint8_t x, uint8_t y, char c);
+void sh1106_draw_string_opaque(sh1106_t *display, uint8_t x, uint8_t y, const char *str);
 
 #endif // SH1106_H
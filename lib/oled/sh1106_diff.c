@@ -0,0 +1,127 @@
+#include "../lib.h"
+
+// Initialize diff state; cost may be NULL for the default model
+void sh1106_diff_init(sh1106_diff_t *diff, const sh1106_diff_cost_t *cost) {
+    if (cost) {
+        diff->cost = *cost;
+    } else {
+        diff->cost.segment_cost = SH1106_DIFF_DEFAULT_SEGMENT_COST;
+        diff->cost.chunk_cost = SH1106_DIFF_DEFAULT_CHUNK_COST;
+        diff->cost.data_cost = SH1106_DIFF_DEFAULT_DATA_COST;
+    }
+    diff->frames = 0;
+    diff->segments = 0;
+    diff->bus_bytes = 0;
+    sh1106_diff_invalidate(diff);
+}
+
+// Forget the shadow so the next update resends the full frame
+void sh1106_diff_invalidate(sh1106_diff_t *diff) {
+    diff->valid = false;
+}
+
+// Chunks sh1106_write_span splits a span of len columns into
+static inline uint32_t span_chunks(uint32_t len) {
+    return (len + SH1106_WRITE_CHUNK - 1) / SH1106_WRITE_CHUNK;
+}
+
+// Cost of one segment of len columns under a cost model
+static inline uint32_t segment_cost(const sh1106_diff_cost_t *cost, uint32_t len) {
+    return cost->segment_cost + span_chunks(len) * cost->chunk_cost + len * cost->data_cost;
+}
+
+// Compute the segments needed to bring the panel from the shadow to frame.
+// segs must hold SH1106_DIFF_MAX_SEGMENTS entries; returns the segment count.
+uint16_t sh1106_diff_compute(const sh1106_diff_t *diff, const uint8_t *frame,
+                             sh1106_segment_t segs[SH1106_DIFF_MAX_SEGMENTS]) {
+    uint16_t count = 0;
+
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        if (!diff->valid) {
+            segs[count++] = (sh1106_segment_t){page, 0, SH1106_WIDTH};
+            continue;
+        }
+
+        const uint8_t *cur = &frame[page * SH1106_WIDTH];
+        const uint8_t *old = &diff->shadow[page * SH1106_WIDTH];
+        uint8_t page_count = 0;
+        int start = -1;
+        int end = -1;
+
+        for (int x = 0; x < SH1106_WIDTH; x++) {
+            if (cur[x] == old[x]) continue;
+
+            if (start < 0) {
+                start = end = x;
+                continue;
+            }
+
+            // Extending the open segment over the gap to x costs the gap bytes plus any
+            // chunk headers that adds; a new segment costs its addressing and first
+            // header. The last slot of a page absorbs everything after it.
+            uint32_t merge_cost = segment_cost(&diff->cost, x - start + 1) -
+                                  segment_cost(&diff->cost, end - start + 1);
+            if (merge_cost <= segment_cost(&diff->cost, 1) ||
+                page_count == SH1106_DIFF_MAX_SEGMENTS_PER_PAGE - 1) {
+                end = x;
+            } else {
+                segs[count++] = (sh1106_segment_t){page, start, end - start + 1};
+                page_count++;
+                start = end = x;
+            }
+        }
+
+        if (start >= 0) {
+            segs[count++] = (sh1106_segment_t){page, start, end - start + 1};
+        }
+    }
+    return count;
+}
+
+// Record segments as transmitted
+void sh1106_diff_commit(sh1106_diff_t *diff, const uint8_t *frame,
+                        const sh1106_segment_t *segs, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t offset = segs[i].page * SH1106_WIDTH + segs[i].x;
+        memcpy(&diff->shadow[offset], &frame[offset], segs[i].len);
+    }
+    diff->valid = true;
+}
+
+// Bytes on the wire for a segment list as sent by sh1106_write_span
+// (one addressing transaction, then data in SH1106_WRITE_CHUNK-byte chunks)
+uint32_t sh1106_diff_bus_bytes(const sh1106_segment_t *segs, uint16_t count) {
+    static const sh1106_diff_cost_t wire = {
+        SH1106_DIFF_DEFAULT_SEGMENT_COST, SH1106_DIFF_DEFAULT_CHUNK_COST, SH1106_DIFF_DEFAULT_DATA_COST,
+    };
+    uint32_t bytes = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        bytes += segment_cost(&wire, segs[i].len);
+    }
+    return bytes;
+}
+
+// Send only what changed since the last diff update
+hw_result_t sh1106_diff_update(sh1106_t *display, sh1106_diff_t *diff) {
+    if (!display || !diff) return HW_INVALID_PARAM;
+
+    sh1106_segment_t segs[SH1106_DIFF_MAX_SEGMENTS];
+    uint16_t count = sh1106_diff_compute(diff, display->buffer, segs);
+
+    for (uint16_t i = 0; i < count; i++) {
+        hw_result_t ret = sh1106_write_span(display, segs[i].page, segs[i].x, segs[i].len);
+        if (ret != HW_OK) {
+            // Panel state is now unknown
+            sh1106_diff_invalidate(diff);
+            return ret;
+        }
+    }
+
+    sh1106_diff_commit(diff, display->buffer, segs, count);
+    sh1106_mark_clean(display);
+
+    diff->frames++;
+    diff->segments += count;
+    diff->bus_bytes += sh1106_diff_bus_bytes(segs, count);
+    return HW_OK;
+}
@@ -0,0 +1,61 @@
+#ifndef SH1106_DIFF_H
+#define SH1106_DIFF_H
+
+// Frame-to-frame diff transport for the SH1106 driver.
+//
+// Keeps a shadow copy of the last transmitted frame and sends only the
+// (page, column-run) segments that differ. Runs separated by a short gap are
+// merged when resending the unchanged gap (plus any chunk header it adds) is
+// cheaper than opening a new segment, according to a configurable cost model.
+//
+// The shadow only tracks traffic sent through sh1106_diff_update; after any
+// other update path (or a panel reset) call sh1106_diff_invalidate.
+
+// Default cost model, in bus bytes, matching sh1106_write_span:
+// opening a segment = addressing transaction (address + control + 3 commands)
+// every SH1106_WRITE_CHUNK data bytes = data transaction header (address + control byte)
+#define SH1106_DIFF_DEFAULT_SEGMENT_COST 5
+#define SH1106_DIFF_DEFAULT_CHUNK_COST   2
+#define SH1106_DIFF_DEFAULT_DATA_COST    1
+
+// Upper bound on segments per page (merging keeps real frames far below this)
+#define SH1106_DIFF_MAX_SEGMENTS_PER_PAGE 16
+#define SH1106_DIFF_MAX_SEGMENTS (SH1106_PAGES * SH1106_DIFF_MAX_SEGMENTS_PER_PAGE)
+
+// Transfer cost model
+typedef struct {
+    uint16_t segment_cost;  // Fixed cost of starting a segment (addressing)
+    uint16_t chunk_cost;    // Cost per started chunk of SH1106_WRITE_CHUNK data bytes (headers)
+    uint16_t data_cost;     // Cost per data byte sent
+} sh1106_diff_cost_t;
+
+// One contiguous run of columns within a page
+typedef struct {
+    uint8_t page;
+    uint8_t x;
+    uint8_t len;
+} sh1106_segment_t;
+
+// Diff state (holds a 1 KiB shadow frame; keep it static rather than on the stack)
+typedef struct {
+    uint8_t shadow[SH1106_WIDTH * SH1106_PAGES];  // Last frame sent to the panel
+    bool valid;                                   // Shadow matches panel contents
+    sh1106_diff_cost_t cost;                      // Cost model used for merging
+
+    // Statistics
+    uint32_t frames;        // Frames processed by sh1106_diff_update
+    uint32_t segments;      // Segments transmitted
+    uint32_t bus_bytes;     // Bytes on the wire (address, control, command and data)
+} sh1106_diff_t;
+
+// Function prototypes
+void sh1106_diff_init(sh1106_diff_t *diff, const sh1106_diff_cost_t *cost);
+void sh1106_diff_invalidate(sh1106_diff_t *diff);
+uint16_t sh1106_diff_compute(const sh1106_diff_t *diff, const uint8_t *frame,
+                             sh1106_segment_t segs[SH1106_DIFF_MAX_SEGMENTS]);
+void sh1106_diff_commit(sh1106_diff_t *diff, const uint8_t *frame,
+                        const sh1106_segment_t *segs, uint16_t count);
+uint32_t sh1106_diff_bus_bytes(const sh1106_segment_t *segs, uint16_t count);
+hw_result_t sh1106_diff_update(sh1106_t *display, sh1106_diff_t *diff);
+
+#endif // SH1106_DIFF_H
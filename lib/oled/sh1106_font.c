@@ -0,0 +1,51 @@
+#include "../lib.h"
+
+// Look up a glyph, substituting the fallback for unencoded characters
+const sh1106_glyph_t *sh1106_font_glyph(const sh1106_font_t *font, char c) {
+    uint8_t code = (uint8_t)c;
+    if (code < font->first || code > font->last) {
+        code = font->fallback;
+    }
+    return &font->glyphs[code - font->first];
+}
+
+// Advance of a single character in pixels
+uint8_t sh1106_font_char_width(const sh1106_font_t *font, char c) {
+    return sh1106_font_glyph(font, c)->advance;
+}
+
+// Total advance of a string in pixels (layout without rendering)
+uint16_t sh1106_font_string_width(const sh1106_font_t *font, const char *str) {
+    uint16_t width = 0;
+    while (*str) {
+        width += sh1106_font_glyph(font, *str++)->advance;
+    }
+    return width;
+}
+
+// Draw one character with its top-left at (x, y); returns the advance
+uint8_t sh1106_font_draw_char(sh1106_t *display, const sh1106_font_t *font,
+                              uint8_t x, uint8_t y, char c, bool opaque) {
+    const sh1106_glyph_t *g = sh1106_font_glyph(font, c);
+
+    if (g->width > 0) {
+        sh1106_blit(display, x, y, &font->bitmap[g->offset], g->width, font->height, opaque);
+    }
+
+    // Opaque text also clears the inter-character gap
+    if (opaque && g->advance > g->width) {
+        sh1106_fill_rect(display, x + g->width, y, g->advance - g->width, font->height, false);
+    }
+    return g->advance;
+}
+
+// Draw a string on one line (no wrapping); returns the width drawn
+uint16_t sh1106_font_draw_string(sh1106_t *display, const sh1106_font_t *font,
+                                 uint8_t x, uint8_t y, const char *str, bool opaque) {
+    uint16_t x_pos = x;
+    while (*str && x_pos < SH1106_WIDTH) {
+        x_pos += sh1106_font_draw_char(display, font, x_pos, y, *str, opaque);
+        str++;
+    }
+    return x_pos - x;
+}
@@ -0,0 +1,41 @@
+#ifndef SH1106_FONT_H
+#define SH1106_FONT_H
+
+// Packed bitmap fonts for the SH1106 driver.
+//
+// Each glyph is stored page-aligned in the same layout as sh1106_t.buffer:
+// ceil(height / 8) rows of `width` column bytes, LSB = top pixel. Glyphs are
+// drawn with sh1106_blit(), so they take the column-native byte path.
+// Font tables are generated offline by tools/bdf2font.py.
+
+// Glyph descriptor (4 bytes)
+typedef struct {
+    uint16_t offset;   // Byte offset of the glyph bitmap in font->bitmap
+    uint8_t width;     // Bitmap width in columns
+    uint8_t advance;   // Cursor advance in pixels (no kerning)
+} sh1106_glyph_t;
+
+// Font descriptor
+typedef struct {
+    const uint8_t *bitmap;          // Packed glyph bitmaps
+    const sh1106_glyph_t *glyphs;   // Indexed by (c - first); gaps reuse the fallback glyph
+    uint8_t first;                  // First encoded character
+    uint8_t last;                   // Last encoded character
+    uint8_t fallback;               // Character drawn for codes outside first..last
+    uint8_t height;                 // Glyph height in pixels
+} sh1106_font_t;
+
+// Sample fonts (generated from tools/fonts/*.bdf)
+extern const sh1106_font_t sh1106_font_prop8;   // Proportional 8px text
+extern const sh1106_font_t sh1106_font_seg24;   // 12x24 seven-segment digits for gauges
+
+// Function prototypes
+const sh1106_glyph_t *sh1106_font_glyph(const sh1106_font_t *font, char c);
+uint8_t sh1106_font_char_width(const sh1106_font_t *font, char c);
+uint16_t sh1106_font_string_width(const sh1106_font_t *font, const char *str);
+uint8_t sh1106_font_draw_char(sh1106_t *display, const sh1106_font_t *font,
+                              uint8_t x, uint8_t y, char c, bool opaque);
+uint16_t sh1106_font_draw_string(sh1106_t *display, const sh1106_font_t *font,
+                                 uint8_t x, uint8_t y, const char *str, bool opaque);
+
+#endif // SH1106_FONT_H
@@ -0,0 +1,195 @@
+#include "../lib.h"
+
+// =============================================================================
+// Clips
+// =============================================================================
+
+hw_result_t led_clip_open(led_clip_t *clip, const uint32_t *blob, size_t words) {
+    if (!clip || !blob || words < LED_CLIP_HEADER_WORDS) {
+        return HW_INVALID_PARAM;
+    }
+
+    const led_clip_header_t *h = (const led_clip_header_t *)blob;
+    if (h->magic != LED_CLIP_MAGIC || h->version != LED_CLIP_VERSION ||
+        h->frame_words == 0 || h->frame_count == 0 ||
+        h->data_words > words - LED_CLIP_HEADER_WORDS) {
+        return HW_INVALID_PARAM;
+    }
+
+    switch (h->encoding) {
+        case LED_CLIP_RAW:
+            if ((uint64_t)h->frame_words * h->frame_count != h->data_words) {
+                return HW_INVALID_PARAM;
+            }
+            break;
+        case LED_CLIP_DELTA:
+            break;  // Records are bounds-checked as they are decoded
+        default:
+            return HW_INVALID_PARAM;
+    }
+
+    clip->header = h;
+    clip->data = blob + LED_CLIP_HEADER_WORDS;
+    clip->end = clip->data + h->data_words;
+    return HW_OK;
+}
+
+hw_result_t led_clip_check(const led_clip_t *clip, const hw_ws2812_t *strip) {
+    if (!clip || !clip->header || !strip || !strip->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    const led_clip_header_t *h = clip->header;
+    const hw_ws2812_config_t *cfg = &strip->config;
+    uint lanes = cfg->num_lanes > 1 ? cfg->num_lanes : 1;
+    if (h->num_pixels != cfg->num_pixels || h->num_lanes != lanes ||
+        h->bits != strip->channels * 8 || h->order != cfg->format.order ||
+        h->frame_words != strip->wire_words) {
+        return HW_INVALID_PARAM;
+    }
+    return HW_OK;
+}
+
+// =============================================================================
+// Playback
+// =============================================================================
+
+// Apply one delta record on top of the previous frame in wire[]; returns the
+// next record, or NULL if the record runs past the clip or the frame
+static const uint32_t *decode_delta(const uint32_t *rec, const uint32_t *end, uint32_t *wire, uint32_t words) {
+    if (rec >= end || rec[0] > (uint32_t)(end - rec - 1)) return NULL;
+    const uint32_t *op = rec + 1;
+    const uint32_t *stop = op + rec[0];
+    uint32_t pos = 0;
+
+    while (op < stop) {
+        uint32_t code = *op >> LED_CLIP_OP_SHIFT;
+        uint32_t count = *op++ & LED_CLIP_COUNT_MASK;
+        if (count > words - pos) return NULL;
+
+        switch (code) {
+            case LED_CLIP_OP_SKIP:
+                break;
+            case LED_CLIP_OP_COPY:
+                if (count > (uint32_t)(stop - op)) return NULL;
+                memcpy(&wire[pos], op, count * sizeof(uint32_t));
+                op += count;
+                break;
+            case LED_CLIP_OP_FILL: {
+                if (op >= stop) return NULL;
+                uint32_t v = *op++;
+                for (uint32_t i = 0; i < count; i++) wire[pos + i] = v;
+                break;
+            }
+            default:
+                return NULL;
+        }
+        pos += count;
+    }
+    return stop;
+}
+
+hw_result_t led_clip_player_init(led_clip_player_t *player, hw_ws2812_t *strip, const led_clip_t *clip, bool loop) {
+    if (!player || led_clip_check(clip, strip) != HW_OK) {
+        return HW_INVALID_PARAM;
+    }
+
+    memset(player, 0, sizeof(*player));
+    player->strip = strip;
+    player->clip = *clip;
+    player->cursor = clip->data;
+    player->loop = loop;
+    return HW_OK;
+}
+
+hw_result_t led_clip_step(led_clip_player_t *player) {
+    const led_clip_header_t *h = player->clip.header;
+    hw_ws2812_t *strip = player->strip;
+
+    if (player->frame == h->frame_count) {
+        if (!player->loop) return HW_TIMEOUT;
+        player->frame = 0;
+        player->cursor = player->clip.data;
+    }
+
+    // The back buffer and the previous frame's source are in use until it latches
+    if (hw_ws2812_is_busy(strip)) {
+        player->late++;
+        return HW_BUSY;
+    }
+
+    const uint32_t *frame;
+    if (h->encoding == LED_CLIP_RAW) {
+        frame = player->cursor;
+        player->cursor += h->frame_words;
+    } else {
+        const uint32_t *next = decode_delta(player->cursor, player->clip.end, strip->wire, h->frame_words);
+        if (!next) return HW_ERROR;
+        frame = strip->wire;
+        player->cursor = next;
+    }
+
+    hw_result_t result = hw_ws2812_show_wire(strip, frame, h->frame_words);
+    if (result == HW_OK) {
+        player->frame++;
+        player->frames_shown++;
+    }
+    return result;
+}
+
+static bool clip_timer_callback(repeating_timer_t *timer) {
+    led_clip_player_t *player = (led_clip_player_t *)timer->user_data;
+    hw_result_t result = led_clip_step(player);
+    if (result == HW_TIMEOUT || result == HW_ERROR || result == HW_INVALID_PARAM) {
+        player->playing = false;
+        player->strip->player_attached = false;
+        return false;  // Stop the timer
+    }
+    return true;
+}
+
+hw_result_t led_clip_play(led_clip_player_t *player, hw_ws2812_t *strip, const led_clip_t *clip, bool loop) {
+    if (player && player->playing) {
+        led_clip_stop(player);
+    }
+
+    hw_result_t result = led_clip_player_init(player, strip, clip, loop);
+    if (result != HW_OK) {
+        return result;
+    }
+
+    if (player->clip.header->frame_us == 0) {
+        return HW_INVALID_PARAM;
+    }
+
+    // Timer callbacks must never block, so blocking output is not an option
+    if (strip->dma_chan < 0) {
+        return HW_ERROR;
+    }
+
+    // Another player already streams into this strip's back buffer
+    if (strip->player_attached) {
+        return HW_BUSY;
+    }
+
+    // Negative interval: start-to-start, so decode time does not stretch frames
+    player->playing = true;
+    strip->player_attached = true;
+    if (!add_repeating_timer_us(-(int64_t)player->clip.header->frame_us, clip_timer_callback, player, &player->timer)) {
+        player->playing = false;
+        strip->player_attached = false;
+        return HW_ERROR;
+    }
+    return HW_OK;
+}
+
+void led_clip_stop(led_clip_player_t *player) {
+    if (!player || !player->playing) return;
+    cancel_repeating_timer(&player->timer);
+    player->playing = false;
+    player->strip->player_attached = false;
+}
+
+bool led_clip_is_playing(const led_clip_player_t *player) {
+    return player && player->playing;
+}
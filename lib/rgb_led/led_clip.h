@@ -0,0 +1,157 @@
+/**
+ * @file led_clip.h
+ * @brief Pre-encoded WS2812 animation clips played back by DMA
+ *
+ * A clip is a looping animation whose frames are stored as the exact 32-bit
+ * words the WS2812 state machine consumes, so playback skips rendering,
+ * the output pipeline and wire encoding entirely. Clips are produced on the
+ * host by tools/ws2812clip.py and normally live in flash as a const array.
+ *
+ * Raw clips are streamed by DMA straight from flash: a frame costs one DMA
+ * start. Delta clips store frame 0 as a keyframe and later frames as edits
+ * against the previous one (skip / copy / fill runs); they are decoded into
+ * the strip's back buffer, which still holds the previous frame, so a frame
+ * costs roughly one copy of the words that changed.
+ *
+ * While a clip plays, the player owns the strip: hw_ws2812_show returns
+ * HW_BUSY until led_clip_stop (or the end of a non-looping clip), so the
+ * back buffer a delta clip edits in place is never overwritten. With manual
+ * pacing (led_clip_player_init + led_clip_step) the caller keeps that rule.
+ *
+ * Brightness and gamma are baked in by the encoder; the strip's own output
+ * pipeline settings do not apply to clip frames.
+ */
+
+#ifndef PICO_HW_LED_CLIP_H
+#define PICO_HW_LED_CLIP_H
+
+#include "ws2812.h"
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Clip magic: "CLIP" in little-endian byte order */
+#define LED_CLIP_MAGIC 0x50494C43u
+
+/** Format version written by tools/ws2812clip.py */
+#define LED_CLIP_VERSION 1
+
+/** Words in led_clip_header_t */
+#define LED_CLIP_HEADER_WORDS 7
+
+/** Delta op word: 2-bit opcode in bits 31..30, run length in bits 29..0 */
+#define LED_CLIP_OP_SKIP  0u  ///< Keep count words of the previous frame
+#define LED_CLIP_OP_COPY  1u  ///< count literal words follow
+#define LED_CLIP_OP_FILL  2u  ///< One word follows, repeated count times
+#define LED_CLIP_OP_SHIFT 30
+#define LED_CLIP_COUNT_MASK 0x3FFFFFFFu
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Frame storage */
+typedef enum {
+    LED_CLIP_RAW = 0,    ///< frame_count * frame_words wire words
+    LED_CLIP_DELTA = 1,  ///< Per frame: op-word count, then ops (frame 0 has no skips)
+} led_clip_encoding_t;
+
+/** Clip header, at the start of the blob (little-endian, word-aligned) */
+typedef struct {
+    uint32_t magic;         ///< LED_CLIP_MAGIC
+    uint8_t version;        ///< LED_CLIP_VERSION
+    uint8_t encoding;       ///< led_clip_encoding_t
+    uint8_t bits;           ///< Wire bits per pixel (24 or 32)
+    uint8_t order;          ///< hw_ws2812_order_t the frames were encoded for
+    uint16_t num_pixels;    ///< Pixels per lane
+    uint16_t num_lanes;     ///< Parallel lanes (1 for a single strip)
+    uint32_t frame_words;   ///< Wire words per frame (the strip's wire_words)
+    uint32_t frame_count;   ///< Frames in the clip
+    uint32_t frame_us;      ///< Frame interval
+    uint32_t data_words;    ///< Words of frame data following the header
+} led_clip_header_t;
+
+/** Validated view of a clip blob */
+typedef struct {
+    const led_clip_header_t *header;  ///< Header
+    const uint32_t *data;             ///< Frame data
+    const uint32_t *end;              ///< One past the last data word
+} led_clip_t;
+
+/** Clip player state (keep static: the playback timer refers to it) */
+typedef struct {
+    hw_ws2812_t *strip;          ///< Output strip
+    led_clip_t clip;             ///< Clip being played
+    const uint32_t *cursor;      ///< Next frame (raw: wire words, delta: frame record)
+    uint32_t frame;              ///< Index of the next frame
+    bool loop;                   ///< Restart at frame 0 after the last frame
+    volatile bool playing;       ///< Playback timer running
+    uint32_t frames_shown;       ///< Frames started
+    uint32_t late;               ///< Ticks skipped because the previous frame was still in flight
+    repeating_timer_t timer;     ///< Frame timer
+} led_clip_player_t;
+
+// =============================================================================
+// API Functions
+// =============================================================================
+
+/**
+ * Validate a clip blob
+ * @param clip View to initialize
+ * @param blob Clip words (header followed by frame data)
+ * @param words Words in blob
+ * @return HW_INVALID_PARAM on a bad magic, version or size
+ */
+hw_result_t led_clip_open(led_clip_t *clip, const uint32_t *blob, size_t words);
+
+/**
+ * Check that a clip was encoded for a strip's wire format
+ * @return HW_OK if pixel count, lanes, bit depth and byte order match
+ */
+hw_result_t led_clip_check(const led_clip_t *clip, const hw_ws2812_t *strip);
+
+/**
+ * Prepare a player at frame 0 without starting playback (for led_clip_step)
+ * @param player Player state
+ * @param strip Initialized strip
+ * @param clip Opened clip matching the strip
+ * @param loop Restart at frame 0 after the last frame
+ * @return HW_INVALID_PARAM if the clip does not match the strip
+ */
+hw_result_t led_clip_player_init(led_clip_player_t *player, hw_ws2812_t *strip, const led_clip_t *clip, bool loop);
+
+/**
+ * Start background playback on a repeating timer
+ * @param player Player state (static storage)
+ * @param strip Initialized strip with a DMA channel
+ * @param clip Opened clip matching the strip
+ * @param loop Repeat forever rather than stopping after the last frame
+ * @return HW_OK, HW_INVALID_PARAM on a mismatched clip, HW_BUSY if another
+ *         player is attached to the strip, HW_ERROR if the strip has no DMA
+ *         channel or no timer is available
+ */
+hw_result_t led_clip_play(led_clip_player_t *player, hw_ws2812_t *strip, const led_clip_t *clip, bool loop);
+
+/**
+ * Stop playback and release the strip to hw_ws2812_show (the frame on the
+ * wire completes)
+ */
+void led_clip_stop(led_clip_player_t *player);
+
+/**
+ * Check whether playback is running
+ */
+bool led_clip_is_playing(const led_clip_player_t *player);
+
+/**
+ * Start the next frame now (what the playback timer calls); for manual
+ * pacing, use it with led_clip_player_init instead of led_clip_play
+ * @param player Player state
+ * @return HW_OK, HW_BUSY if the previous frame is still in flight (the
+ *         frame is kept for the next call), HW_TIMEOUT after the last frame
+ *         of a non-looping clip, HW_ERROR on corrupt delta data
+ */
+hw_result_t led_clip_step(led_clip_player_t *player);
+
+#endif // PICO_HW_LED_CLIP_H
@@ -0,0 +1,423 @@
+#include "../lib.h"
+
+// Fire: sparks ignite within this many pixels of the start of the strip
+#define FIRE_SPARK_ZONE 7
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline uint32_t rng_next(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline uint8_t qadd8(uint8_t a, uint8_t b) {
+    uint16_t s = a + b;
+    return s > 255 ? 255 : (uint8_t)s;
+}
+
+static inline uint8_t qsub8(uint8_t a, uint8_t b) {
+    return a > b ? a - b : 0;
+}
+
+// Scale a per-second rate to elapsed time with frac_bits of fraction
+static inline uint32_t rate_advance(uint16_t per_second, uint32_t dt_ms, uint8_t frac_bits) {
+    return (uint32_t)((((uint64_t)per_second * dt_ms) << frac_bits) / 1000);
+}
+
+// Black-body style ramp: black -> red -> yellow -> white
+static led_rgb_t heat_color(uint8_t heat) {
+    uint8_t t = (uint8_t)((heat * 192) >> 8);
+    uint8_t ramp = (uint8_t)((t & 0x3F) << 2);
+    led_rgb_t c;
+    if (t & 0x80) {
+        c.r = 255; c.g = 255; c.b = ramp;
+    } else if (t & 0x40) {
+        c.r = 255; c.g = ramp; c.b = 0;
+    } else {
+        c.r = ramp; c.g = 0; c.b = 0;
+    }
+    return c;
+}
+
+static inline uint8_t blend_channel(led_blend_t mode, uint8_t dst, uint8_t src) {
+    switch (mode) {
+        case LED_BLEND_ADD:      return qadd8(dst, src);
+        case LED_BLEND_MULTIPLY: return (uint8_t)((dst * (src + 1)) >> 8);
+        case LED_BLEND_SCREEN:   return (uint8_t)(255 - (((255 - dst) * (256 - src)) >> 8));
+        case LED_BLEND_LIGHTEN:  return dst > src ? dst : src;
+        case LED_BLEND_NORMAL:
+        default:                 return src;
+    }
+}
+
+// =============================================================================
+// Color Helpers
+// =============================================================================
+
+led_rgb_t led_hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v) {
+    led_rgb_t c;
+    if (s == 0) {
+        c.r = c.g = c.b = v;
+        return c;
+    }
+
+    // Six sectors of 43 hue steps; remainder scaled to 0-252
+    uint8_t region = h / 43;
+    uint8_t rem = (uint8_t)((h - region * 43) * 6);
+
+    uint8_t p = (uint8_t)((v * (255 - s)) >> 8);
+    uint8_t q = (uint8_t)((v * (255 - ((s * rem) >> 8))) >> 8);
+    uint8_t t = (uint8_t)((v * (255 - ((s * (255 - rem)) >> 8))) >> 8);
+
+    switch (region) {
+        case 0:  c.r = v; c.g = t; c.b = p; break;
+        case 1:  c.r = q; c.g = v; c.b = p; break;
+        case 2:  c.r = p; c.g = v; c.b = t; break;
+        case 3:  c.r = p; c.g = q; c.b = v; break;
+        case 4:  c.r = t; c.g = p; c.b = v; break;
+        default: c.r = v; c.g = p; c.b = q; break;
+    }
+    return c;
+}
+
+led_rgb_t led_palette_sample(const led_palette_t *palette, uint8_t pos) {
+    uint16_t scaled = (uint16_t)(pos * palette->count);
+    uint8_t idx = scaled >> 8;
+    uint8_t next = (idx + 1 < palette->count) ? idx + 1 : 0;
+    return led_blend(palette->colors[idx], palette->colors[next], scaled & 0xFF);
+}
+
+void led_fill_gradient(led_rgb_t *buf, uint16_t count, led_rgb_t a, led_rgb_t b) {
+    if (count == 0) return;
+    if (count == 1) {
+        buf[0] = a;
+        return;
+    }
+
+    // 16.16 accumulator, rounded up so the last pixel lands exactly on b
+    uint32_t step = ((255u << 16) + count - 2) / (count - 1);
+    uint32_t acc = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = led_blend(a, b, (uint8_t)(acc >> 16));
+        acc += step;
+    }
+}
+
+void led_fill_rainbow(led_rgb_t *buf, uint16_t count, uint8_t hue, uint8_t delta) {
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = led_hsv_to_rgb(hue, 255, 255);
+        hue += delta;
+    }
+}
+
+void led_fill_palette(led_rgb_t *buf, uint16_t count, const led_palette_t *palette, uint8_t pos, uint8_t delta) {
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = led_palette_sample(palette, pos);
+        pos += delta;
+    }
+}
+
+void led_fade(led_rgb_t *buf, uint16_t count, uint8_t amount) {
+    uint8_t keep = 255 - amount;
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = led_scale(buf[i], keep);
+    }
+}
+
+// =============================================================================
+// Effects
+// =============================================================================
+
+static void effect_reset(led_effect_t *fx, led_effect_type_t type) {
+    memset(fx, 0, sizeof(*fx));
+    fx->type = type;
+    fx->rng = 0x2545F491u;
+}
+
+void led_effect_solid(led_effect_t *fx, led_rgb_t color) {
+    effect_reset(fx, LED_EFFECT_SOLID);
+    fx->color = color;
+}
+
+void led_effect_gradient(led_effect_t *fx, led_rgb_t from, led_rgb_t to) {
+    effect_reset(fx, LED_EFFECT_GRADIENT);
+    fx->color = from;
+    fx->color2 = to;
+}
+
+void led_effect_rainbow(led_effect_t *fx, uint16_t speed, uint8_t spread) {
+    effect_reset(fx, LED_EFFECT_RAINBOW);
+    fx->speed = speed;
+    fx->size = spread;
+}
+
+void led_effect_palette(led_effect_t *fx, const led_palette_t *palette, uint16_t speed, uint8_t spread) {
+    effect_reset(fx, LED_EFFECT_PALETTE);
+    fx->palette = palette;
+    fx->speed = speed;
+    fx->size = spread;
+}
+
+void led_effect_chase(led_effect_t *fx, led_rgb_t color, uint8_t size, uint16_t speed, uint8_t fade) {
+    effect_reset(fx, LED_EFFECT_CHASE);
+    fx->color = color;
+    fx->size = size ? size : 1;
+    fx->speed = speed;
+    fx->fade = fade;
+}
+
+void led_effect_fire(led_effect_t *fx, uint8_t *heat, uint8_t cooling, uint8_t sparking) {
+    effect_reset(fx, LED_EFFECT_FIRE);
+    fx->heat = heat;
+    fx->fade = cooling;
+    fx->density = sparking;
+}
+
+void led_effect_twinkle(led_effect_t *fx, led_rgb_t color, uint8_t density, uint8_t fade) {
+    effect_reset(fx, LED_EFFECT_TWINKLE);
+    fx->color = color;
+    fx->density = density;
+    fx->fade = fade;
+}
+
+void led_effect_breathing(led_effect_t *fx, led_rgb_t color, uint32_t period_ms) {
+    effect_reset(fx, LED_EFFECT_BREATHING);
+    fx->color = color;
+    fx->period_ms = period_ms ? period_ms : 1;
+}
+
+// Chase: paint from the previous head to the new one so fast movement leaves
+// a continuous trail instead of gaps
+static void render_chase(led_effect_t *fx, led_rgb_t *buf, uint16_t count, uint32_t dt_ms) {
+    uint32_t wrap = (uint32_t)count << 16;
+    uint16_t from = fx->phase >> 16;
+
+    fx->phase += rate_advance(fx->speed, dt_ms, 16);
+    fx->phase %= wrap;
+    uint16_t head = fx->phase >> 16;
+
+    uint32_t len = ((head + count - from) % count) + fx->size;
+    if (len > count) len = count;
+
+    led_fade(buf, count, fx->fade);
+    for (uint32_t i = 0, idx = from; i < len; i++) {
+        buf[idx] = fx->color;
+        if (++idx == count) idx = 0;
+    }
+}
+
+// Fire2012: cool, drift heat away from the start, spark, then map to color
+static void render_fire(led_effect_t *fx, led_rgb_t *buf, uint16_t count) {
+    uint8_t *heat = fx->heat;
+    uint32_t cool_max = (fx->fade * 10u) / count + 2;
+    if (cool_max > 255) cool_max = 255;
+
+    for (uint16_t i = 0; i < count; i++) {
+        heat[i] = qsub8(heat[i], (uint8_t)(rng_next(&fx->rng) % (cool_max + 1)));
+    }
+
+    for (uint16_t k = count - 1; k >= 2; k--) {
+        heat[k] = (uint8_t)((heat[k - 1] + 2 * heat[k - 2]) / 3);
+    }
+
+    uint32_t r = rng_next(&fx->rng);
+    if ((r & 0xFF) < fx->density) {
+        uint16_t zone = count < FIRE_SPARK_ZONE ? count : FIRE_SPARK_ZONE;
+        uint16_t y = ((r >> 8) & 0xFF) % zone;
+        heat[y] = qadd8(heat[y], 160 + ((r >> 16) % 96));
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = heat_color(heat[i]);
+    }
+}
+
+// Twinkle: fade the previous frame, then ignite pixels (one random byte each,
+// four pixels per generator step)
+static void render_twinkle(led_effect_t *fx, led_rgb_t *buf, uint16_t count) {
+    led_fade(buf, count, fx->fade);
+
+    uint32_t r = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if ((i & 3) == 0) r = rng_next(&fx->rng);
+        if ((r & 0xFF) < fx->density) {
+            buf[i] = fx->color;
+        }
+        r >>= 8;
+    }
+}
+
+static void render_breathing(led_effect_t *fx, led_rgb_t *buf, uint16_t count, uint32_t dt_ms) {
+    fx->phase = (fx->phase + dt_ms) % fx->period_ms;
+
+    // Raised cosine starting dark: (1 - cos) / 2 scaled to 0-255
+    fxp_q15_t c = fxp_cos(fxp_angle_from_ratio((int32_t)fx->phase, (int32_t)fx->period_ms));
+    uint8_t level = (uint8_t)((FXP_Q15_ONE - c) >> 8);
+
+    led_rgb_t color = led_scale(fx->color, level);
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i] = color;
+    }
+}
+
+void led_effect_render(led_effect_t *fx, led_rgb_t *buf, uint16_t count, uint32_t dt_ms) {
+    if (!fx || !buf || count == 0) return;
+
+    switch (fx->type) {
+        case LED_EFFECT_SOLID:
+            for (uint16_t i = 0; i < count; i++) buf[i] = fx->color;
+            break;
+
+        case LED_EFFECT_GRADIENT:
+            led_fill_gradient(buf, count, fx->color, fx->color2);
+            break;
+
+        case LED_EFFECT_RAINBOW:
+            fx->phase += rate_advance(fx->speed, dt_ms, 8);
+            led_fill_rainbow(buf, count, (uint8_t)(fx->phase >> 8), fx->size);
+            break;
+
+        case LED_EFFECT_PALETTE:
+            if (!fx->palette || fx->palette->count == 0) return;
+            fx->phase += rate_advance(fx->speed, dt_ms, 8);
+            led_fill_palette(buf, count, fx->palette, (uint8_t)(fx->phase >> 8), fx->size);
+            break;
+
+        case LED_EFFECT_CHASE:
+            render_chase(fx, buf, count, dt_ms);
+            break;
+
+        case LED_EFFECT_FIRE:
+            if (!fx->heat) return;
+            render_fire(fx, buf, count);
+            break;
+
+        case LED_EFFECT_TWINKLE:
+            render_twinkle(fx, buf, count);
+            break;
+
+        case LED_EFFECT_BREATHING:
+            render_breathing(fx, buf, count, dt_ms);
+            break;
+    }
+}
+
+// =============================================================================
+// Engine
+// =============================================================================
+
+hw_result_t led_engine_init(led_engine_t *engine, hw_ws2812_t *strip, uint16_t fps) {
+    if (!engine || !strip || !strip->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    memset(engine, 0, sizeof(*engine));
+    engine->strip = strip;
+    engine->count = hw_ws2812_num_pixels(strip);
+    led_engine_set_fps(engine, fps);
+
+    engine->last_frame_us = hw_time_us();
+    engine->next_frame_us = engine->last_frame_us;
+    return HW_OK;
+}
+
+void led_engine_set_fps(led_engine_t *engine, uint16_t fps) {
+    if (!engine) return;
+    engine->frame_us = 1000000u / (fps ? fps : LED_ENGINE_DEFAULT_FPS);
+}
+
+hw_result_t led_engine_add_layer(led_engine_t *engine, led_effect_t *effect, led_rgb_t *buffer,
+                                 led_blend_t blend, uint8_t opacity) {
+    if (!engine || !effect || !buffer) {
+        return HW_INVALID_PARAM;
+    }
+    if (engine->num_layers >= LED_ENGINE_MAX_LAYERS) {
+        return HW_ERROR;
+    }
+
+    memset(buffer, 0, engine->count * sizeof(led_rgb_t));
+
+    led_layer_t *layer = &engine->layers[engine->num_layers++];
+    layer->effect = effect;
+    layer->buffer = buffer;
+    layer->blend = blend;
+    layer->opacity = opacity;
+    layer->enabled = true;
+    return HW_OK;
+}
+
+hw_result_t led_engine_set_layer_effect(led_engine_t *engine, uint8_t layer, led_effect_t *effect) {
+    if (!engine || !effect || layer >= engine->num_layers) {
+        return HW_INVALID_PARAM;
+    }
+    engine->layers[layer].effect = effect;
+    return HW_OK;
+}
+
+void led_engine_render(led_engine_t *engine, uint32_t dt_ms) {
+    if (!engine || !engine->strip) return;
+    uint64_t start = hw_time_us();
+
+    for (uint8_t l = 0; l < engine->num_layers; l++) {
+        led_layer_t *layer = &engine->layers[l];
+        if (layer->enabled) {
+            led_effect_render(layer->effect, layer->buffer, engine->count, dt_ms);
+        }
+    }
+
+    // Composite bottom to top over black, straight into the strip
+    for (uint16_t i = 0; i < engine->count; i++) {
+        led_rgb_t out = {0, 0, 0};
+        for (uint8_t l = 0; l < engine->num_layers; l++) {
+            const led_layer_t *layer = &engine->layers[l];
+            if (!layer->enabled || layer->opacity == 0) continue;
+
+            led_rgb_t src = layer->buffer[i];
+            led_rgb_t mixed = {
+                blend_channel(layer->blend, out.r, src.r),
+                blend_channel(layer->blend, out.g, src.g),
+                blend_channel(layer->blend, out.b, src.b),
+            };
+            out = (layer->opacity == 255) ? mixed : led_blend(out, mixed, layer->opacity);
+        }
+        hw_ws2812_set_pixel(engine->strip, i, out.r, out.g, out.b);
+    }
+
+    engine->render_us = (uint32_t)(hw_time_us() - start);
+}
+
+bool led_engine_task(led_engine_t *engine) {
+    if (!engine || !engine->strip) return false;
+
+    // While a clip player owns the strip, show would fail after rendering
+    uint64_t now = hw_time_us();
+    if (now < engine->next_frame_us || hw_ws2812_is_busy(engine->strip) ||
+        engine->strip->player_attached) {
+        return false;
+    }
+
+    // Whole milliseconds only; the remainder carries into the next frame
+    uint32_t dt_ms = (uint32_t)((now - engine->last_frame_us) / 1000);
+
+    led_engine_render(engine, dt_ms);
+    if (hw_ws2812_show(engine->strip) != HW_OK) {
+        return false;
+    }
+    engine->last_frame_us += (uint64_t)dt_ms * 1000;
+    engine->frames++;
+
+    // Stay on the frame grid; slots already missed are counted, not replayed
+    engine->next_frame_us += engine->frame_us;
+    if (now >= engine->next_frame_us) {
+        uint32_t missed = (uint32_t)((now - engine->next_frame_us) / engine->frame_us) + 1;
+        engine->dropped += missed;
+        engine->next_frame_us += (uint64_t)missed * engine->frame_us;
+    }
+    return true;
+}
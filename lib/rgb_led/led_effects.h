@@ -0,0 +1,266 @@
+/**
+ * @file led_effects.h
+ * @brief LED effects engine for WS2812 strips
+ *
+ * Fixed-point color helpers, a set of animated effects, layer compositing
+ * with blend modes and a non-blocking frame scheduler on top of hw_ws2812_t.
+ *
+ * Effects keep their own state and render incrementally into a caller-owned
+ * layer buffer: each tick advances them by the elapsed time, and effects
+ * such as chase, twinkle and fire evolve the previous frame rather than
+ * redrawing from scratch. All arithmetic is integer.
+ */
+
+#ifndef PICO_HW_LED_EFFECTS_H
+#define PICO_HW_LED_EFFECTS_H
+
+#include "ws2812.h"
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Maximum layers composited by one engine */
+#define LED_ENGINE_MAX_LAYERS 4
+
+/** Default frame rate for led_engine_init */
+#define LED_ENGINE_DEFAULT_FPS 60
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** 8-bit RGB color */
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} led_rgb_t;
+
+/** Palette of evenly spaced colors, sampled with interpolation (wraps around) */
+typedef struct {
+    const led_rgb_t *colors;  ///< Palette entries
+    uint8_t count;            ///< Number of entries (>= 1)
+} led_palette_t;
+
+/** Effect types */
+typedef enum {
+    LED_EFFECT_SOLID = 0,   ///< Constant color
+    LED_EFFECT_GRADIENT,    ///< Static linear gradient color -> color2
+    LED_EFFECT_RAINBOW,     ///< Scrolling hue wheel
+    LED_EFFECT_PALETTE,     ///< Scrolling palette
+    LED_EFFECT_CHASE,       ///< Moving block with a fading tail
+    LED_EFFECT_FIRE,        ///< Heat simulation (needs a heat buffer)
+    LED_EFFECT_TWINKLE,     ///< Random sparkles that fade out
+    LED_EFFECT_BREATHING,   ///< Whole strip pulsing in brightness
+} led_effect_type_t;
+
+/** Effect instance: parameters plus animation state */
+typedef struct {
+    led_effect_type_t type;       ///< Effect type
+    led_rgb_t color;              ///< Primary color
+    led_rgb_t color2;             ///< Secondary color (gradient end)
+    const led_palette_t *palette; ///< Palette (palette effect)
+    uint16_t speed;               ///< Rate: hue or palette steps/s, pixels/s (chase)
+    uint8_t size;                 ///< Chase block length, rainbow/palette spread per pixel
+    uint8_t fade;                 ///< Per-frame fade for trails (chase, twinkle), fire cooling
+    uint8_t density;              ///< Twinkle spawn chance, fire sparking chance (0-255)
+    uint32_t period_ms;           ///< Breathing period
+    uint32_t phase;               ///< Animation position (8.8 or 16.16, per effect)
+    uint32_t rng;                 ///< Random state (xorshift32)
+    uint8_t *heat;                ///< Fire heat map (one byte per pixel, caller-owned)
+} led_effect_t;
+
+/** Layer blend modes */
+typedef enum {
+    LED_BLEND_NORMAL = 0,   ///< Replace, weighted by opacity
+    LED_BLEND_ADD,          ///< Saturating add
+    LED_BLEND_MULTIPLY,     ///< Darken by multiplying
+    LED_BLEND_SCREEN,       ///< Lighten: 1 - (1 - a)(1 - b)
+    LED_BLEND_LIGHTEN,      ///< Per-channel maximum
+} led_blend_t;
+
+/** Compositing layer: an effect rendering into its own buffer */
+typedef struct {
+    led_effect_t *effect;   ///< Effect driving this layer
+    led_rgb_t *buffer;      ///< Layer pixels (strip length, caller-owned)
+    led_blend_t blend;      ///< Blend mode onto the layers below
+    uint8_t opacity;        ///< 0-255
+    bool enabled;           ///< Skipped when false
+} led_layer_t;
+
+/** Effects engine: layers, compositor and frame scheduler for one strip */
+typedef struct {
+    hw_ws2812_t *strip;                          ///< Output strip
+    uint16_t count;                              ///< Pixels rendered
+    led_layer_t layers[LED_ENGINE_MAX_LAYERS];   ///< Bottom to top
+    uint8_t num_layers;                          ///< Layers in use
+    uint32_t frame_us;                           ///< Frame interval
+    uint64_t next_frame_us;                      ///< Deadline of the next frame
+    uint64_t last_frame_us;                      ///< Time of the last rendered frame
+    uint32_t frames;                             ///< Frames shown
+    uint32_t dropped;                            ///< Frame slots skipped because the loop ran late
+    uint32_t render_us;                          ///< Cost of the last render + composite
+} led_engine_t;
+
+// =============================================================================
+// Color Helpers
+// =============================================================================
+
+/**
+ * Convert HSV to RGB (fixed point; hue wheel is 0-255)
+ * @param h Hue (0 = red, ~85 = green, ~170 = blue)
+ * @param s Saturation
+ * @param v Value
+ * @return RGB color
+ */
+led_rgb_t led_hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v);
+
+/**
+ * Scale a color by amount/256 (255 is near-identity)
+ */
+static inline led_rgb_t led_scale(led_rgb_t c, uint8_t amount) {
+    uint16_t k = amount + 1;
+    led_rgb_t out = { (uint8_t)((c.r * k) >> 8), (uint8_t)((c.g * k) >> 8), (uint8_t)((c.b * k) >> 8) };
+    return out;
+}
+
+/**
+ * Linear blend from a to b (0 = a, 255 = b)
+ */
+static inline led_rgb_t led_blend(led_rgb_t a, led_rgb_t b, uint8_t amount) {
+    int k = amount + (amount >> 7);  // 0-256
+    led_rgb_t out = {
+        (uint8_t)(a.r + (((b.r - a.r) * k) >> 8)),
+        (uint8_t)(a.g + (((b.g - a.g) * k) >> 8)),
+        (uint8_t)(a.b + (((b.b - a.b) * k) >> 8)),
+    };
+    return out;
+}
+
+/**
+ * Sample a palette with interpolation between entries
+ * @param palette Palette
+ * @param pos Position around the palette (0-255, wraps to the first entry)
+ * @return Interpolated color
+ */
+led_rgb_t led_palette_sample(const led_palette_t *palette, uint8_t pos);
+
+/**
+ * Fill with a linear gradient from a (first pixel) to b (last pixel)
+ */
+void led_fill_gradient(led_rgb_t *buf, uint16_t count, led_rgb_t a, led_rgb_t b);
+
+/**
+ * Fill with a hue wheel starting at hue, advancing delta per pixel
+ */
+void led_fill_rainbow(led_rgb_t *buf, uint16_t count, uint8_t hue, uint8_t delta);
+
+/**
+ * Fill from a palette starting at pos, advancing delta per pixel
+ */
+void led_fill_palette(led_rgb_t *buf, uint16_t count, const led_palette_t *palette, uint8_t pos, uint8_t delta);
+
+/**
+ * Fade every pixel toward black by amount/256
+ */
+void led_fade(led_rgb_t *buf, uint16_t count, uint8_t amount);
+
+// =============================================================================
+// Effects
+// =============================================================================
+
+/** Constant color */
+void led_effect_solid(led_effect_t *fx, led_rgb_t color);
+
+/** Static gradient */
+void led_effect_gradient(led_effect_t *fx, led_rgb_t from, led_rgb_t to);
+
+/**
+ * Scrolling rainbow
+ * @param speed Hue steps per second
+ * @param spread Hue step between neighbouring pixels
+ */
+void led_effect_rainbow(led_effect_t *fx, uint16_t speed, uint8_t spread);
+
+/** Scrolling palette (speed in palette steps per second, spread per pixel) */
+void led_effect_palette(led_effect_t *fx, const led_palette_t *palette, uint16_t speed, uint8_t spread);
+
+/**
+ * Chase: a block of size pixels moving at speed pixels/s, leaving a trail
+ * that fades by fade/256 each frame
+ */
+void led_effect_chase(led_effect_t *fx, led_rgb_t color, uint8_t size, uint16_t speed, uint8_t fade);
+
+/**
+ * Fire (after Fire2012): heat cools by up to cooling each frame, drifts
+ * along the strip, and new sparks ignite at the start with chance sparking/256
+ * @param heat Heat buffer, one byte per pixel (caller-owned)
+ */
+void led_effect_fire(led_effect_t *fx, uint8_t *heat, uint8_t cooling, uint8_t sparking);
+
+/** Twinkle: each pixel ignites with chance density/256 per frame, fading by fade/256 */
+void led_effect_twinkle(led_effect_t *fx, led_rgb_t color, uint8_t density, uint8_t fade);
+
+/** Breathing: whole strip pulses over period_ms */
+void led_effect_breathing(led_effect_t *fx, led_rgb_t color, uint32_t period_ms);
+
+/**
+ * Advance an effect by dt_ms and update buf in place
+ * @param fx Effect
+ * @param buf Layer buffer (keeps the previous frame between calls)
+ * @param count Pixels in buf
+ * @param dt_ms Time since the previous call
+ */
+void led_effect_render(led_effect_t *fx, led_rgb_t *buf, uint16_t count, uint32_t dt_ms);
+
+// =============================================================================
+// Engine
+// =============================================================================
+
+/**
+ * Initialize an engine for a strip
+ * @param engine Engine instance
+ * @param strip Initialized WS2812 strip (all lanes are rendered as one chain)
+ * @param fps Target frame rate (0 for LED_ENGINE_DEFAULT_FPS)
+ * @return HW_OK on success
+ */
+hw_result_t led_engine_init(led_engine_t *engine, hw_ws2812_t *strip, uint16_t fps);
+
+/**
+ * Set the target frame rate
+ */
+void led_engine_set_fps(led_engine_t *engine, uint16_t fps);
+
+/**
+ * Add a layer on top of the existing ones
+ * @param buffer Layer buffer of engine->count pixels (cleared here)
+ * @return HW_ERROR if LED_ENGINE_MAX_LAYERS are in use
+ */
+hw_result_t led_engine_add_layer(led_engine_t *engine, led_effect_t *effect, led_rgb_t *buffer,
+                                 led_blend_t blend, uint8_t opacity);
+
+/**
+ * Switch the effect driving a layer; the layer keeps its buffer, blend and
+ * opacity, so the new effect starts from the old one's pixels
+ * @param layer Layer index, 0 = bottom
+ * @return HW_INVALID_PARAM if the layer has not been added
+ */
+hw_result_t led_engine_set_layer_effect(led_engine_t *engine, uint8_t layer, led_effect_t *effect);
+
+/**
+ * Render all layers by dt_ms and composite them into the strip's pixel
+ * buffer, without sending (led_engine_task calls this)
+ */
+void led_engine_render(led_engine_t *engine, uint32_t dt_ms);
+
+/**
+ * Non-blocking scheduler: call from the main loop. Renders and starts a
+ * frame when one is due and the strip is idle; otherwise returns at once.
+ * Effects are advanced by the time since the last frame actually sent, and
+ * nothing is rendered while a clip player holds the strip.
+ * @return true if a frame was started
+ */
+bool led_engine_task(led_engine_t *engine);
+
+#endif // PICO_HW_LED_EFFECTS_H
@@ -0,0 +1,235 @@
+#include "../lib.h"
+
+// Every index reaching put() is in range: map entries are checked by
+// led_matrix_init and zone bounds by led_zone_init. So with no output
+// pipeline the loops store straight into pixels[] (0xWWRRGGBB). With one,
+// they go through hw_ws2812_set_pixel, which keeps the pipeline's linear
+// copy in step.
+
+// Pixel buffer to write directly, or NULL to go through the strip's API
+static inline uint32_t *direct_pixels(hw_ws2812_t *strip) {
+    return strip->work ? NULL : strip->pixels;
+}
+
+static inline uint32_t pack(led_rgb_t c) {
+    return ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b;
+}
+
+static inline void put(hw_ws2812_t *strip, uint32_t *pixels, uint16_t index, uint32_t color) {
+    if (pixels) {
+        pixels[index] = color;
+    } else {
+        hw_ws2812_set_pixel(strip, index, (uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color);
+    }
+}
+
+// =============================================================================
+// Maps
+// =============================================================================
+
+hw_result_t led_map_init(led_map_t *map, uint16_t *lut, size_t lut_len, const led_layout_t *layout) {
+    if (!map || !lut || !layout || layout->tile_width == 0 || layout->tile_height == 0) {
+        return HW_INVALID_PARAM;
+    }
+
+    uint32_t tw = layout->tile_width;
+    uint32_t th = layout->tile_height;
+    uint32_t tiles_x = layout->tiles_x ? layout->tiles_x : 1;
+    uint32_t tiles_y = layout->tiles_y ? layout->tiles_y : 1;
+    uint32_t pw = tw * tiles_x;
+    uint32_t ph = th * tiles_y;
+    if (pw > UINT16_MAX || ph > UINT16_MAX ||
+        (uint32_t)layout->first_index + pw * ph > UINT16_MAX + 1u ||
+        lut_len < (size_t)pw * ph) {
+        return HW_INVALID_PARAM;
+    }
+
+    bool swap = layout->rotation == LED_ROTATE_90 || layout->rotation == LED_ROTATE_270;
+    uint16_t w = swap ? ph : pw;
+    uint16_t h = swap ? pw : ph;
+
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t lx = layout->flip_x ? w - 1 - x : x;
+            uint32_t ly = layout->flip_y ? h - 1 - y : y;
+
+            // Logical view to physical panel coordinates
+            uint32_t px, py;
+            switch (layout->rotation) {
+                case LED_ROTATE_90:  px = pw - 1 - ly; py = lx;          break;
+                case LED_ROTATE_180: px = pw - 1 - lx; py = ph - 1 - ly; break;
+                case LED_ROTATE_270: px = ly;          py = ph - 1 - lx; break;
+                default:             px = lx;          py = ly;          break;
+            }
+
+            // Panel coordinates to tile, then to position along the tile's chain
+            uint32_t tx = px / tw, ty = py / th;
+            uint32_t cx = px % tw, cy = py % th;
+            if (layout->tile_serpentine && (ty & 1)) {
+                tx = tiles_x - 1 - tx;
+            }
+
+            uint32_t within;
+            if (layout->column_major) {
+                if (layout->serpentine && (cx & 1)) cy = th - 1 - cy;
+                within = cx * th + cy;
+            } else {
+                if (layout->serpentine && (cy & 1)) cx = tw - 1 - cx;
+                within = cy * tw + cx;
+            }
+
+            lut[y * w + x] = (uint16_t)(layout->first_index + (ty * tiles_x + tx) * tw * th + within);
+        }
+    }
+
+    map->width = w;
+    map->height = h;
+    map->lut = lut;
+    return HW_OK;
+}
+
+// =============================================================================
+// Matrix
+// =============================================================================
+
+hw_result_t led_matrix_init(led_matrix_t *matrix, hw_ws2812_t *strip, const led_map_t *map) {
+    if (!matrix || !strip || !map || !map->lut) {
+        return HW_INVALID_PARAM;
+    }
+
+    uint num_pixels = hw_ws2812_num_pixels(strip);
+    uint32_t n = (uint32_t)map->width * map->height;
+    for (uint32_t i = 0; i < n; i++) {
+        if (map->lut[i] >= num_pixels) {
+            return HW_INVALID_PARAM;
+        }
+    }
+
+    matrix->strip = strip;
+    matrix->map = map;
+    matrix->color = (led_rgb_t){255, 255, 255};
+    return HW_OK;
+}
+
+void led_matrix_set_pixel(led_matrix_t *matrix, int16_t x, int16_t y, led_rgb_t color) {
+    const led_map_t *map = matrix->map;
+    if ((unsigned)x >= map->width || (unsigned)y >= map->height) return;
+    put(matrix->strip, direct_pixels(matrix->strip), led_map_index(map, x, y), pack(color));
+}
+
+void led_matrix_fill(led_matrix_t *matrix, led_rgb_t color) {
+    const led_map_t *map = matrix->map;
+    uint32_t *pixels = direct_pixels(matrix->strip);
+    uint32_t packed = pack(color);
+    uint32_t n = (uint32_t)map->width * map->height;
+    for (uint32_t i = 0; i < n; i++) {
+        put(matrix->strip, pixels, map->lut[i], packed);
+    }
+}
+
+void led_matrix_fill_rect(led_matrix_t *matrix, int16_t x, int16_t y, uint16_t w, uint16_t h, led_rgb_t color) {
+    const led_map_t *map = matrix->map;
+    int x0 = MAX(x, 0);
+    int y0 = MAX(y, 0);
+    int x1 = MIN(x + w, map->width);
+    int y1 = MIN(y + h, map->height);
+    uint32_t *pixels = direct_pixels(matrix->strip);
+    uint32_t packed = pack(color);
+
+    for (int row = y0; row < y1; row++) {
+        const uint16_t *lut = &map->lut[(uint32_t)row * map->width];
+        for (int col = x0; col < x1; col++) {
+            put(matrix->strip, pixels, lut[col], packed);
+        }
+    }
+}
+
+void led_matrix_blit(led_matrix_t *matrix, int16_t x, int16_t y, const led_rgb_t *src, uint16_t w, uint16_t h) {
+    const led_map_t *map = matrix->map;
+    if (!src) return;
+    int x0 = MAX(x, 0);
+    int y0 = MAX(y, 0);
+    int x1 = MIN(x + w, map->width);
+    int y1 = MIN(y + h, map->height);
+    uint32_t *pixels = direct_pixels(matrix->strip);
+
+    for (int row = y0; row < y1; row++) {
+        const uint16_t *lut = &map->lut[(uint32_t)row * map->width];
+        const led_rgb_t *s = &src[(uint32_t)(row - y) * w + (x0 - x)];
+        for (int col = x0; col < x1; col++) {
+            put(matrix->strip, pixels, lut[col], pack(*s++));
+        }
+    }
+}
+
+static void matrix_plot(void *ctx, int16_t x, int16_t y) {
+    led_matrix_t *matrix = ctx;
+    put(matrix->strip, direct_pixels(matrix->strip), led_map_index(matrix->map, x, y), pack(matrix->color));
+}
+
+static void matrix_span(void *ctx, int16_t x0, int16_t x1, int16_t y) {
+    led_matrix_t *matrix = ctx;
+    const uint16_t *lut = &matrix->map->lut[(uint32_t)y * matrix->map->width];
+    uint32_t *pixels = direct_pixels(matrix->strip);
+    uint32_t packed = pack(matrix->color);
+    for (int x = x0; x <= x1; x++) {
+        put(matrix->strip, pixels, lut[x], packed);
+    }
+}
+
+gfx_target_t led_matrix_target(led_matrix_t *matrix) {
+    gfx_target_t target = {
+        .width = (int16_t)matrix->map->width,
+        .height = (int16_t)matrix->map->height,
+        .plot = matrix_plot,
+        .span = matrix_span,
+        .bbox = NULL,
+        .ctx = matrix,
+    };
+    return target;
+}
+
+// =============================================================================
+// Zones
+// =============================================================================
+
+hw_result_t led_zone_init(led_zone_t *zone, hw_ws2812_t *strip, uint16_t start, uint16_t count, bool reverse) {
+    if (!zone || !strip || (uint32_t)start + count > hw_ws2812_num_pixels(strip)) {
+        return HW_INVALID_PARAM;
+    }
+
+    zone->strip = strip;
+    zone->start = start;
+    zone->count = count;
+    zone->reverse = reverse;
+    return HW_OK;
+}
+
+void led_zone_set_pixel(const led_zone_t *zone, uint16_t index, led_rgb_t color) {
+    if (index >= zone->count) return;
+    put(zone->strip, direct_pixels(zone->strip),
+        zone->reverse ? zone->start + zone->count - 1 - index : zone->start + index, pack(color));
+}
+
+void led_zone_fill(const led_zone_t *zone, led_rgb_t color) {
+    uint32_t *pixels = direct_pixels(zone->strip);
+    uint32_t packed = pack(color);
+    for (uint16_t i = 0; i < zone->count; i++) {
+        put(zone->strip, pixels, zone->start + i, packed);
+    }
+}
+
+void led_zone_blit(const led_zone_t *zone, const led_rgb_t *src) {
+    if (!src) return;
+    uint32_t *pixels = direct_pixels(zone->strip);
+    if (zone->reverse) {
+        uint16_t idx = zone->start + zone->count - 1;
+        for (uint16_t i = 0; i < zone->count; i++) {
+            put(zone->strip, pixels, idx--, pack(src[i]));
+        }
+    } else {
+        for (uint16_t i = 0; i < zone->count; i++) {
+            put(zone->strip, pixels, zone->start + i, pack(src[i]));
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @file led_matrix.h
+ * @brief Zone and 2D matrix addressing for WS2812 strips
+ *
+ * A led_map_t is a precomputed lookup table from logical (x, y) to strip
+ * index, built once from a layout description (serpentine wiring, column
+ * wiring, rotation, mirroring, grids of tiles). Matrix fills and blits walk
+ * the table row by row, so no per-pixel layout arithmetic happens at draw
+ * time. A matrix also exposes a gfx_target_t, so the shape primitives used
+ * by the OLED driver draw in color on LED panels.
+ *
+ * A led_zone_t is a linear view onto part of a strip, e.g. to run different
+ * effects on separate sections of one chain.
+ */
+
+#ifndef PICO_HW_LED_MATRIX_H
+#define PICO_HW_LED_MATRIX_H
+
+#include "led_effects.h"
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Lookup table entries needed for a width x height view */
+#define LED_MAP_LUT_SIZE(width, height) ((size_t)(width) * (height))
+
+// =============================================================================
+// Type Definitions
+// =============================================================================
+
+/** Rotation of the logical view relative to the physical panel (clockwise) */
+typedef enum {
+    LED_ROTATE_0 = 0,
+    LED_ROTATE_90,
+    LED_ROTATE_180,
+    LED_ROTATE_270,
+} led_rotation_t;
+
+/**
+ * Physical panel layout. A panel is a grid of tiles_x by tiles_y identical
+ * tiles, always chained row by row (tile_serpentine reverses alternate tile
+ * rows); within a tile LEDs run along rows, or along columns with
+ * column_major, starting at the top-left corner.
+ */
+typedef struct {
+    uint16_t tile_width;     ///< LEDs per tile row
+    uint16_t tile_height;    ///< LEDs per tile column
+    uint8_t tiles_x;         ///< Tiles across (0 = 1)
+    uint8_t tiles_y;         ///< Tiles down (0 = 1)
+    bool serpentine;         ///< Every other row (column) within a tile runs backwards
+    bool column_major;       ///< LEDs within each tile run down columns rather than along rows
+    bool tile_serpentine;    ///< Every other row of tiles is chained right to left
+    led_rotation_t rotation; ///< Rotation of the logical view
+    bool flip_x;             ///< Mirror the logical view horizontally
+    bool flip_y;             ///< Mirror the logical view vertically
+    uint16_t first_index;    ///< Strip index of the panel's first LED
+} led_layout_t;
+
+/** Logical-to-strip index lookup table */
+typedef struct {
+    uint16_t width;          ///< Logical width (after rotation)
+    uint16_t height;         ///< Logical height (after rotation)
+    uint16_t *lut;           ///< width * height strip indices, row-major (caller-owned)
+} led_map_t;
+
+/** 2D view of a strip through a map */
+typedef struct {
+    hw_ws2812_t *strip;      ///< Output strip
+    const led_map_t *map;    ///< Coordinate map
+    led_rgb_t color;         ///< Color used by gfx primitives on this matrix
+} led_matrix_t;
+
+/** Linear view onto a run of pixels in a strip */
+typedef struct {
+    hw_ws2812_t *strip;      ///< Output strip
+    uint16_t start;          ///< First strip index
+    uint16_t count;          ///< Pixels in the zone
+    bool reverse;            ///< Zone index 0 is the last pixel of the run
+} led_zone_t;
+
+// =============================================================================
+// Maps
+// =============================================================================
+
+/**
+ * Build a lookup table for a layout
+ * @param map Map to initialize
+ * @param lut Table storage, at least LED_MAP_LUT_SIZE(width, height) entries
+ * @param lut_len Entries available in lut
+ * @param layout Physical layout
+ * @return HW_INVALID_PARAM on a bad layout, too small a table, or indices beyond 16 bits
+ */
+hw_result_t led_map_init(led_map_t *map, uint16_t *lut, size_t lut_len, const led_layout_t *layout);
+
+/**
+ * Strip index of a logical coordinate (unchecked)
+ */
+static inline uint16_t led_map_index(const led_map_t *map, uint16_t x, uint16_t y) {
+    return map->lut[(uint32_t)y * map->width + x];
+}
+
+// =============================================================================
+// Matrix
+// =============================================================================
+
+/**
+ * Attach a map to a strip
+ * @param matrix Matrix to initialize (color starts white)
+ * @param strip Initialized strip
+ * @param map Built map; every index must be on the strip
+ * @return HW_INVALID_PARAM if the map addresses pixels beyond the strip
+ */
+hw_result_t led_matrix_init(led_matrix_t *matrix, hw_ws2812_t *strip, const led_map_t *map);
+
+/** Set one pixel (clipped) */
+void led_matrix_set_pixel(led_matrix_t *matrix, int16_t x, int16_t y, led_rgb_t color);
+
+/** Fill the whole view */
+void led_matrix_fill(led_matrix_t *matrix, led_rgb_t color);
+
+/** Fill a rectangle (clipped) */
+void led_matrix_fill_rect(led_matrix_t *matrix, int16_t x, int16_t y, uint16_t w, uint16_t h, led_rgb_t color);
+
+/**
+ * Copy a row-major color image onto the view (clipped)
+ * @param matrix Matrix
+ * @param x Destination left edge
+ * @param y Destination top edge
+ * @param src Source pixels, w * h row-major (e.g. an effect layer buffer)
+ * @param w Source width
+ * @param h Source height
+ */
+void led_matrix_blit(led_matrix_t *matrix, int16_t x, int16_t y, const led_rgb_t *src, uint16_t w, uint16_t h);
+
+/**
+ * Drawing target for the gfx primitives; they draw in matrix->color
+ * @param matrix Matrix (must outlive the target)
+ * @return Target for gfx_line, gfx_fill_circle, ...
+ */
+gfx_target_t led_matrix_target(led_matrix_t *matrix);
+
+// =============================================================================
+// Zones
+// =============================================================================
+
+/**
+ * Define a zone
+ * @param zone Zone to initialize
+ * @param strip Initialized strip
+ * @param start First strip index
+ * @param count Pixels in the zone
+ * @param reverse Address the run from its far end
+ * @return HW_INVALID_PARAM if the run extends beyond the strip
+ */
+hw_result_t led_zone_init(led_zone_t *zone, hw_ws2812_t *strip, uint16_t start, uint16_t count, bool reverse);
+
+/** Set one zone pixel (ignored out of range) */
+void led_zone_set_pixel(const led_zone_t *zone, uint16_t index, led_rgb_t color);
+
+/** Fill the zone */
+void led_zone_fill(const led_zone_t *zone, led_rgb_t color);
+
+/** Copy zone->count pixels (e.g. an effect layer buffer) onto the zone */
+void led_zone_blit(const led_zone_t *zone, const led_rgb_t *src);
+
+#endif // PICO_HW_LED_MATRIX_H
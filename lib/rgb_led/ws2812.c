@@ -1,56 +1,426 @@
 #include "../lib.h"
 #include "ws2812.pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include <stdlib.h>
 #include <string.h>
 
 // WS2812 LED protocol timing constants (in microseconds)
 #define WS2812_RESET_DELAY_US 300
+#define WS2812_CHANNEL_US     10    // 8 bits at 800 kHz
+#define WS2812_PLANE_WORD_US  5     // Parallel FIFO word: 4 bit-planes at 800 kHz
+
+// Parallel mode: one bit-plane per wire bit, 4 planes per FIFO word
+#define WS2812_WORDS_PER_CHANNEL 2
+
+// Wire byte slot (0 = sent first) of R, G and B for each hw_ws2812_order_t;
+// W, when present, is always sent last
+static const uint8_t order_slots[][3] = {
+    [HW_WS2812_ORDER_GRB] = {1, 0, 2},
+    [HW_WS2812_ORDER_RGB] = {0, 1, 2},
+    [HW_WS2812_ORDER_BRG] = {1, 2, 0},
+    [HW_WS2812_ORDER_RBG] = {0, 2, 1},
+    [HW_WS2812_ORDER_GBR] = {2, 0, 1},
+    [HW_WS2812_ORDER_BGR] = {2, 1, 0},
+};
+
+// Full-scale brightness (multiply then shift by 8)
+#define WS2812_BRIGHTNESS_FULL 256
+
+// Gamma 2.2 to 16-bit linear: round(65535 * (i / 255)^2.2)
+static const uint16_t gamma_lut[256] = {
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535,
+};
+
+// Instances with a DMA channel, for IRQ access (one per PIO state machine)
+#define MAX_WS2812_INSTANCES 8
+static hw_ws2812_t *ws2812_instances[MAX_WS2812_INSTANCES] = {NULL};
+static bool dma_irq_installed = false;
 
 // Internal helper functions
-static inline uint32_t grb_color(uint8_t r, uint8_t g, uint8_t b) {
-    // WS2812 expects data in GRB format
-    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+static inline uint32_t canonical_color(uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    // pixels[] holds 0xWWRRGGBB; wire order is applied at show time
+    return ((uint32_t)w << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
 }
 
-static inline void put_pixel(PIO pio, uint sm, uint32_t color) {
-    // Left shift by 8 to align with PIO's 32-bit output
-    pio_sm_put_blocking(pio, sm, color << 8);
+// Resolve the pixel format into per-channel shifts within the MSB-first wire word
+static bool format_setup(hw_ws2812_t *ws, const hw_ws2812_format_t *format) {
+    uint8_t bits = format->bits ? format->bits : 24;
+    if ((bits != 24 && bits != 32) || (uint)format->order >= ARRAY_SIZE(order_slots)) {
+        return false;
+    }
+
+    ws->channels = bits / 8;
+    for (int c = 0; c < 3; c++) {
+        ws->shift[c] = 24 - 8 * order_slots[format->order][c];
+    }
+    ws->shift[3] = 0;
+    return true;
 }
 
-hw_result_t hw_ws2812_init(hw_ws2812_t *ws, const hw_ws2812_config_t *config) {
-    if (!ws || !config) {
+static inline bool is_parallel(const hw_ws2812_config_t *config) {
+    return config->num_lanes > 1;
+}
+
+// Total pixels across all lanes
+static inline uint total_pixels(const hw_ws2812_config_t *config) {
+    return is_parallel(config) ? config->num_pixels * config->num_lanes : config->num_pixels;
+}
+
+// Wire time of one FIFO word
+static inline uint32_t word_time_us(const hw_ws2812_t *ws) {
+    return is_parallel(&ws->config) ? WS2812_PLANE_WORD_US : ws->channels * WS2812_CHANNEL_US;
+}
+
+// Time for the whole frame plus latch, used to bound waits
+static inline uint64_t frame_time_us(const hw_ws2812_t *ws) {
+    return (uint64_t)ws->wire_words * word_time_us(ws) + WS2812_RESET_DELAY_US;
+}
+
+// Write one pixel's working values from its canonical 8-bit color
+static inline void work_set8(hw_ws2812_t *ws, uint index, uint32_t color) {
+    uint16_t *v = &ws->work[ws->channels * index];
+    for (uint c = 0; c < ws->channels; c++) {
+        uint8_t x = color >> (c == 3 ? 24 : 16 - 8 * c);  // R, G, B, W
+        v[c] = ws->gamma ? gamma_lut[x] : x * 257;
+    }
+}
+
+// Scale one 16-bit channel and quantise to 8 bits, carrying the error when dithering
+static inline uint32_t quantise(uint32_t value, uint32_t scale, uint8_t *residual, bool dither) {
+    uint32_t v = (value * scale) >> 8;
+    // 0-65535 to 8.8 fixed point of 0-255: x * 257 becomes exactly x * 256
+    v -= v >> 8;
+    if (dither) {
+        v += *residual;
+        *residual = v & 0xFF;
+    } else {
+        v += 0x80;
+    }
+    v >>= 8;
+    return v > 255 ? 255 : v;
+}
+
+// Output stage: the wire word for a pixel, first byte in bits 31..24, in one
+// pass from the canonical color (brightness, dithering and channel order).
+// Called exactly once per pixel per frame, since dithering advances the residual.
+static inline uint32_t output_pixel(hw_ws2812_t *ws, uint index) {
+    uint32_t scale = ws->brightness;
+    uint32_t r, g, b, w;
+
+    if (!ws->work) {
+        uint32_t color = ws->pixels[index];
+        w = color >> 24;
+        r = (color >> 16) & 0xFF;
+        g = (color >> 8) & 0xFF;
+        b = color & 0xFF;
+        if (scale != WS2812_BRIGHTNESS_FULL) {
+            r = (r * scale) >> 8;
+            g = (g * scale) >> 8;
+            b = (b * scale) >> 8;
+            w = (w * scale) >> 8;
+        }
+    } else {
+        const uint16_t *v = &ws->work[ws->channels * index];
+        uint8_t *res = &ws->residual[ws->channels * index];
+        r = quantise(v[0], scale, &res[0], ws->dither);
+        g = quantise(v[1], scale, &res[1], ws->dither);
+        b = quantise(v[2], scale, &res[2], ws->dither);
+        w = ws->channels == 4 ? quantise(v[3], scale, &res[3], ws->dither) : 0;
+    }
+
+    // W sits in the low byte; 24-bit autopull never shifts it out
+    return (r << ws->shift[0]) | (g << ws->shift[1]) | (b << ws->shift[2]) | (w << ws->shift[3]);
+}
+
+// Serial encoding: one word per pixel, MSB first
+static void encode_serial(hw_ws2812_t *ws) {
+    for (uint i = 0; i < ws->config.num_pixels; i++) {
+        ws->wire[i] = output_pixel(ws, i);
+    }
+}
+
+// Parallel encoding: for each LED position, transpose every wire byte of
+// every lane into bit-planes. Planes are consumed low byte first, so the
+// little-endian byte order of wire[] is exactly the transmit order.
+static void encode_parallel(hw_ws2812_t *ws) {
+    uint n = ws->config.num_pixels;
+    uint lanes = ws->config.num_lanes;
+    uint8_t *out = (uint8_t *)ws->wire;
+
+    for (uint i = 0; i < n; i++) {
+        uint32_t word[HW_WS2812_MAX_LANES] = {0};
+        for (uint lane = 0; lane < lanes; lane++) {
+            word[lane] = output_pixel(ws, lane * n + i);
+        }
+        for (uint c = 0; c < ws->channels; c++) {
+            uint8_t in[8];
+            for (uint lane = 0; lane < HW_WS2812_MAX_LANES; lane++) {
+                in[lane] = (uint8_t)(word[lane] >> (24 - 8 * c));
+            }
+            hw_ws2812_transpose8(in, out);
+            out += 8;
+        }
+    }
+}
+
+// Latch gap has elapsed: the frame is visible and the back buffer is free
+static int64_t latch_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    hw_ws2812_t *ws = (hw_ws2812_t *)user_data;
+    ws->latch_alarm = 0;
+    ws->busy = false;
+    if (ws->done_callback) {
+        ws->done_callback(ws->user_data);
+    }
+    return 0;  // One-shot
+}
+
+// DMA completion: the last word is in the TX FIFO, so time the drain plus reset gap
+static void ws2812_dma_irq_handler(void) {
+    for (int i = 0; i < MAX_WS2812_INSTANCES; i++) {
+        hw_ws2812_t *ws = ws2812_instances[i];
+        if (!ws || !dma_channel_get_irq0_status(ws->dma_chan)) continue;
+
+        dma_channel_acknowledge_irq0(ws->dma_chan);
+
+        // Words still queued plus the one in the OSR
+        uint32_t pending = pio_sm_get_tx_fifo_level(ws->config.pio, ws->config.sm) + 1;
+        uint32_t delay = pending * word_time_us(ws) + WS2812_RESET_DELAY_US;
+        alarm_id_t id = add_alarm_in_us(delay, latch_alarm_callback, ws, true);
+        if (id > 0) {
+            ws->latch_alarm = id;
+        } else if (id < 0) {
+            // No alarm slots: fall back to a short busy-wait in the IRQ
+            busy_wait_us_32(delay);
+            latch_alarm_callback(0, ws);
+        }
+        // id == 0: the callback has already run
+    }
+}
+
+// Claim a DMA channel feeding the state machine's TX FIFO; leaves dma_chan at -1 on failure
+static void dma_setup(hw_ws2812_t *ws) {
+    ws->dma_chan = -1;
+
+    int slot = -1;
+    for (int i = 0; i < MAX_WS2812_INSTANCES; i++) {
+        if (!ws2812_instances[i]) { slot = i; break; }
+    }
+    if (slot < 0) return;
+
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) return;
+
+    // 32-bit words into TXF, paced by the state machine's TX DREQ
+    PIO pio = ws->config.pio;
+    uint sm = ws->config.sm;
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(chan, &c, &pio->txf[sm], ws->wire, 0, false);
+
+    ws->dma_chan = chan;
+
+    // Store instance for IRQ access (with critical section for thread safety)
+    uint32_t save = save_and_disable_interrupts();
+    ws2812_instances[slot] = ws;
+    restore_interrupts(save);
+
+    if (!dma_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, ws2812_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        dma_irq_installed = true;
+    }
+    dma_channel_set_irq0_enabled(chan, true);
+}
+
+// Words of pixel + wire storage needed for a config (see HW_WS2812_STORAGE_WORDS)
+static size_t storage_words(const hw_ws2812_config_t *config, uint channels) {
+    size_t wire = is_parallel(config)
+        ? (size_t)config->num_pixels * channels * WS2812_WORDS_PER_CHANNEL
+        : config->num_pixels;
+    return total_pixels(config) + wire;
+}
+
+// Common init: claims the state machine and loads the program, then sets up
+// buffers in the given storage (sized by storage_words)
+static hw_result_t init_common(hw_ws2812_t *ws, const hw_ws2812_config_t *config,
+                               uint32_t *storage, size_t words, bool owns_storage) {
+    ws->initialized = false;
+    if (!format_setup(ws, &config->format)) {
+        return HW_INVALID_PARAM;
+    }
+    if (!storage || words < storage_words(config, ws->channels)) {
         return HW_INVALID_PARAM;
     }
 
-    // Allocate pixel buffer
-    ws->pixels = (uint32_t *)malloc(config->num_pixels * sizeof(uint32_t));
-    if (!ws->pixels) {
+    const pio_program_t *program = is_parallel(config) ? &ws2812_parallel_program : &ws2812_program;
+    if (pio_sm_is_claimed(config->pio, config->sm)) {
+        return HW_BUSY;
+    }
+    if (!pio_can_add_program(config->pio, program)) {
         return HW_ERROR;
     }
 
+    // Copy the config so the caller's struct may go out of scope
+    ws->config = *config;
+
+    // Front (pixels) and back (wire) buffers
+    uint pixels = total_pixels(config);
+    ws->pixels = storage;
+    ws->wire = storage + pixels;
+    ws->wire_words = storage_words(config, ws->channels) - pixels;
+    ws->owns_storage = owns_storage;
+
     // Clear pixel buffer
-    memset(ws->pixels, 0, config->num_pixels * sizeof(uint32_t));
+    memset(ws->pixels, 0, pixels * sizeof(uint32_t));
 
     // Initialize PIO program
-    uint offset = pio_add_program(config->pio, &ws2812_program);
-    ws2812_program_init(config->pio, config->sm, offset, config->data_pin, 800000);
+    pio_sm_claim(config->pio, config->sm);
+    ws->program_offset = pio_add_program(config->pio, program);
+    if (is_parallel(config)) {
+        ws2812_parallel_program_init(config->pio, config->sm, ws->program_offset, config->data_pin, config->num_lanes, 800000);
+    } else {
+        ws2812_program_init(config->pio, config->sm, ws->program_offset, config->data_pin, 800000, ws->channels == 4);
+    }
 
-    // Store config and mark as initialized
-    ws->config = config;
+    // Mark as initialized
+    ws->work = NULL;
+    ws->residual = NULL;
+    ws->owns_pipeline = false;
+    ws->brightness = WS2812_BRIGHTNESS_FULL;
+    ws->gamma = false;
+    ws->dither = false;
+    ws->busy = false;
+    ws->player_attached = false;
+    ws->latch_alarm = 0;
+    ws->done_callback = NULL;
+    ws->user_data = NULL;
+    dma_setup(ws);
     ws->initialized = true;
-    
+
     // Send initial reset signal to ensure LEDs are ready
     hw_sleep_us(WS2812_RESET_DELAY_US);
 
     return HW_OK;
 }
 
+hw_result_t hw_ws2812_init(hw_ws2812_t *ws, const hw_ws2812_config_t *config) {
+    if (!ws || !config || config->num_lanes > HW_WS2812_MAX_LANES || !format_setup(ws, &config->format)) {
+        return HW_INVALID_PARAM;
+    }
+
+    // Allocate front (pixels) and back (wire) buffers in one block
+    size_t words = storage_words(config, ws->channels);
+    uint32_t *storage = (uint32_t *)malloc(words * sizeof(uint32_t));
+    if (!storage) {
+        return HW_ERROR;
+    }
+
+    hw_result_t result = init_common(ws, config, storage, words, true);
+    if (result != HW_OK) {
+        free(storage);
+    }
+    return result;
+}
+
+hw_result_t hw_ws2812_init_static(hw_ws2812_t *ws, const hw_ws2812_config_t *config,
+                                  uint32_t *storage, size_t storage_words) {
+    if (!ws || !config || config->num_lanes > HW_WS2812_MAX_LANES) {
+        return HW_INVALID_PARAM;
+    }
+    return init_common(ws, config, storage, storage_words, false);
+}
+
+void hw_ws2812_deinit(hw_ws2812_t *ws) {
+    if (!ws || !ws->initialized) return;
+
+    // Let the last frame finish, then release the DMA channel
+    if (ws->dma_chan >= 0) {
+        hw_ws2812_wait(ws);
+        dma_channel_set_irq0_enabled(ws->dma_chan, false);
+        dma_channel_unclaim(ws->dma_chan);
+
+        // Remove from instances (with critical section for thread safety)
+        uint32_t save = save_and_disable_interrupts();
+        for (int i = 0; i < MAX_WS2812_INSTANCES; i++) {
+            if (ws2812_instances[i] == ws) {
+                ws2812_instances[i] = NULL;
+            }
+        }
+        restore_interrupts(save);
+        ws->dma_chan = -1;
+    }
+
+    // Stop the state machine and return its instruction memory
+    PIO pio = ws->config.pio;
+    uint sm = ws->config.sm;
+    pio_sm_set_enabled(pio, sm, false);
+    pio_remove_program(pio, is_parallel(&ws->config) ? &ws2812_parallel_program : &ws2812_program,
+                       ws->program_offset);
+    pio_sm_unclaim(pio, sm);
+
+    if (ws->owns_pipeline) {
+        free(ws->work);
+    }
+    if (ws->owns_storage) {
+        free(ws->pixels);
+    }
+    ws->work = NULL;
+    ws->residual = NULL;
+    ws->pixels = NULL;
+    ws->wire = NULL;
+    ws->initialized = false;
+}
+
 hw_result_t hw_ws2812_set_pixel(hw_ws2812_t *ws, uint index, uint8_t r, uint8_t g, uint8_t b) {
-    if (!ws || !ws->initialized || index >= ws->config->num_pixels) {
+    return hw_ws2812_set_pixel_rgbw(ws, index, r, g, b, 0);
+}
+
+hw_result_t hw_ws2812_set_pixel_rgbw(hw_ws2812_t *ws, uint index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    if (!ws || !ws->initialized || index >= total_pixels(&ws->config)) {
         return HW_INVALID_PARAM;
     }
 
-    ws->pixels[index] = grb_color(r, g, b);
+    ws->pixels[index] = canonical_color(r, g, b, w);
+    if (ws->work) {
+        work_set8(ws, index, ws->pixels[index]);
+    }
     return HW_OK;
 }
 
@@ -59,28 +429,207 @@ hw_result_t hw_ws2812_set_all(hw_ws2812_t *ws, uint8_t r, uint8_t g, uint8_t b)
         return HW_INVALID_PARAM;
     }
 
-    uint32_t color = grb_color(r, g, b);
-    for (uint i = 0; i < ws->config->num_pixels; i++) {
+    uint32_t color = canonical_color(r, g, b, 0);
+    for (uint i = 0; i < total_pixels(&ws->config); i++) {
         ws->pixels[i] = color;
+        if (ws->work) {
+            work_set8(ws, i, color);
+        }
     }
     return HW_OK;
 }
 
+// Start sending one frame of wire words; the strip must not be busy
+static void transmit(hw_ws2812_t *ws, const uint32_t *words) {
+    // Blocking fallback when no DMA channel was available
+    if (ws->dma_chan < 0) {
+        for (uint32_t i = 0; i < ws->wire_words; i++) {
+            pio_sm_put_blocking(ws->config.pio, ws->config.sm, words[i]);
+        }
+        hw_sleep_us(WS2812_RESET_DELAY_US);
+        return;
+    }
+
+    ws->busy = true;
+    dma_channel_transfer_from_buffer_now(ws->dma_chan, words, ws->wire_words);
+}
+
 hw_result_t hw_ws2812_show(hw_ws2812_t *ws) {
     if (!ws || !ws->initialized) {
         return HW_INVALID_PARAM;
     }
+    if (ws->player_attached) {
+        return HW_BUSY;
+    }
 
-    // Send each pixel's color to the LED strip
-    for (uint i = 0; i < ws->config->num_pixels; i++) {
-        put_pixel(ws->config->pio, ws->config->sm, ws->pixels[i]);
+    // The back buffer is free once the previous frame has latched
+    hw_result_t result = hw_ws2812_wait(ws);
+    if (result != HW_OK) {
+        return result;
     }
 
-    // Latch colors with reset delay
-    hw_sleep_us(WS2812_RESET_DELAY_US);
+    // Snapshot into FIFO words
+    if (is_parallel(&ws->config)) {
+        encode_parallel(ws);
+    } else {
+        encode_serial(ws);
+    }
+
+    transmit(ws, ws->wire);
+    return HW_OK;
+}
+
+hw_result_t hw_ws2812_show_wire(hw_ws2812_t *ws, const uint32_t *words, uint32_t count) {
+    if (!ws || !ws->initialized || !words || count != ws->wire_words) {
+        return HW_INVALID_PARAM;
+    }
+    if (ws->busy) {
+        return HW_BUSY;
+    }
+
+    transmit(ws, words);
+    return HW_OK;
+}
+
+bool hw_ws2812_is_busy(hw_ws2812_t *ws) {
+    return ws && ws->initialized && ws->busy;
+}
+
+hw_result_t hw_ws2812_wait(hw_ws2812_t *ws) {
+    if (!ws || !ws->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    uint64_t start = hw_time_us();
+    uint64_t timeout = 2 * frame_time_us(ws) + 1000;
+    while (ws->busy) {
+        if (hw_timeout_elapsed(start, timeout)) {
+            // Stalled: drop the frame so the next show can proceed
+            uint32_t save = save_and_disable_interrupts();
+            if (ws->latch_alarm > 0) {
+                cancel_alarm(ws->latch_alarm);
+                ws->latch_alarm = 0;
+            }
+            dma_channel_abort(ws->dma_chan);
+            ws->busy = false;
+            restore_interrupts(save);
+            return HW_TIMEOUT;
+        }
+        tight_loop_contents();
+    }
     return HW_OK;
 }
 
+void hw_ws2812_set_callback(hw_ws2812_t *ws, void (*callback)(void *user_data), void *user_data) {
+    if (!ws) return;
+    ws->done_callback = callback;
+    ws->user_data = user_data;
+}
+
 hw_result_t hw_ws2812_clear(hw_ws2812_t *ws) {
     return hw_ws2812_set_all(ws, 0, 0, 0);
-}
\ No newline at end of file
+}
+
+uint hw_ws2812_num_pixels(const hw_ws2812_t *ws) {
+    return (ws && ws->initialized) ? total_pixels(&ws->config) : 0;
+}
+
+hw_result_t hw_ws2812_set_brightness(hw_ws2812_t *ws, uint8_t brightness) {
+    if (!ws || !ws->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    // Map 0-255 onto 0-256 so full brightness is an exact identity
+    ws->brightness = brightness + (brightness >> 7);
+    return HW_OK;
+}
+
+// Attach pipeline buffers (work values then residuals) unless already attached,
+// then convert the current frame
+static void pipeline_setup(hw_ws2812_t *ws, uint16_t *work, bool owns, bool gamma, bool dither) {
+    uint values = total_pixels(&ws->config) * ws->channels;
+    if (!ws->work) {
+        ws->residual = (uint8_t *)(work + values);
+        memset(ws->residual, 0, values);
+        ws->work = work;
+        ws->owns_pipeline = owns;
+    }
+
+    ws->gamma = gamma;
+    ws->dither = dither;
+
+    for (uint i = 0; i < total_pixels(&ws->config); i++) {
+        work_set8(ws, i, ws->pixels[i]);
+    }
+}
+
+hw_result_t hw_ws2812_enable_pipeline(hw_ws2812_t *ws, bool gamma, bool dither) {
+    if (!ws || !ws->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    uint16_t *work = NULL;
+    if (!ws->work) {
+        // Working values and residuals in one block
+        uint values = total_pixels(&ws->config) * ws->channels;
+        work = (uint16_t *)malloc(values * (sizeof(uint16_t) + 1));
+        if (!work) {
+            return HW_ERROR;
+        }
+    }
+    pipeline_setup(ws, work, true, gamma, dither);
+    return HW_OK;
+}
+
+hw_result_t hw_ws2812_enable_pipeline_static(hw_ws2812_t *ws, uint32_t *storage, size_t storage_words,
+                                             bool gamma, bool dither) {
+    if (!ws || !ws->initialized) {
+        return HW_INVALID_PARAM;
+    }
+
+    size_t values = (size_t)total_pixels(&ws->config) * ws->channels;
+    if (!ws->work && (!storage || storage_words * sizeof(uint32_t) < values * (sizeof(uint16_t) + 1))) {
+        return HW_INVALID_PARAM;
+    }
+    pipeline_setup(ws, (uint16_t *)storage, false, gamma, dither);
+    return HW_OK;
+}
+
+hw_result_t hw_ws2812_set_pixel16(hw_ws2812_t *ws, uint index, uint16_t r, uint16_t g, uint16_t b) {
+    if (!ws || !ws->initialized || !ws->work || index >= total_pixels(&ws->config)) {
+        return HW_INVALID_PARAM;
+    }
+
+    uint16_t *v = &ws->work[ws->channels * index];
+    v[0] = r;
+    v[1] = g;
+    v[2] = b;
+    if (ws->channels == 4) {
+        v[3] = 0;
+    }
+    ws->pixels[index] = canonical_color(r >> 8, g >> 8, b >> 8, 0);
+    return HW_OK;
+}
+
+// 8x8 bit-matrix transpose (Hacker's Delight transpose8, 32-bit form for the
+// M0+). Loading lanes 7..4 and 3..0 as big-endian rows makes lane L land in
+// bit L of every output byte.
+void hw_ws2812_transpose8(const uint8_t lanes[8], uint8_t planes[8]) {
+    uint32_t x = ((uint32_t)lanes[7] << 24) | ((uint32_t)lanes[6] << 16) | ((uint32_t)lanes[5] << 8) | lanes[4];
+    uint32_t y = ((uint32_t)lanes[3] << 24) | ((uint32_t)lanes[2] << 16) | ((uint32_t)lanes[1] << 8) | lanes[0];
+    uint32_t t;
+
+    // Swap 1x1 blocks within 2x2, then 2x2 within 4x4
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+
+    // Swap 4x4 blocks between the halves
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    planes[0] = x >> 24; planes[1] = x >> 16; planes[2] = x >> 8; planes[3] = x;
+    planes[4] = y >> 24; planes[5] = y >> 16; planes[6] = y >> 8; planes[7] = y;
+}
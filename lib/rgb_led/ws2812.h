@@ -13,23 +13,80 @@
 #include "hardware/pio.h"
 // pio_ws2812.pio.h is generated by CMake and automatically included
 
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/** Maximum strips driven in parallel by one state machine */
+#define HW_WS2812_MAX_LANES 8
+
+/**
+ * Words of storage hw_ws2812_init_static needs for a strip, e.g.
+ *   static uint32_t strip_mem[HW_WS2812_STORAGE_WORDS(300, 1, 24)];
+ * @param pixels LEDs per strip
+ * @param lanes Parallel strips (0 or 1 for a single strip)
+ * @param bits 24 (RGB) or 32 (RGBW)
+ */
+#define HW_WS2812_STORAGE_WORDS(pixels, lanes, bits) \
+    ((pixels) * ((lanes) > 1 ? (lanes) : 1) + ((lanes) > 1 ? (pixels) * (bits) / 4 : (pixels)))
+
+/** Words of storage hw_ws2812_enable_pipeline_static needs (same arguments) */
+#define HW_WS2812_PIPELINE_WORDS(pixels, lanes, bits) \
+    (((pixels) * ((lanes) > 1 ? (lanes) : 1) * ((bits) / 8) * 3 + 3) / 4)
+
 // =============================================================================
 // Type Definitions
 // =============================================================================
 
+/** Order in which the color bytes are sent on the wire */
+typedef enum {
+    HW_WS2812_ORDER_GRB = 0,  ///< WS2812/WS2812B, SK6812 (default)
+    HW_WS2812_ORDER_RGB,      ///< WS2811 variants, some APA106
+    HW_WS2812_ORDER_BRG,
+    HW_WS2812_ORDER_RBG,
+    HW_WS2812_ORDER_GBR,
+    HW_WS2812_ORDER_BGR,
+} hw_ws2812_order_t;
+
+/** Pixel wire format; zero-initialized means 24-bit GRB */
+typedef struct {
+    hw_ws2812_order_t order;  ///< Color byte order
+    uint8_t bits;             ///< 24 (RGB) or 32 (RGBW, white byte sent last); 0 = 24
+} hw_ws2812_format_t;
+
 /** WS2812 LED configuration structure */
 typedef struct {
     PIO pio;               ///< PIO instance (pio0 or pio1)
     uint sm;               ///< State machine number (0-3)
-    uint data_pin;         ///< Data pin number
-    uint num_pixels;       ///< Number of WS2812 LEDs in chain
+    uint data_pin;         ///< Data pin number (first pin in parallel mode)
+    uint num_pixels;       ///< Number of WS2812 LEDs in chain (per strip in parallel mode)
+    uint num_lanes;        ///< Parallel strips on consecutive pins from data_pin (0 or 1: single strip)
+    hw_ws2812_format_t format;  ///< Pixel wire format (byte order, 24/32 bits)
 } hw_ws2812_config_t;
 
 /** WS2812 LED handle structure */
 typedef struct {
-    const hw_ws2812_config_t *config;  ///< Configuration
-    uint32_t *pixels;                  ///< Pixel buffer
+    hw_ws2812_config_t config;         ///< Configuration (copied at init)
+    uint32_t *pixels;                  ///< Pixel buffer, 0xWWRRGGBB (front: compose the next frame here)
+    uint32_t *wire;                    ///< FIFO words of the frame on the wire (back buffer)
+    uint32_t wire_words;               ///< Words per frame in wire[]
+    uint8_t channels;                  ///< Bytes per pixel on the wire (3 or 4)
+    uint8_t shift[4];                  ///< Wire word shift of R, G, B, W
+    uint16_t *work;                    ///< Linear 16-bit R,G,B(,W) per pixel (output pipeline only)
+    uint8_t *residual;                 ///< Dither error carried into the next frame (pipeline only)
+    uint16_t brightness;               ///< Global brightness scale, 0-256
+    bool gamma;                        ///< 8-bit writes go through the gamma LUT
+    bool dither;                       ///< Temporal dithering enabled
     bool initialized;                   ///< Initialization state
+    bool owns_storage;                 ///< pixels[] block was allocated by hw_ws2812_init
+    bool owns_pipeline;                ///< work[] block was allocated by hw_ws2812_enable_pipeline
+    uint program_offset;               ///< Instruction memory offset of the loaded program
+    int dma_chan;                      ///< DMA channel streaming wire[], -1 for blocking output
+    volatile bool busy;                ///< Frame in flight or latch gap pending
+    volatile bool player_attached;     ///< A clip player owns wire[]; hw_ws2812_show returns HW_BUSY
+    alarm_id_t latch_alarm;            ///< Alarm that ends the latch gap
+    void (*done_callback)(void *user_data);  ///< Called (IRQ context) once the frame has latched
+    void *user_data;                   ///< User data for done_callback
 } hw_ws2812_t;
 
 // =============================================================================
@@ -45,11 +102,41 @@ typedef struct {
  */
 hw_result_t hw_ws2812_init(hw_ws2812_t *ws, const hw_ws2812_config_t *config);
 
+/**
+ * @brief Initialize WS2812 LED driver with caller-provided storage (no heap)
+ * 
+ * Size storage with HW_WS2812_STORAGE_WORDS; it must outlive the handle.
+ * The config is copied, so it need not.
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param config Configuration parameters
+ * @param storage Pixel and wire buffer storage
+ * @param storage_words Size of storage in 32-bit words
+ * @return HW_INVALID_PARAM if storage is too small, HW_BUSY if the state
+ *         machine is claimed, HW_ERROR if the program does not fit
+ */
+hw_result_t hw_ws2812_init_static(hw_ws2812_t *ws, const hw_ws2812_config_t *config,
+                                  uint32_t *storage, size_t storage_words);
+
+/**
+ * @brief Release a WS2812 instance
+ * 
+ * Waits for the frame in flight, releases the DMA channel, stops and
+ * unclaims the state machine, removes the PIO program and frees any
+ * buffers the driver allocated. The handle may then be re-initialized.
+ * 
+ * @param ws Handle to WS2812 instance
+ */
+void hw_ws2812_deinit(hw_ws2812_t *ws);
+
 /**
  * @brief Set RGB color for specific pixel
  * 
+ * In parallel mode the strips are addressed as one concatenated chain:
+ * strip L, LED i is index L * num_pixels + i.
+ * 
  * @param ws Handle to WS2812 instance
- * @param index Pixel index (0 to num_pixels-1)
+ * @param index Pixel index (0 to num_pixels * num_lanes - 1)
  * @param r Red component (0-255)
  * @param g Green component (0-255)
  * @param b Blue component (0-255)
@@ -57,6 +144,19 @@ hw_result_t hw_ws2812_init(hw_ws2812_t *ws, const hw_ws2812_config_t *config);
  */
 hw_result_t hw_ws2812_set_pixel(hw_ws2812_t *ws, uint index, uint8_t r, uint8_t g, uint8_t b);
 
+/**
+ * @brief Set RGBW color for specific pixel (white is dropped on 24-bit strips)
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param index Pixel index
+ * @param r Red component (0-255)
+ * @param g Green component (0-255)
+ * @param b Blue component (0-255)
+ * @param w White component (0-255)
+ * @return hw_result_t Operation result
+ */
+hw_result_t hw_ws2812_set_pixel_rgbw(hw_ws2812_t *ws, uint index, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
+
 /**
  * @brief Set same RGB color for all pixels
  * 
@@ -71,11 +171,64 @@ hw_result_t hw_ws2812_set_all(hw_ws2812_t *ws, uint8_t r, uint8_t g, uint8_t b);
 /**
  * @brief Show pixels (transmit colors to LEDs)
  * 
+ * Snapshots the pixel buffer into the back buffer and starts a DMA transfer
+ * to the PIO, returning immediately; the next frame may be composed in
+ * pixels[] while this one is on the wire. The reset (latch) gap is timed by
+ * an alarm. If the previous frame is still in flight, waits for it first.
+ * Without a DMA channel, falls back to blocking output.
+ * 
+ * Returns HW_BUSY without touching the back buffer while a clip player is
+ * attached (led_clip_play until led_clip_stop), since delta clips are
+ * decoded in place into it.
+ * 
  * @param ws Handle to WS2812 instance
  * @return hw_result_t Operation result
  */
 hw_result_t hw_ws2812_show(hw_ws2812_t *ws);
 
+/**
+ * @brief Send a pre-encoded frame (e.g. an animation clip) as-is
+ * 
+ * words must already be in this strip's wire format (byte order, bit depth
+ * and lane layout) and exactly wire_words long; the pixel buffer, output
+ * pipeline and brightness are bypassed. The frame is streamed by DMA straight
+ * from words, which may live in flash and must stay valid until it latches.
+ * Never waits: returns HW_BUSY while the previous frame is in flight, so it
+ * is safe from a timer callback. Without a DMA channel, falls back to
+ * blocking output.
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param words FIFO words of one frame
+ * @param count Number of words (must equal ws->wire_words)
+ * @return hw_result_t Operation result
+ */
+hw_result_t hw_ws2812_show_wire(hw_ws2812_t *ws, const uint32_t *words, uint32_t count);
+
+/**
+ * @brief Check whether a frame is still being sent or latched
+ * 
+ * @param ws Handle to WS2812 instance
+ * @return true until the last frame has latched
+ */
+bool hw_ws2812_is_busy(hw_ws2812_t *ws);
+
+/**
+ * @brief Block until the last frame has latched
+ * 
+ * @param ws Handle to WS2812 instance
+ * @return HW_OK, or HW_TIMEOUT if the transfer stalled (it is aborted)
+ */
+hw_result_t hw_ws2812_wait(hw_ws2812_t *ws);
+
+/**
+ * @brief Set a callback run (from IRQ context) each time a frame has latched
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param callback Completion callback, or NULL
+ * @param user_data Passed to the callback
+ */
+void hw_ws2812_set_callback(hw_ws2812_t *ws, void (*callback)(void *user_data), void *user_data);
+
 /**
  * @brief Clear all pixels (set to black/off)
  * 
@@ -84,4 +237,80 @@ hw_result_t hw_ws2812_show(hw_ws2812_t *ws);
  */
 hw_result_t hw_ws2812_clear(hw_ws2812_t *ws);
 
+/**
+ * @brief Number of addressable pixels (all lanes in parallel mode)
+ * 
+ * @param ws Handle to WS2812 instance
+ * @return uint Pixel count, 0 if not initialized
+ */
+uint hw_ws2812_num_pixels(const hw_ws2812_t *ws);
+
+/**
+ * @brief Set global brightness, applied at show time by multiply and shift
+ * 
+ * Without the output pipeline this simply scales the 8-bit values; with it,
+ * the scaled 16-bit values are dithered so dim levels keep their depth.
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param brightness 0 (off) to 255 (full)
+ * @return hw_result_t Operation result
+ */
+hw_result_t hw_ws2812_set_brightness(hw_ws2812_t *ws, uint8_t brightness);
+
+/**
+ * @brief Enable the 16-bit output pipeline
+ * 
+ * Allocates a 16-bit-per-channel working buffer and a dither residual
+ * buffer (3 bytes per channel per pixel). 8-bit writes are linearised through a
+ * gamma 2.2 LUT when gamma is set; hw_ws2812_set_pixel16 writes linear
+ * values directly. At show time each channel is scaled by the global
+ * brightness and quantised to 8 bits, carrying the rounding error to the
+ * next frame when dither is set, so keep calling show (~100 Hz or more)
+ * for dim colors to average out correctly. Current pixels are converted.
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param gamma Apply gamma correction to 8-bit writes
+ * @param dither Enable temporal dithering
+ * @return HW_OK, or HW_ERROR if the buffers cannot be allocated
+ */
+hw_result_t hw_ws2812_enable_pipeline(hw_ws2812_t *ws, bool gamma, bool dither);
+
+/**
+ * @brief Enable the 16-bit output pipeline with caller-provided storage
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param storage Pipeline storage, sized with HW_WS2812_PIPELINE_WORDS
+ * @param storage_words Size of storage in 32-bit words
+ * @param gamma Apply gamma correction to 8-bit writes
+ * @param dither Enable temporal dithering
+ * @return HW_INVALID_PARAM if storage is too small
+ */
+hw_result_t hw_ws2812_enable_pipeline_static(hw_ws2812_t *ws, uint32_t *storage, size_t storage_words,
+                                             bool gamma, bool dither);
+
+/**
+ * @brief Set a pixel from linear 16-bit components (output pipeline only)
+ * 
+ * @param ws Handle to WS2812 instance
+ * @param index Pixel index
+ * @param r Red component (0-65535, linear)
+ * @param g Green component (0-65535, linear)
+ * @param b Blue component (0-65535, linear)
+ * @return HW_INVALID_PARAM if the pipeline is not enabled
+ */
+hw_result_t hw_ws2812_set_pixel16(hw_ws2812_t *ws, uint index, uint16_t r, uint16_t g, uint16_t b);
+
+/**
+ * @brief Transpose an 8x8 bit matrix into WS2812 bit-planes
+ * 
+ * Turns one byte per lane into one byte per transmitted bit: planes[k]
+ * holds bit (7 - k) of every lane, lane L in bit L, so planes[0] is the
+ * MSB that goes out first. This is the hot path of parallel output and
+ * has no hardware dependencies.
+ * 
+ * @param lanes Input byte for each of 8 lanes
+ * @param planes Output bit-planes, MSB first
+ */
+void hw_ws2812_transpose8(const uint8_t lanes[8], uint8_t planes[8]);
+
 #endif // PICO_HW_WS2812_H
\ No newline at end of file
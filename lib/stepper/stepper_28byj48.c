@@ -218,4 +218,12 @@ int32_t stepper_28byj48_degrees_to_steps(stepper_28byj48_t *motor, float degrees
 float stepper_28byj48_steps_to_degrees(stepper_28byj48_t *motor, int32_t steps) {
     int32_t steps_per_rev = get_steps_per_rev(motor->config.mode);
     return (steps * 360.0f) / steps_per_rev;
+}
+
+int32_t stepper_28byj48_angle_to_steps(stepper_28byj48_t *motor, fxp_angle_t angle) {
+    return fxp_angle_to_ratio(angle, get_steps_per_rev(motor->config.mode));
+}
+
+fxp_angle_t stepper_28byj48_steps_to_angle(stepper_28byj48_t *motor, int32_t steps) {
+    return fxp_angle_from_ratio(steps, get_steps_per_rev(motor->config.mode));
 }
\ No newline at end of file
@@ -215,4 +215,20 @@ int32_t stepper_28byj48_degrees_to_steps(stepper_28byj48_t *motor, float degrees
  */
 float stepper_28byj48_steps_to_degrees(stepper_28byj48_t *motor, int32_t steps);
 
+/**
+ * Convert a fixed-point angle to steps within one revolution (no float math)
+ * @param motor Pointer to motor instance
+ * @param angle Angle in binary radians
+ * @return Number of steps, 0..steps_per_rev-1
+ */
+int32_t stepper_28byj48_angle_to_steps(stepper_28byj48_t *motor, fxp_angle_t angle);
+
+/**
+ * Convert steps to a fixed-point angle (whole revolutions wrap)
+ * @param motor Pointer to motor instance
+ * @param steps Number of steps
+ * @return Angle in binary radians
+ */
+fxp_angle_t stepper_28byj48_steps_to_angle(stepper_28byj48_t *motor, int32_t steps);
+
 #endif // STEPPER_28BYJ48_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Emit a pioasm-shaped header for host builds.
+
+The host tests exercise the C side of the PIO drivers, never the state
+machine programs, so instructions are left as zeros. Program length counts
+the instruction lines so program placement behaves like the real thing.
+"""
+
+import re
+import sys
+
+
+def main():
+    src_path, out_path = sys.argv[1], sys.argv[2]
+    src = open(src_path).read()
+    out = ['#pragma once', '#include "hardware/pio.h"', '']
+    programs = re.split(r'^\.program\s+', src, flags=re.M)[1:]
+    for body in programs:
+        name = body.split()[0]
+        block = body.split('% c-sdk {')[0]
+        instrs = [l for l in block.splitlines()[1:]
+                  if l.strip() and not l.strip().startswith(('.', ';', '//'))
+                  and not re.match(r'^\s*(public\s+)?\w+:\s*(;.*)?$', l)]
+        length = max(1, len(instrs))
+        origin = re.search(r'^\.origin\s+(\d+)', block, re.M)
+        origin = origin.group(1) if origin else '-1'
+        out.append(f'static const uint16_t {name}_program_instructions[{length}];')
+        out.append(f'static const struct pio_program {name}_program = '
+                   f'{{ {name}_program_instructions, {length}, {origin}, 0 }};')
+        out.append(f'#define {name}_wrap_target 0')
+        out.append(f'#define {name}_wrap {length - 1}')
+        for label in re.findall(r'^\s*public\s+(\w+):', block, re.M):
+            out.append(f'#define {name}_offset_{label} 0u')
+        for key, value in re.findall(r'^\.define\s+public\s+(\w+)\s+(\S+)', block, re.M):
+            out.append(f'#define {name}_{key} {value}')
+        out.append(f'static inline pio_sm_config {name}_program_get_default_config(uint offset) {{')
+        out.append('    (void)offset;')
+        out.append('    pio_sm_config c = {0};')
+        out.append('    return c;')
+        out.append('}')
+        out.append('')
+    for block in re.findall(r'% c-sdk \{(.*?)%\}', src, re.S):
+        out.append(block)
+    open(out_path, 'w').write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,373 @@
+/**
+ * @file fake_sdk.c
+ * @brief Host implementations of the Pico SDK calls used by lib/
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fake_sdk.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/structs/io_bank0.h"
+
+// =============================================================================
+// Clock, sleeps and timers
+// =============================================================================
+
+uint64_t fake_time_us;
+
+#define FAKE_ALARMS 16
+typedef struct {
+    alarm_id_t id;
+    uint64_t due_us;
+    alarm_callback_t callback;
+    void *user_data;
+} fake_alarm_t;
+
+static fake_alarm_t alarms[FAKE_ALARMS];
+static alarm_id_t next_alarm_id = 1;
+
+void fake_advance_us(uint64_t us) {
+    fake_time_us += us;
+    for (int i = 0; i < FAKE_ALARMS; i++) {
+        fake_alarm_t *a = &alarms[i];
+        if (!a->id || a->due_us > fake_time_us) continue;
+
+        alarm_id_t id = a->id;
+        a->id = 0;
+        int64_t again = a->callback(id, a->user_data);
+        if (again != 0) {
+            a->id = id;
+            a->due_us = again > 0 ? fake_time_us + (uint64_t)again : a->due_us + (uint64_t)-again;
+        }
+    }
+}
+
+void sleep_ms(uint32_t ms) { fake_advance_us((uint64_t)ms * 1000); }
+void sleep_us(uint64_t us) { fake_advance_us(us); }
+void busy_wait_us_32(uint32_t us) { fake_advance_us(us); }
+absolute_time_t get_absolute_time(void) { return fake_time_us; }
+uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+bool time_reached(absolute_time_t t) { return fake_time_us >= t; }
+absolute_time_t make_timeout_time_us(uint64_t us) { return fake_time_us + us; }
+absolute_time_t make_timeout_time_ms(uint32_t ms) { return fake_time_us + (uint64_t)ms * 1000; }
+bool stdio_init_all(void) { return true; }
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past;
+    for (int i = 0; i < FAKE_ALARMS; i++) {
+        if (!alarms[i].id) {
+            alarms[i] = (fake_alarm_t){next_alarm_id++, fake_time_us + us, callback, user_data};
+            return alarms[i].id;
+        }
+    }
+    return -1;
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    for (int i = 0; i < FAKE_ALARMS; i++) {
+        if (id && alarms[i].id == id) {
+            alarms[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->user_data = user_data;
+    out->callback = callback;
+    out->alarm_id = next_alarm_id++;
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    bool was_active = timer->alarm_id != 0;
+    timer->alarm_id = 0;
+    return was_active;
+}
+
+bool fake_timer_fire(repeating_timer_t *timer) {
+    if (!timer->alarm_id || !timer->callback) return false;
+    if (!timer->callback(timer)) timer->alarm_id = 0;
+    return timer->alarm_id != 0;
+}
+
+// =============================================================================
+// Cores and interrupts (single-threaded: masking is a no-op)
+// =============================================================================
+
+// Spinning lets time pass: due alarms run and a finished DMA raises its IRQ
+void tight_loop_contents(void) {
+    fake_advance_us(1);
+    for (int ch = 0; ch < FAKE_DMA_CHANNELS; ch++) {
+        if (fake_dma[ch].irq0_pending) {
+            fake_irq_fire(DMA_IRQ_0);
+            break;
+        }
+    }
+}
+
+uint get_core_num(void) { return 0; }
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) { (void)status; }
+void __dmb(void) {}
+void __wfi(void) {}
+uint32_t clock_get_hz(enum clock_index clk_index) { (void)clk_index; return 150000000; }
+
+#define FAKE_IRQ_LINES 32
+#define FAKE_IRQ_HANDLERS 4
+static irq_handler_t irq_handlers[FAKE_IRQ_LINES][FAKE_IRQ_HANDLERS];
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    for (int i = 0; i < FAKE_IRQ_HANDLERS; i++) {
+        if (!irq_handlers[num][i]) { irq_handlers[num][i] = handler; return; }
+    }
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    for (int i = 0; i < FAKE_IRQ_HANDLERS; i++) {
+        if (irq_handlers[num][i] == handler) irq_handlers[num][i] = NULL;
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
+
+void fake_irq_fire(uint num) {
+    for (int i = 0; i < FAKE_IRQ_HANDLERS; i++) {
+        if (irq_handlers[num][i]) irq_handlers[num][i]();
+    }
+}
+
+// =============================================================================
+// GPIO
+// =============================================================================
+
+uint32_t fake_gpio_levels;
+static io_bank0_hw_t fake_io_bank0;
+io_bank0_hw_t *io_bank0_hw = &fake_io_bank0;
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_pull_up(uint gpio) { (void)gpio; }
+void gpio_pull_down(uint gpio) { (void)gpio; }
+void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+
+void gpio_put(uint gpio, bool value) {
+    if (value) fake_gpio_levels |= 1u << gpio;
+    else fake_gpio_levels &= ~(1u << gpio);
+}
+
+bool gpio_get(uint gpio) { return (fake_gpio_levels >> gpio) & 1u; }
+uint32_t gpio_get_all(void) { return fake_gpio_levels; }
+
+// Like the SDK, acknowledges the events it enables or disables
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    gpio_acknowledge_irq(gpio, event_mask);
+    volatile uint32_t *inte = &io_bank0_hw->proc0_irq_ctrl.inte[gpio / 8];
+    uint32_t bits = event_mask << (4 * (gpio % 8));
+    if (enabled) *inte |= bits;
+    else *inte &= ~bits;
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+    io_bank0_hw->intr[gpio / 8] &= ~(event_mask << (4 * (gpio % 8)));
+}
+
+void gpio_add_raw_irq_handler_masked(uint32_t gpio_mask, void (*handler)(void)) {
+    (void)gpio_mask;
+    irq_add_shared_handler(IO_IRQ_BANK0, handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+}
+
+// =============================================================================
+// I2C
+// =============================================================================
+
+fake_i2c_capture_t fake_i2c;
+i2c_hw_t fake_i2c0_hw = { .status = I2C_IC_STATUS_TFE_BITS };
+static i2c_hw_t fake_i2c1_hw = { .status = I2C_IC_STATUS_TFE_BITS };
+static i2c_inst_t fake_i2c0_inst = { &fake_i2c0_hw };
+static i2c_inst_t fake_i2c1_inst = { &fake_i2c1_hw };
+i2c_inst_t *i2c0 = &fake_i2c0_inst;
+i2c_inst_t *i2c1 = &fake_i2c1_inst;
+
+void fake_i2c_reset(void) {
+    fake_i2c.transactions = 0;
+    fake_i2c.bus_bytes = 0;
+    fake_i2c.data_bytes = 0;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) { (void)i2c; return baudrate; }
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) { (void)is_tx; return i2c == i2c1 ? 34 : 32; }
+uint i2c_get_index(i2c_inst_t *i2c) { return i2c == i2c1 ? 1 : 0; }
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                         uint timeout_us) {
+    (void)i2c; (void)nostop; (void)timeout_us;
+    fake_i2c.transactions++;
+    fake_i2c.bus_bytes += 1 + len;
+    if (len > 0 && src[0] == 0x40) fake_i2c.data_bytes += len - 1;
+    if (fake_i2c.hook) fake_i2c.hook(addr, src, len, fake_i2c.hook_data);
+    return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)nostop;
+    memset(dst, 0, len);
+    return (int)len;
+}
+
+// =============================================================================
+// DMA (transfers complete instantly; the IRQ is raised but not run)
+// =============================================================================
+
+fake_dma_channel_t fake_dma[FAKE_DMA_CHANNELS];
+static uint32_t dma_claimed;
+static uint32_t dma_irq0_enabled;
+
+int dma_claim_unused_channel(bool required) {
+    (void)required;
+    for (int ch = 0; ch < FAKE_DMA_CHANNELS; ch++) {
+        if (!(dma_claimed & (1u << ch))) {
+            dma_claimed |= 1u << ch;
+            return ch;
+        }
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) { dma_claimed &= ~(1u << channel); }
+dma_channel_config dma_channel_get_default_config(uint channel) { (void)channel; return (dma_channel_config){0}; }
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { (void)c; (void)size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    (void)config; (void)write_addr;
+    fake_dma[channel].read_addr = read_addr;
+    fake_dma[channel].count = transfer_count;
+    if (trigger) dma_channel_transfer_from_buffer_now(channel, read_addr, transfer_count);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    fake_dma[channel].read_addr = read_addr;
+    fake_dma[channel].count = transfer_count;
+    fake_dma[channel].starts++;
+    if (dma_irq0_enabled & (1u << channel)) fake_dma[channel].irq0_pending = true;
+}
+
+bool dma_channel_is_busy(uint channel) { (void)channel; return false; }
+void dma_channel_abort(uint channel) { fake_dma[channel].irq0_pending = false; }
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    if (enabled) dma_irq0_enabled |= 1u << channel;
+    else dma_irq0_enabled &= ~(1u << channel);
+}
+
+bool dma_channel_get_irq0_status(uint channel) { return fake_dma[channel].irq0_pending; }
+void dma_channel_acknowledge_irq0(uint channel) { fake_dma[channel].irq0_pending = false; }
+
+// =============================================================================
+// PIO
+// =============================================================================
+
+static pio_hw_t fake_pio_hw[3];
+PIO pio0 = &fake_pio_hw[0];
+PIO pio1 = &fake_pio_hw[1];
+PIO pio2 = &fake_pio_hw[2];
+static uint32_t pio_claimed[3];
+static uint32_t pio_used[3];
+
+uint32_t fake_pio_tx[FAKE_PIO_CAPTURE_WORDS];
+uint32_t fake_pio_tx_count;
+
+uint pio_get_index(PIO pio) { return (uint)(pio - fake_pio_hw); }
+
+static uint32_t program_mask(const pio_program_t *program, uint offset) {
+    uint32_t bits = program->length >= 32 ? 0xFFFFFFFFu : (1u << program->length) - 1;
+    return bits << offset;
+}
+
+bool pio_can_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
+    if (offset + program->length > 32) return false;
+    return !(pio_used[pio_get_index(pio)] & program_mask(program, offset));
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    for (uint offset = 0; offset + program->length <= 32; offset++) {
+        if (pio_can_add_program_at_offset(pio, program, offset)) return true;
+    }
+    return false;
+}
+
+int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
+    if (!pio_can_add_program_at_offset(pio, program, offset)) return -1;
+    pio_used[pio_get_index(pio)] |= program_mask(program, offset);
+    return (int)offset;
+}
+
+int pio_add_program(PIO pio, const pio_program_t *program) {
+    for (uint offset = 0; offset + program->length <= 32; offset++) {
+        if (pio_can_add_program_at_offset(pio, program, offset)) {
+            return pio_add_program_at_offset(pio, program, offset);
+        }
+    }
+    return -1;
+}
+
+void pio_remove_program(PIO pio, const pio_program_t *program, uint offset) {
+    pio_used[pio_get_index(pio)] &= ~program_mask(program, offset);
+}
+
+void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    (void)pio; (void)sm; (void)pin_base; (void)pin_count; (void)is_out;
+    return 0;
+}
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) { (void)c; (void)sideset_base; }
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) { (void)c; (void)out_base; (void)out_count; }
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base) { (void)c; (void)in_base; }
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    (void)c; (void)shift_right; (void)autopull; (void)pull_threshold;
+}
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) {
+    (void)c; (void)shift_right; (void)autopush; (void)push_threshold;
+}
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) { (void)c; (void)join; }
+void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void)c; (void)div; }
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    (void)pio; (void)sm; (void)initial_pc; (void)config;
+    return 0;
+}
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    (void)pio; (void)sm;
+    if (fake_pio_tx_count < FAKE_PIO_CAPTURE_WORDS) fake_pio_tx[fake_pio_tx_count] = data;
+    fake_pio_tx_count++;
+}
+
+uint32_t pio_sm_get_blocking(PIO pio, uint sm) { (void)pio; (void)sm; return 0; }
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm) { (void)pio; (void)sm; return 0; }
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm) { (void)pio; (void)sm; return 0; }
+void pio_sm_exec(PIO pio, uint sm, uint instr) { (void)pio; (void)sm; (void)instr; }
+void pio_sm_claim(PIO pio, uint sm) { pio_claimed[pio_get_index(pio)] |= 1u << sm; }
+void pio_sm_unclaim(PIO pio, uint sm) { pio_claimed[pio_get_index(pio)] &= ~(1u << sm); }
+bool pio_sm_is_claimed(PIO pio, uint sm) { return pio_claimed[pio_get_index(pio)] & (1u << sm); }
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return pio_get_index(pio) * 8 + sm + (is_tx ? 0 : 4); }
+uint pio_encode_mov(enum pio_src_dest dest, enum pio_src_dest src) { return 0xA000u | (dest << 5) | src; }
+uint pio_encode_in(enum pio_src_dest src, uint count) { return 0x4000u | (src << 5) | (count & 31); }
@@ -0,0 +1,92 @@
+/**
+ * @file fake_sdk.h
+ * @brief Test hooks into the host Pico SDK fakes
+ *
+ * The fakes keep just enough state for the drivers to run on the host: a
+ * settable clock, GPIO input levels, a capture of every I2C write, the words
+ * pushed into each PIO TX FIFO, and the handlers registered per IRQ line.
+ * Nothing runs asynchronously: tests fire IRQs and timers explicitly, and
+ * alarms run only as fake time advances.
+ */
+
+#ifndef FAKE_SDK_H
+#define FAKE_SDK_H
+
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+
+// =============================================================================
+// Clock
+// =============================================================================
+
+/** Current time returned by get_absolute_time */
+extern uint64_t fake_time_us;
+
+/**
+ * Let time pass, running alarms that fall due. Sleeps advance through here,
+ * and tight_loop_contents advances 1 us and also raises DMA_IRQ_0 for any
+ * channel whose transfer was started with its IRQ enabled.
+ */
+void fake_advance_us(uint64_t us);
+
+// =============================================================================
+// GPIO
+// =============================================================================
+
+/** Input levels returned by gpio_get / gpio_get_all (bit n = GPIO n) */
+extern uint32_t fake_gpio_levels;
+
+// =============================================================================
+// I2C
+// =============================================================================
+
+/** Called for every i2c_write_timeout_us with the payload (control byte first) */
+typedef void (*fake_i2c_hook_t)(uint8_t addr, const uint8_t *data, size_t len, void *user_data);
+
+/** Write capture; bus_bytes counts the address byte plus the payload */
+typedef struct {
+    uint32_t transactions;
+    uint32_t bus_bytes;
+    uint32_t data_bytes;        ///< Payload bytes following a 0x40 control byte
+    fake_i2c_hook_t hook;
+    void *hook_data;
+} fake_i2c_capture_t;
+
+extern fake_i2c_capture_t fake_i2c;
+
+/** Register file behind i2c0 (status reads idle with an empty TX FIFO) */
+extern i2c_hw_t fake_i2c0_hw;
+
+/** Zero the counters (the hook is kept) */
+void fake_i2c_reset(void);
+
+// =============================================================================
+// PIO / DMA / IRQ
+// =============================================================================
+
+#define FAKE_PIO_CAPTURE_WORDS 8192
+
+/** Words pushed by pio_sm_put_blocking, across all state machines */
+extern uint32_t fake_pio_tx[FAKE_PIO_CAPTURE_WORDS];
+extern uint32_t fake_pio_tx_count;
+
+/** Last buffer started on a DMA channel */
+typedef struct {
+    const volatile void *read_addr;
+    uint32_t count;
+    uint32_t starts;
+    bool irq0_pending;
+} fake_dma_channel_t;
+
+#define FAKE_DMA_CHANNELS 16
+extern fake_dma_channel_t fake_dma[FAKE_DMA_CHANNELS];
+
+/** Run every handler registered on an IRQ line */
+void fake_irq_fire(uint num);
+
+/** Run a repeating timer's callback once, as its alarm would */
+bool fake_timer_fire(repeating_timer_t *timer);
+
+#endif // FAKE_SDK_H
@@ -0,0 +1,6 @@
+// Host stand-in for the Pico SDK (atomic set/clear aliases become plain read-modify-write)
+#pragma once
+#include "pico/types.h"
+
+static inline void hw_set_bits(volatile uint32_t *addr, uint32_t mask) { *addr |= mask; }
+static inline void hw_clear_bits(volatile uint32_t *addr, uint32_t mask) { *addr &= ~mask; }
@@ -0,0 +1,6 @@
+// Host stand-in for the Pico SDK (declarations only; see fake_sdk.c)
+#pragma once
+#include "pico/types.h"
+
+enum clock_index { clk_sys = 5 };
+uint32_t clock_get_hz(enum clock_index clk_index);
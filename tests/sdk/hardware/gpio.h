@@ -0,0 +1,26 @@
+// Host stand-in for the Pico SDK (declarations only; see fake_sdk.c)
+#pragma once
+#include "pico/types.h"
+
+#define NUM_BANK0_GPIOS 30
+
+enum { GPIO_IN = 0, GPIO_OUT = 1 };
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7 };
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 1,
+    GPIO_IRQ_LEVEL_HIGH = 2,
+    GPIO_IRQ_EDGE_FALL = 4,
+    GPIO_IRQ_EDGE_RISE = 8,
+};
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all(void);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled);
+void gpio_add_raw_irq_handler_masked(uint32_t gpio_mask, void (*handler)(void));
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask);
@@ -0,0 +1,39 @@
+// Host stand-in for the Pico SDK (declarations only; see fake_sdk.c)
+#pragma once
+#include "pico/types.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS           0x200
+#define I2C_IC_DATA_CMD_RESTART_BITS        0x400
+#define I2C_IC_ENABLE_ENABLE_BITS           0x1
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS   0x40
+#define I2C_IC_RAW_INTR_STAT_STOP_DET_BITS  0x200
+#define I2C_IC_INTR_MASK_M_TX_ABRT_BITS     0x40
+#define I2C_IC_INTR_MASK_M_STOP_DET_BITS    0x200
+#define I2C_IC_INTR_STAT_R_TX_ABRT_BITS     0x40
+#define I2C_IC_INTR_STAT_R_STOP_DET_BITS    0x200
+#define I2C_IC_STATUS_ACTIVITY_BITS         0x1
+#define I2C_IC_STATUS_TFE_BITS              0x4
+
+typedef struct {
+    volatile uint32_t con, tar, sar, pad0, data_cmd;
+    volatile uint32_t intr_stat, intr_mask, raw_intr_stat;
+    volatile uint32_t clr_intr, clr_tx_abrt, clr_stop_det;
+    volatile uint32_t enable, status, txflr, tx_abrt_source;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+    i2c_hw_t *hw;
+} i2c_inst_t;
+
+extern i2c_inst_t *i2c0, *i2c1;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop,
+                         uint timeout_us);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+uint i2c_get_index(i2c_inst_t *i2c);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    return i2c->hw;
+}
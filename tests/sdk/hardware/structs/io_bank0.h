@@ -0,0 +1,17 @@
+// Host stand-in for the Pico SDK (declarations only; see fake_sdk.c)
+#pragma once
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t inte[6];
+    volatile uint32_t intf[6];
+    volatile uint32_t ints[6];
+} io_bank0_irq_ctrl_hw_t;
+
+typedef struct {
+    volatile uint32_t intr[6];
+    io_bank0_irq_ctrl_hw_t proc0_irq_ctrl;
+    io_bank0_irq_ctrl_hw_t proc1_irq_ctrl;
+} io_bank0_hw_t;
+
+extern io_bank0_hw_t *io_bank0_hw;
@@ -0,0 +1,10 @@
+// Host stand-in for the Pico SDK (declarations only; see fake_sdk.c)
+#pragma once
+#include "pico/types.h"
+
+#define __not_in_flash_func(x) x
+#define __time_critical_func(x) x
+#define __isr
+
+uint get_core_num(void);
+void tight_loop_contents(void);
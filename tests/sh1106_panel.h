@@ -0,0 +1,93 @@
+/**
+ * @file sh1106_panel.h
+ * @brief Model of SH1106 display RAM driven by the fake I2C capture
+ *
+ * Decodes control bytes, page/column addressing and start line commands from
+ * each captured write so tests can check that the panel ends up showing
+ * exactly what the driver's buffer holds.
+ */
+
+#ifndef SH1106_PANEL_H
+#define SH1106_PANEL_H
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+
+#define PANEL_RAM_COLUMNS 132
+
+typedef struct {
+    uint8_t ram[SH1106_PAGES][PANEL_RAM_COLUMNS];
+    uint8_t page;
+    uint8_t column;
+    uint8_t start_line;
+    uint32_t commands;      ///< Command bytes received
+} sh1106_panel_t;
+
+// Operand count for the SH1106 two-byte commands used by the driver
+static inline int panel_operands(uint8_t cmd) {
+    switch (cmd) {
+        case SH1106_CMD_SET_CONTRAST:
+        case SH1106_CMD_SET_MULTIPLEX:
+        case SH1106_CMD_SET_DCDC:
+        case SH1106_CMD_SET_DISPLAY_OFFSET:
+        case SH1106_CMD_SET_DISPLAY_CLOCK:
+        case SH1106_CMD_SET_PRECHARGE:
+        case SH1106_CMD_SET_COM_PINS:
+        case SH1106_CMD_SET_VCOM_DESELECT:
+        case SSD1306_CMD_CHARGE_PUMP:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static inline void panel_write(uint8_t addr, const uint8_t *data, size_t len, void *user_data) {
+    sh1106_panel_t *panel = user_data;
+    (void)addr;
+    if (len == 0) return;
+
+    if (data[0] == SH1106_CTRL_DATA_STREAM) {
+        for (size_t i = 1; i < len; i++) {
+            if (panel->column < PANEL_RAM_COLUMNS) panel->ram[panel->page][panel->column] = data[i];
+            panel->column++;
+        }
+        return;
+    }
+
+    for (size_t i = 1; i < len; i++) {
+        uint8_t cmd = data[i];
+        panel->commands++;
+        if ((cmd & 0xF0) == SH1106_CMD_SET_PAGE_ADDR) {
+            panel->page = cmd & 0x07;
+        } else if ((cmd & 0xF0) == SH1106_CMD_SET_COLUMN_ADDR_HIGH) {
+            panel->column = (uint8_t)((panel->column & 0x0F) | ((cmd & 0x0F) << 4));
+        } else if ((cmd & 0xF0) == SH1106_CMD_SET_COLUMN_ADDR_LOW) {
+            panel->column = (uint8_t)((panel->column & 0xF0) | (cmd & 0x0F));
+        } else if ((cmd & 0xC0) == SH1106_CMD_SET_START_LINE) {
+            panel->start_line = cmd & 0x3F;
+        } else {
+            i += panel_operands(cmd);
+        }
+    }
+}
+
+/** Route captured I2C writes into a panel model (RAM starts cleared) */
+static inline void panel_attach(sh1106_panel_t *panel) {
+    memset(panel, 0, sizeof(*panel));
+    fake_i2c.hook = panel_write;
+    fake_i2c.hook_data = panel;
+}
+
+/** True when the visible columns of panel RAM equal the display buffer */
+static inline bool panel_matches(const sh1106_panel_t *panel, const sh1106_t *display) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        if (memcmp(&panel->ram[page][SH1106_COL_OFFSET], &display->buffer[page * SH1106_WIDTH],
+                   SH1106_WIDTH) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // SH1106_PANEL_H
@@ -0,0 +1,46 @@
+/**
+ * @file test_common.h
+ * @brief Minimal check macros and a host timer for the lib/ tests
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static int test_failures;
+
+/** Record a failure (and keep going) when cond is false */
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        test_failures++; \
+    } \
+} while (0)
+
+/** Record a failure when two integers differ, printing both */
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        printf("%s:%d: CHECK_EQ failed: %s == %lld, expected %lld\n", \
+               __FILE__, __LINE__, #actual, a_, e_); \
+        test_failures++; \
+    } \
+} while (0)
+
+/** Exit status for main(): non-zero when any check failed */
+#define TEST_RESULT() (printf("%s\n", test_failures ? "FAIL" : "PASS"), test_failures ? EXIT_FAILURE : EXIT_SUCCESS)
+
+/** Monotonic host time in nanoseconds (benchmarks only) */
+static inline uint64_t test_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/** Keep a benchmark result alive without the compiler seeing through it */
+static volatile uint32_t test_sink;
+
+#endif // TEST_COMMON_H
@@ -0,0 +1,269 @@
+/**
+ * @file test_encoder_ec11.c
+ * @brief EC11 detent decoding with contact bounce, and polling per instance
+ */
+
+#include "lib.h"
+#include "hardware/irq.h"
+#include "hardware/structs/io_bank0.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define PIN_A 2
+#define PIN_B 3
+
+// A and B levels, as the handler's state = (A << 1) | B
+#define LEVELS(state) (((((state) >> 1) & 1u) << PIN_A) | (((state) & 1u) << PIN_B))
+
+static uint32_t rng = 11;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static int cw_events, ccw_events;
+static int32_t last_event_position;
+
+static void on_event(encoder_event_t event, int32_t position) {
+    if (event == ENCODER_EVENT_CW) cw_events++;
+    if (event == ENCODER_EVENT_CCW) ccw_events++;
+    last_event_position = position;
+}
+
+// Latch an edge on pin and run the GPIO interrupt, which reads both pins
+static void irq(uint pin) {
+    fake_advance_us(3);
+    io_bank0_hw->proc0_irq_ctrl.ints[pin / 8] = (uint32_t)(GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL) << (4 * (pin % 8));
+    fake_irq_fire(IO_IRQ_BANK0);
+    io_bank0_hw->proc0_irq_ctrl.ints[pin / 8] = 0;
+}
+
+// Set the pins to a state and interrupt for the pin that changed
+static void move_to(uint32_t state) {
+    uint32_t changed = fake_gpio_levels ^ LEVELS(state);
+    fake_gpio_levels = LEVELS(state);
+    irq((changed & (1u << PIN_A)) ? PIN_A : PIN_B);
+}
+
+// One quadrature edge with chatter: some bounces are read (a step back and
+// forth), others are over before the handler runs (it finds no change)
+static void bouncy_edge(uint32_t from, uint32_t to) {
+    uint32_t chatter = next_rand() % 4;
+    for (uint32_t i = 0; i < chatter; i++) {
+        if (next_rand() & 1) {
+            move_to(to);
+            move_to(from);
+        } else {
+            irq(PIN_A);
+        }
+    }
+    move_to(to);
+}
+
+// From rest (A=1, B=1) clockwise: 11 -> 01 -> 00 -> 10 -> 11
+static const uint32_t cw_cycle[4] = {3, 1, 0, 2};
+
+static void turn(int32_t detents) {
+    for (int32_t d = 0; d < (detents < 0 ? -detents : detents); d++) {
+        for (int e = 0; e < 4; e++) {
+            int i = (detents > 0) ? e : 4 - e;
+            bouncy_edge(cw_cycle[i % 4], cw_cycle[(detents > 0 ? i + 1 : i - 1) % 4]);
+        }
+    }
+}
+
+static void init_encoder(encoder_ec11_t *enc, uint8_t hysteresis) {
+    encoder_config_t config = {
+        .pin_a = PIN_A, .pin_b = PIN_B, .pin_button = (uint)-1,
+        .pull_up = true, .detent_hysteresis = hysteresis,
+    };
+    fake_gpio_levels = LEVELS(3);
+    CHECK_EQ(encoder_ec11_init(enc, &config), HW_OK);
+    CHECK_EQ(encoder_ec11_enable_interrupts(enc), HW_OK);
+    encoder_ec11_set_callback(enc, on_event);
+    cw_events = ccw_events = 0;
+}
+
+// =============================================================================
+// Bounce
+// =============================================================================
+
+static void test_no_drift(void) {
+    encoder_ec11_t enc;
+    init_encoder(&enc, 0);
+
+    // Back and forth with chatter on every edge: one event per detent, and
+    // the position lands exactly on the detent count at every rest
+    int32_t expected = 0;
+    static const int32_t legs[] = {120, -75, 30, -200, 125};
+    for (unsigned i = 0; i < sizeof(legs) / sizeof(legs[0]); i++) {
+        int cw = cw_events, ccw = ccw_events;
+        turn(legs[i]);
+        expected += legs[i];
+        CHECK_EQ(enc.position, expected);
+        CHECK_EQ(enc.detent_count, 0);
+        CHECK_EQ(cw_events - cw, legs[i] > 0 ? legs[i] : 0);
+        CHECK_EQ(ccw_events - ccw, legs[i] < 0 ? -legs[i] : 0);
+        CHECK_EQ(last_event_position, expected);
+    }
+
+    encoder_stats_t stats;
+    encoder_ec11_get_stats(&enc, &stats);
+    printf("550 bouncy detents: %u bounces, %u illegal, %u partial\n",
+           (unsigned)stats.bounces, (unsigned)stats.illegal_transitions, (unsigned)stats.partial_detents);
+    CHECK(stats.bounces > 0);
+    CHECK_EQ(stats.illegal_transitions, 0);
+    CHECK_EQ(stats.partial_detents, 0);
+
+    // Chatter back into the rest state halfway into a detent reports nothing
+    move_to(1);
+    move_to(0);
+    move_to(1);
+    move_to(3);
+    CHECK_EQ(enc.position, expected);
+    CHECK_EQ(cw_events + ccw_events, 550);
+
+    encoder_ec11_deinit(&enc);
+}
+
+// =============================================================================
+// Missed edges
+// =============================================================================
+
+static void test_missed_edges(void) {
+    encoder_ec11_t enc;
+    encoder_stats_t stats;
+
+    // Default hysteresis (half a detent): a detent two counts short at rest
+    // still registers
+    init_encoder(&enc, 0);
+    move_to(1);
+    fake_gpio_levels = LEVELS(2);   // 01 -> 10: the 00 edge was missed
+    irq(PIN_A);
+    move_to(3);
+    encoder_ec11_get_stats(&enc, &stats);
+    CHECK_EQ(stats.illegal_transitions, 1);
+    CHECK_EQ(stats.partial_detents, 0);
+    CHECK_EQ(enc.position, 1);
+    CHECK_EQ(cw_events, 1);
+
+    // The shortfall is dropped rather than carried into the next detent
+    turn(-3);
+    CHECK_EQ(enc.position, -2);
+    CHECK_EQ(ccw_events, 3);
+
+    // Two missed edges in a row skip a whole detent's worth of direction
+    fake_gpio_levels = LEVELS(0);
+    irq(PIN_A);
+    fake_gpio_levels = LEVELS(3);
+    irq(PIN_B);
+    encoder_ec11_get_stats(&enc, &stats);
+    CHECK_EQ(stats.illegal_transitions, 3);
+    CHECK_EQ(enc.position, -2);
+    encoder_ec11_deinit(&enc);
+
+    // Hysteresis of one count: the same two-count shortfall is abandoned
+    init_encoder(&enc, 1);
+    move_to(1);
+    fake_gpio_levels = LEVELS(2);
+    irq(PIN_A);
+    move_to(3);
+    encoder_ec11_get_stats(&enc, &stats);
+    CHECK_EQ(stats.illegal_transitions, 1);
+    CHECK_EQ(stats.partial_detents, 1);
+    CHECK_EQ(enc.position, 0);
+    CHECK_EQ(cw_events + ccw_events, 0);
+
+    turn(2);
+    CHECK_EQ(enc.position, 2);
+
+    encoder_ec11_reset_stats(&enc);
+    encoder_ec11_get_stats(&enc, &stats);
+    CHECK_EQ(stats.illegal_transitions + stats.bounces + stats.partial_detents, 0);
+    encoder_ec11_deinit(&enc);
+}
+
+// =============================================================================
+// Polling
+// =============================================================================
+
+// One detent on a sampled encoder, through the same cycle as turn()
+static void sampled_detent(encoder_ec11_t *enc, uint32_t *levels, int dir) {
+    uint32_t pins = (1u << enc->config.pin_a) | (1u << enc->config.pin_b);
+    for (int e = 1; e <= 4; e++) {
+        uint32_t state = cw_cycle[(dir > 0 ? e : 4 - e) % 4];
+        *levels = (*levels & ~pins) | ((state >> 1) << enc->config.pin_a) | ((state & 1) << enc->config.pin_b);
+        fake_advance_us(250);
+        encoder_ec11_process_sample(enc, *levels, fake_time_us);
+    }
+}
+
+static void init_sampled(encoder_ec11_t *enc, uint pin_a, uint pin_b, uint32_t *levels) {
+    encoder_config_t config = {
+        .pin_a = pin_a, .pin_b = pin_b, .pin_button = (uint)-1,
+        .pull_up = true, .backend = ENCODER_BACKEND_SAMPLED,
+    };
+    *levels |= (1u << pin_a) | (1u << pin_b);
+    fake_gpio_levels = *levels;
+    CHECK_EQ(encoder_ec11_init(enc, &config), HW_OK);
+}
+
+static void test_poll(void) {
+    encoder_ec11_t left, right;
+    uint32_t levels = 0;
+    init_sampled(&left, 6, 7, &levels);
+    init_sampled(&right, 8, 9, &levels);
+
+    // Interleaved turning: each encoder only reports its own detents
+    for (int i = 0; i < 5; i++) {
+        sampled_detent(&left, &levels, +1);
+        sampled_detent(&right, &levels, -1);
+        sampled_detent(&right, &levels, -1);
+    }
+    CHECK_EQ(encoder_ec11_get_delta(&left), 5);
+    CHECK_EQ(encoder_ec11_get_delta(&left), 0);
+    int ccw = 0;
+    encoder_event_t event;
+    while ((event = encoder_ec11_poll(&right)) != ENCODER_EVENT_NONE) {
+        CHECK_EQ(event, ENCODER_EVENT_CCW);
+        ccw++;
+    }
+    CHECK_EQ(ccw, 10);
+    CHECK_EQ(encoder_ec11_get_delta(&right), 0);
+    CHECK_EQ(encoder_ec11_poll(&left), ENCODER_EVENT_NONE);
+
+    // Poll and get_delta share the unread steps: nothing is reported twice
+    for (int i = 0; i < 4; i++) sampled_detent(&left, &levels, +1);
+    CHECK_EQ(encoder_ec11_poll(&left), ENCODER_EVENT_CW);
+    CHECK_EQ(encoder_ec11_get_delta(&left), 3);
+    CHECK_EQ(encoder_ec11_poll(&left), ENCODER_EVENT_NONE);
+    sampled_detent(&left, &levels, -1);
+    sampled_detent(&left, &levels, +1);
+    sampled_detent(&left, &levels, +1);
+    CHECK_EQ(encoder_ec11_poll(&left), ENCODER_EVENT_CW);
+    CHECK_EQ(encoder_ec11_get_delta(&left), 0);
+
+    // Wrapping below the limit reports the rotation, not the jump in position
+    encoder_ec11_set_limits(&right, 0, 19, true);
+    encoder_ec11_set_position(&right, 0);
+    sampled_detent(&right, &levels, -1);
+    CHECK_EQ(right.position, 19);
+    CHECK_EQ(encoder_ec11_get_delta(&right), -1);
+    sampled_detent(&right, &levels, +1);
+    CHECK_EQ(right.position, 0);
+    CHECK_EQ(encoder_ec11_poll(&right), ENCODER_EVENT_CW);
+    CHECK_EQ(encoder_ec11_poll(&right), ENCODER_EVENT_NONE);
+
+    CHECK_EQ(left.position, 10);
+    CHECK_EQ(encoder_ec11_get_delta(&left), 0);
+}
+
+int main(void) {
+    test_no_drift();
+    test_missed_edges();
+    test_poll();
+    return TEST_RESULT();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_encoder_sampler.c
+ * @brief Bulk-sampled decoding of 8 encoders and 2 buttons, and the cost of one tick
+ */
+
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define NUM_ENCODERS 8
+#define BUTTON_PIN 20
+
+// Clockwise states (A << 1 | B) starting one step before rest (11)
+static const uint8_t cw_states[4] = {0, 2, 3, 1};
+
+static encoder_ec11_t encoders[NUM_ENCODERS];
+static button_t buttons[2];
+static encoder_sampler_t sampler;
+static uint64_t now;
+
+// Encoder i sits on GPIO 2i (A) and 2i + 1 (B)
+static uint32_t with_state(uint32_t levels, int i, uint8_t state) {
+    uint32_t bits = (uint32_t)((state >> 1) | ((state & 1) << 1));
+    return (levels & ~(3u << (2 * i))) | (bits << (2 * i));
+}
+
+static void test_decode(void) {
+    // Everything idle high: encoders at rest in 11, active-low buttons released
+    fake_gpio_levels = 0xFFFFFFFFu;
+    encoder_sampler_init(&sampler);
+    for (int i = 0; i < NUM_ENCODERS; i++) {
+        encoder_config_t config = {
+            .pin_a = 2 * i, .pin_b = 2 * i + 1, .pin_button = (uint)-1,
+            .pull_up = true, .backend = ENCODER_BACKEND_SAMPLED,
+        };
+        CHECK_EQ(encoder_ec11_init(&encoders[i], &config), HW_OK);
+        CHECK_EQ(encoder_sampler_add_encoder(&sampler, &encoders[i]), HW_OK);
+    }
+
+    encoder_config_t irq_config = { .pin_a = 24, .pin_b = 25, .pin_button = (uint)-1 };
+    encoder_ec11_t irq_encoder;
+    encoder_ec11_init(&irq_encoder, &irq_config);
+    CHECK_EQ(encoder_sampler_add_encoder(&sampler, &irq_encoder), HW_INVALID_PARAM);
+
+    for (int i = 0; i < 2; i++) {
+        button_config_t config = { .pin = BUTTON_PIN + i, .active_low = true, .pull_up = true };
+        CHECK_EQ(button_init(&buttons[i], &config), HW_OK);
+        CHECK_EQ(encoder_sampler_add_button(&sampler, &buttons[i]), HW_OK);
+    }
+
+    // Start through the timer path: the first snapshot is taken at start
+    CHECK_EQ(encoder_sampler_start(&sampler, 0), HW_OK);
+
+    // Encoder i turns i + 1 detents (odd encoders counter-clockwise), all at
+    // once, with three ticks per state
+    int phase[NUM_ENCODERS] = {0};
+    for (int step = 0; step < 4 * NUM_ENCODERS; step++) {
+        for (int i = 0; i < NUM_ENCODERS; i++) {
+            if (step < 4 * (i + 1)) {
+                phase[i] += (i & 1) ? -1 : 1;
+                fake_gpio_levels = with_state(fake_gpio_levels, i, cw_states[(phase[i] + 2 + 400) & 3]);
+            }
+        }
+        for (int k = 0; k < 3; k++) {
+            fake_time_us = now += 250;
+            fake_timer_fire(&sampler.timer);
+        }
+    }
+    for (int i = 0; i < NUM_ENCODERS; i++) {
+        CHECK_EQ(encoders[i].position, (i & 1) ? -(i + 1) : i + 1);
+    }
+    CHECK_EQ(sampler.ticks, 4 * NUM_ENCODERS * 3);
+
+    // Only the button whose pin changed sees it
+    fake_gpio_levels &= ~(1u << (BUTTON_PIN + 1));
+    fake_time_us = now += 250;
+    fake_timer_fire(&sampler.timer);
+    CHECK(!buttons[0].raw_state);
+    CHECK(buttons[1].raw_state);
+    fake_gpio_levels |= 1u << (BUTTON_PIN + 1);
+    fake_time_us = now += 250;
+    fake_timer_fire(&sampler.timer);
+
+    encoder_sampler_stop(&sampler);
+    CHECK(!sampler.running);
+}
+
+static void bench(void) {
+    enum { IDLE_TICKS = 10000000, BUSY_TICKS = 2000000 };
+    uint32_t idle = fake_gpio_levels;
+
+    uint64_t t0 = test_now_ns();
+    for (int r = 0; r < IDLE_TICKS; r++) {
+        encoder_sampler_process(&sampler, idle, now += 250);
+    }
+    double idle_ns = (double)(test_now_ns() - t0) / IDLE_TICKS;
+
+    // Every encoder moves one state on every tick
+    uint32_t snapshots[4];
+    for (int p = 0; p < 4; p++) {
+        snapshots[p] = idle;
+        for (int i = 0; i < NUM_ENCODERS; i++) {
+            snapshots[p] = with_state(snapshots[p], i, cw_states[(p + 2) & 3]);
+        }
+    }
+    t0 = test_now_ns();
+    for (int r = 0; r < BUSY_TICKS; r++) {
+        encoder_sampler_process(&sampler, snapshots[r & 3], now += 250);
+    }
+    double busy_ns = (double)(test_now_ns() - t0) / BUSY_TICKS;
+
+    int32_t sum = 0;
+    for (int i = 0; i < NUM_ENCODERS; i++) sum += encoders[i].position;
+    test_sink = (uint32_t)sum;
+
+    printf("%d encoders: idle tick %.1f ns, all turning %.1f ns/tick (%.1f ns per encoder)\n",
+           NUM_ENCODERS, idle_ns, busy_ns, busy_ns / NUM_ENCODERS);
+}
+
+int main(void) {
+    test_decode();
+    bench();
+    return TEST_RESULT();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file test_encoder_velocity.c
+ * @brief Speed estimate and acceleration replayed from bouncy quadrature traces
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define PIN_A 2
+#define PIN_B 3
+
+static uint32_t rng = 7;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// =============================================================================
+// Estimator on clean edge streams
+// =============================================================================
+
+// Uneven quadrature spacing with +-5% jitter; returns the worst relative
+// error over the second half of the run
+static double replay_edges(encoder_velocity_t *v, double rate, int dir) {
+    static const double phase[4] = {0.0, 0.32, 0.5, 0.78};
+    double cycle_us = 4e6 / rate;
+    double duration = MAX(3e6, 40 * cycle_us);
+    double worst = 0;
+
+    for (int64_t k = 0;; k++) {
+        double base = (double)(k / 4) * cycle_us + phase[k % 4] * cycle_us;
+        if (base > duration) break;
+        double jitter = ((double)(next_rand() % 2001) / 1000.0 - 1.0) * 0.05 * cycle_us / 4;
+        uint64_t t = (uint64_t)(1000 + base + jitter);
+        encoder_velocity_add(v, dir, t);
+        if (base > duration / 2) {
+            double err = fabs(dir * encoder_velocity_get(v, t) - rate);
+            err = (err <= 1) ? 0 : err / rate;
+            if (err > worst) worst = err;
+        }
+    }
+    return worst;
+}
+
+static void test_estimator(void) {
+    static const double rates[] = {8, 13, 80, 400, 1333, 4000};
+    for (unsigned i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        encoder_velocity_t v;
+        encoder_velocity_init(&v, NULL);
+        double err = replay_edges(&v, rates[i], (i & 1) ? -1 : 1);
+        if (err >= 0.03) printf("rate %.0f/s: error %.2f%%\n", rates[i], err * 100);
+        CHECK(err < 0.03);
+    }
+
+    CHECK_EQ(encoder_velocity_to_rpm(400, 80), 300);
+    CHECK_EQ(encoder_velocity_to_rpm(-20, 20), -60);
+}
+
+// =============================================================================
+// Encoder replay with contact bounce
+// =============================================================================
+
+typedef struct {
+    int32_t min_estimate;   ///< Lowest estimate seen after the first 200 ms
+    int32_t max_estimate;   ///< Highest estimate seen after the first 200 ms
+    int32_t moved_late;     ///< Position change over the second half of the detents
+} replay_t;
+
+static uint64_t now;
+static uint32_t levels;
+
+static void feed(encoder_ec11_t *enc, uint32_t new_levels, uint64_t t) {
+    levels = new_levels;
+    now = t;
+    fake_time_us = t;
+    encoder_ec11_process_sample(enc, levels, t);
+}
+
+// One quadrature edge on pin, chattering twice over ~80 us before it settles
+static void bouncy_edge(encoder_ec11_t *enc, uint pin, uint64_t t) {
+    static const uint16_t chatter_us[] = {0, 12, 27, 45, 80};
+    uint32_t before = levels;
+    uint32_t after = levels ^ (1u << pin);
+    for (unsigned i = 0; i < sizeof(chatter_us) / sizeof(chatter_us[0]); i++) {
+        feed(enc, (i & 1) ? before : after, t + chatter_us[i]);
+    }
+}
+
+// Turn CW through detents at rate detents/s, starting at now
+static replay_t turn(encoder_ec11_t *enc, double rate, uint32_t detents) {
+    // From rest (A=1, B=1) clockwise: 11 -> 01 -> 00 -> 10 -> 11
+    static const uint pins[4] = {PIN_A, PIN_B, PIN_A, PIN_B};
+    double detent_us = 1e6 / rate;
+    uint64_t start = now;
+    int32_t half_position = enc->position;
+    replay_t r = {INT32_MAX, INT32_MIN, 0};
+
+    for (uint32_t d = 0; d < detents; d++) {
+        for (int e = 0; e < 4; e++) {
+            double jitter = ((double)(next_rand() % 201) / 100.0 - 1.0) * 0.05 * detent_us / 4;
+            uint64_t t = start + (uint64_t)(d * detent_us + e * detent_us / 4 + jitter);
+            bouncy_edge(enc, pins[e], t);
+        }
+        if (now - start > 200000) {
+            int32_t v = encoder_velocity_get(&enc->velocity, now);
+            r.min_estimate = MIN(r.min_estimate, v);
+            r.max_estimate = MAX(r.max_estimate, v);
+        }
+        if (d + 1 == detents / 2) {
+            half_position = enc->position;
+        }
+    }
+    r.moved_late = enc->position - half_position;
+    now += 500000;  // Come to rest
+    return r;
+}
+
+static void init_encoder(encoder_ec11_t *enc) {
+    encoder_config_t config = {
+        .pin_a = PIN_A, .pin_b = PIN_B, .pin_button = (uint)-1,
+        .pull_up = true, .backend = ENCODER_BACKEND_SAMPLED,
+    };
+    levels = (1u << PIN_A) | (1u << PIN_B);
+    fake_gpio_levels = levels;
+    CHECK_EQ(encoder_ec11_init(enc, &config), HW_OK);
+}
+
+static void test_bouncy_replay(void) {
+    // Detents closer than the default 250 ms timeout, i.e. faster than 4/s
+    static const double rates[] = {6, 12, 30, 60};
+    for (unsigned i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        encoder_ec11_t enc;
+        init_encoder(&enc);
+        now = 1000;
+
+        replay_t r = turn(&enc, rates[i], (uint32_t)(rates[i] * 2));
+        CHECK_EQ(enc.position, (int32_t)(rates[i] * 2));
+
+        // Chatter never reads as a reversal: the estimate holds near the rate
+        // (to within the whole-count truncation)
+        printf("%5.0f detents/s: estimate %d..%d\n", rates[i], r.min_estimate, r.max_estimate);
+        CHECK(r.min_estimate >= rates[i] * 0.9 - 1);
+        CHECK(r.max_estimate <= rates[i] * 1.1 + 1);
+    }
+}
+
+static void test_acceleration(void) {
+    encoder_ec11_t enc;
+    init_encoder(&enc);
+    encoder_accel_t accel = {
+        .min_speed = 10, .max_speed = 40, .max_gain = 4 * ENCODER_ACCEL_GAIN_ONE, .curve = ENCODER_ACCEL_LINEAR,
+    };
+    encoder_ec11_set_acceleration(&enc, &accel);
+    now = 1000;
+
+    // Slow turning passes through one step per detent
+    replay_t slow = turn(&enc, 5, 10);
+    CHECK_EQ(enc.position, 10);
+    CHECK_EQ(slow.moved_late, 5);
+
+    // Fast turning engages the full gain once the estimate settles
+    int32_t before = enc.position;
+    replay_t fast = turn(&enc, 60, 60);
+    printf("accel: %d steps for 60 detents (%d in the last 30)\n", enc.position - before, fast.moved_late);
+    CHECK_EQ(fast.moved_late, 30 * 4);
+    CHECK(enc.position - before > 60 * 3);
+}
+
+int main(void) {
+    test_estimator();
+    test_bouncy_replay();
+    test_acceleration();
+    return TEST_RESULT();
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_fxp.c
+ * @brief Fixed-point angle and trig accuracy against libm, plus timings
+ */
+
+#include <math.h>
+#include "lib.h"
+#include "test_common.h"
+
+static uint32_t rng = 99;
+
+static uint32_t next_rand(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng;
+}
+
+// The 64-bit definition fxp_angle_from_ratio must reproduce
+static fxp_angle_t ratio_reference(int32_t num, int32_t den) {
+    return (fxp_angle_t)(((int64_t)num * (int64_t)FXP_ANGLE_FULL) / den);
+}
+
+// Distance between two angles, in binary radians
+static int angle_diff(fxp_angle_t a, fxp_angle_t b) {
+    int d = (int16_t)(uint16_t)(a - b);
+    return d < 0 ? -d : d;
+}
+
+static void test_ratio_exact(void) {
+    static const int32_t dens[] = {
+        1, 3, 7, 20, 24, 80, 96, 2048, 4095, 4096, 65535, 65536, 100000, 1234567, (1 << 24) - 1,
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(dens); i++) {
+        int32_t den = dens[i];
+        int32_t span = den < 5000 ? 3 * den : 5000;
+        for (int32_t num = -span; num <= span; num++) {
+            if (fxp_angle_from_ratio(num, den) != ratio_reference(num, den)) {
+                printf("ratio mismatch: %d / %d\n", num, den);
+                CHECK(false);
+                return;
+            }
+        }
+    }
+
+    int mismatches = 0;
+    for (int n = 0; n < 2000000; n++) {
+        int32_t den = 1 + (int32_t)(next_rand() % ((1u << 24) - 1));
+        int32_t num = (int32_t)next_rand();
+        if (fxp_angle_from_ratio(num, den) != ratio_reference(num, den)) mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+
+    // Above 2^24 counts per turn the divisor is normalised: within one step
+    int worst = 0;
+    for (int n = 0; n < 200000; n++) {
+        int32_t den = (int32_t)((1u << 24) + next_rand() % 0x7F000000u);
+        int32_t num = (int32_t)next_rand();
+        int d = angle_diff(fxp_angle_from_ratio(num, den), ratio_reference(num, den));
+        if (d > worst) worst = d;
+    }
+    CHECK(worst <= 1);
+
+    CHECK_EQ(fxp_angle_from_ratio(INT32_MIN, 7), ratio_reference(INT32_MIN, 7));
+    CHECK_EQ(fxp_angle_from_ratio(INT32_MAX, INT32_MAX), 0);
+}
+
+static void test_trig_against_libm(void) {
+    int worst_sin = 0, worst_cos = 0;
+    for (uint32_t a = 0; a < FXP_ANGLE_FULL; a++) {
+        double rad = (double)a * 2.0 * M_PI / FXP_ANGLE_FULL;
+        int es = abs(fxp_sin((fxp_angle_t)a) - (int)lround(32767.0 * sin(rad)));
+        int ec = abs(fxp_cos((fxp_angle_t)a) - (int)lround(32767.0 * cos(rad)));
+        if (es > worst_sin) worst_sin = es;
+        if (ec > worst_cos) worst_cos = ec;
+    }
+    printf("fxp_sin max error %d LSB, fxp_cos max error %d LSB (Q15)\n", worst_sin, worst_cos);
+    CHECK(worst_sin <= 1);
+    CHECK(worst_cos <= 1);
+}
+
+// Encoder needle: position -> angle -> sine, against libm on the exact fraction
+static void test_position_angle_chain(void) {
+    static const int32_t cprs[] = {20, 24, 80, 96, 600, 2048, 4096};
+    int worst = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(cprs); i++) {
+        for (int32_t pos = -3 * cprs[i]; pos <= 3 * cprs[i]; pos++) {
+            fxp_angle_t angle = encoder_position_to_angle(pos, cprs[i]);
+            double rad = 2.0 * M_PI * (double)pos / cprs[i];
+            int e = abs(fxp_sin(angle) - (int)lround(32767.0 * sin(rad)));
+            if (e > worst) worst = e;
+            CHECK_EQ(encoder_angle_to_position(angle, cprs[i]), ((pos % cprs[i]) + cprs[i]) % cprs[i]);
+        }
+    }
+    printf("position -> sin max error %d LSB\n", worst);
+    CHECK(worst <= 5);
+}
+
+// Rotating a point matches the libm rotation to within a pixel
+static void test_affine_rotation(void) {
+    fxp_affine_t m;
+    for (int deg = 0; deg < 360; deg += 7) {
+        fxp_affine_rotate_scale(&m, fxp_angle_from_deg(deg), FXP_Q16_ONE * 3 / 2, 64, 32);
+        for (int16_t x = -40; x <= 40; x += 8) {
+            int16_t y = (int16_t)(x / 2), ox, oy;
+            fxp_affine_apply(&m, x, y, &ox, &oy);
+            double r = deg * M_PI / 180.0;
+            double ex = 64 + 1.5 * (x * cos(r) - y * sin(r));
+            double ey = 32 + 1.5 * (x * sin(r) + y * cos(r));
+            CHECK(fabs(ox - ex) <= 1.0 && fabs(oy - ey) <= 1.0);
+        }
+    }
+}
+
+static void bench(void) {
+    enum { N = 1 << 20 };
+    static int32_t nums[N];
+    static int32_t dens[N];
+    for (int i = 0; i < N; i++) {
+        dens[i] = 20 + (int32_t)(next_rand() % 4077);
+        nums[i] = (int32_t)(next_rand() % 200000) - 100000;
+    }
+    uint32_t acc = 0;
+
+    uint64_t t0 = test_now_ns();
+    for (int i = 0; i < N; i++) acc += fxp_angle_from_ratio(nums[i], dens[i]);
+    uint64_t t1 = test_now_ns();
+    for (int i = 0; i < N; i++) acc += ratio_reference(nums[i], dens[i]);
+    uint64_t t2 = test_now_ns();
+    for (int i = 0; i < N; i++) acc += (uint32_t)fxp_sin((fxp_angle_t)nums[i]);
+    uint64_t t3 = test_now_ns();
+    for (int i = 0; i < N; i++) acc += (uint32_t)(int32_t)(32767.0f * sinf((float)nums[i] * 9.5873799e-5f));
+    uint64_t t4 = test_now_ns();
+    test_sink = acc;
+
+    printf("fxp_angle_from_ratio %.2f ns (int64 divide %.2f ns)\n", (double)(t1 - t0) / N, (double)(t2 - t1) / N);
+    printf("fxp_sin %.2f ns (sinf %.2f ns)\n", (double)(t3 - t2) / N, (double)(t4 - t3) / N);
+    printf("host timings only: on the M0+ the int64 divide is an __aeabi_ldivmod call,\n"
+           "while the 32-bit divides map to the SIO hardware divider\n");
+}
+
+int main(void) {
+    test_ratio_exact();
+    test_trig_against_libm();
+    test_position_angle_chain();
+    test_affine_rotation();
+    bench();
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_gpio_irq.c
+ * @brief GPIO dispatcher ownership and re-registration without losing edges
+ */
+
+#include "lib.h"
+#include "hardware/irq.h"
+#include "hardware/structs/io_bank0.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define PIN 13
+#define SHIFT (4 * (PIN % 8))
+#define REG (PIN / 8)
+
+static int owner_a, owner_b;
+
+typedef struct {
+    int calls;
+    uint gpio;
+    uint32_t events;
+    void *ctx;
+} call_log_t;
+
+static call_log_t first, second;
+
+static void first_handler(uint gpio, uint32_t events, void *ctx) {
+    first = (call_log_t){first.calls + 1, gpio, events, ctx};
+}
+
+static void second_handler(uint gpio, uint32_t events, void *ctx) {
+    second = (call_log_t){second.calls + 1, gpio, events, ctx};
+}
+
+static uint32_t pin_enabled(void) {
+    return (io_bank0_hw->proc0_irq_ctrl.inte[REG] >> SHIFT) & 0xF;
+}
+
+static uint32_t pin_latched(void) {
+    return (io_bank0_hw->intr[REG] >> SHIFT) & 0xF;
+}
+
+int main(void) {
+    CHECK_EQ(hw_gpio_irq_register(HW_GPIO_IRQ_NUM_PINS, GPIO_IRQ_EDGE_FALL, first_handler, &owner_a), HW_INVALID_PARAM);
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_FALL, NULL, &owner_a), HW_INVALID_PARAM);
+
+    // A new owner starts with stale edges cleared
+    io_bank0_hw->intr[REG] |= (uint32_t)GPIO_IRQ_EDGE_FALL << SHIFT;
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_FALL, first_handler, &owner_a), HW_OK);
+    CHECK(hw_gpio_irq_is_registered(PIN));
+    CHECK_EQ(pin_enabled(), GPIO_IRQ_EDGE_FALL);
+    CHECK_EQ(pin_latched(), 0);
+
+    // Another context cannot take the pin
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_RISE, second_handler, &owner_b), HW_BUSY);
+    CHECK_EQ(pin_enabled(), GPIO_IRQ_EDGE_FALL);
+
+    // The owner swaps handler and events while an edge is latched: the edge survives
+    io_bank0_hw->intr[REG] |= (uint32_t)GPIO_IRQ_EDGE_FALL << SHIFT;
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, second_handler, &owner_a), HW_OK);
+    CHECK_EQ(pin_latched(), GPIO_IRQ_EDGE_FALL);
+    CHECK_EQ(pin_enabled(), GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+
+    // ...and is delivered to the new handler with the owner's context
+    io_bank0_hw->proc0_irq_ctrl.ints[REG] = (uint32_t)GPIO_IRQ_EDGE_FALL << SHIFT;
+    fake_irq_fire(IO_IRQ_BANK0);
+    io_bank0_hw->proc0_irq_ctrl.ints[REG] = 0;
+    CHECK_EQ(first.calls, 0);
+    CHECK_EQ(second.calls, 1);
+    CHECK_EQ(second.gpio, PIN);
+    CHECK_EQ(second.events, GPIO_IRQ_EDGE_FALL);
+    CHECK(second.ctx == &owner_a);
+
+    // Narrowing the events leaves the pending edge alone too
+    io_bank0_hw->intr[REG] = (uint32_t)GPIO_IRQ_EDGE_RISE << SHIFT;
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_RISE, second_handler, &owner_a), HW_OK);
+    CHECK_EQ(pin_enabled(), GPIO_IRQ_EDGE_RISE);
+    CHECK_EQ(pin_latched(), GPIO_IRQ_EDGE_RISE);
+
+    // Repeated swaps alternate between the pin's two records; the latest wins
+    for (int i = 0; i < 3; i++) {
+        CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_RISE, (i & 1) ? second_handler : first_handler, &owner_a), HW_OK);
+    }
+    first.calls = second.calls = 0;
+    io_bank0_hw->proc0_irq_ctrl.ints[REG] = (uint32_t)GPIO_IRQ_EDGE_RISE << SHIFT;
+    fake_irq_fire(IO_IRQ_BANK0);
+    io_bank0_hw->proc0_irq_ctrl.ints[REG] = 0;
+    CHECK_EQ(first.calls, 1);
+    CHECK_EQ(second.calls, 0);
+    CHECK(first.ctx == &owner_a);
+
+    // Only the owner can release the pin
+    hw_gpio_irq_unregister(PIN, &owner_b);
+    CHECK(hw_gpio_irq_is_registered(PIN));
+    hw_gpio_irq_unregister(PIN, &owner_a);
+    CHECK(!hw_gpio_irq_is_registered(PIN));
+    CHECK_EQ(pin_enabled(), 0);
+
+    CHECK_EQ(hw_gpio_irq_register(PIN, GPIO_IRQ_EDGE_RISE, first_handler, &owner_b), HW_OK);
+    CHECK_EQ(pin_latched(), 0);
+    hw_gpio_irq_unregister(PIN, &owner_b);
+
+    return TEST_RESULT();
+}
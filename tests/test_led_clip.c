@@ -0,0 +1,93 @@
+/**
+ * @file test_led_clip.c
+ * @brief Clip playback owns the strip: hw_ws2812_show must not clobber delta frames
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define PIXELS 4
+
+#define OP(code, count) (((uint32_t)(code) << LED_CLIP_OP_SHIFT) | (count))
+
+static const uint32_t WORD_A = 0x11223300, WORD_B = 0x44556600;
+
+static uint32_t blob[64];
+
+// Two delta frames on a 4-pixel strip: A A A A, then A A B B
+static void build_clip(led_clip_t *clip, const hw_ws2812_t *ws) {
+    static const uint32_t frames[] = {
+        2, OP(LED_CLIP_OP_FILL, PIXELS), WORD_A,
+        3, OP(LED_CLIP_OP_SKIP, 2), OP(LED_CLIP_OP_FILL, 2), WORD_B,
+    };
+    uint32_t n = sizeof(frames) / sizeof(frames[0]);
+
+    blob[0] = LED_CLIP_MAGIC;
+    blob[1] = LED_CLIP_VERSION | (LED_CLIP_DELTA << 8) | (24u << 16) | ((uint32_t)ws->config.format.order << 24);
+    blob[2] = PIXELS | (1u << 16);
+    blob[3] = ws->wire_words;
+    blob[4] = 2;        // frame_count
+    blob[5] = 10000;    // frame_us
+    blob[6] = n;
+    memcpy(&blob[LED_CLIP_HEADER_WORDS], frames, sizeof(frames));
+    CHECK_EQ(led_clip_open(clip, blob, LED_CLIP_HEADER_WORDS + n), HW_OK);
+}
+
+static void check_wire(const hw_ws2812_t *ws, uint32_t w0, uint32_t w1, uint32_t w2, uint32_t w3) {
+    CHECK_EQ(ws->wire[0], w0);
+    CHECK_EQ(ws->wire[1], w1);
+    CHECK_EQ(ws->wire[2], w2);
+    CHECK_EQ(ws->wire[3], w3);
+}
+
+int main(void) {
+    hw_ws2812_config_t config = { .pio = pio0, .sm = 0, .data_pin = 2, .num_pixels = PIXELS };
+    hw_ws2812_t ws;
+    CHECK_EQ(hw_ws2812_init(&ws, &config), HW_OK);
+    CHECK(ws.dma_chan >= 0);
+
+    led_clip_t clip;
+    build_clip(&clip, &ws);
+
+    static led_clip_player_t player, other;
+    CHECK_EQ(led_clip_play(&player, &ws, &clip, false), HW_OK);
+    CHECK(ws.player_attached);
+
+    // A second player cannot attach to the same strip
+    CHECK_EQ(led_clip_play(&other, &ws, &clip, false), HW_BUSY);
+    CHECK(!led_clip_is_playing(&other));
+
+    CHECK(fake_timer_fire(&player.timer));
+    CHECK_EQ(hw_ws2812_wait(&ws), HW_OK);
+    check_wire(&ws, WORD_A, WORD_A, WORD_A, WORD_A);
+
+    // show() between frames is refused and leaves the delta base intact
+    hw_ws2812_set_all(&ws, 0xFF, 0xFF, 0xFF);
+    CHECK_EQ(hw_ws2812_show(&ws), HW_BUSY);
+    check_wire(&ws, WORD_A, WORD_A, WORD_A, WORD_A);
+
+    CHECK(fake_timer_fire(&player.timer));
+    CHECK_EQ(hw_ws2812_wait(&ws), HW_OK);
+    check_wire(&ws, WORD_A, WORD_A, WORD_B, WORD_B);
+    CHECK_EQ(player.frames_shown, 2);
+
+    // The end of a non-looping clip releases the strip
+    CHECK(!fake_timer_fire(&player.timer));
+    CHECK(!led_clip_is_playing(&player));
+    CHECK(!ws.player_attached);
+    CHECK_EQ(hw_ws2812_show(&ws), HW_OK);
+    CHECK_EQ(hw_ws2812_wait(&ws), HW_OK);
+
+    // So does led_clip_stop
+    CHECK_EQ(led_clip_play(&player, &ws, &clip, true), HW_OK);
+    CHECK_EQ(hw_ws2812_show(&ws), HW_BUSY);
+    led_clip_stop(&player);
+    CHECK(!ws.player_attached);
+    CHECK_EQ(hw_ws2812_show(&ws), HW_OK);
+    CHECK_EQ(hw_ws2812_wait(&ws), HW_OK);
+
+    hw_ws2812_deinit(&ws);
+    return TEST_RESULT();
+}
@@ -0,0 +1,184 @@
+/**
+ * @file test_led_effects.c
+ * @brief Effects engine behaviour and per-frame render cost at 500 pixels
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define STRIP_PIXELS 500
+
+static led_rgb_t layer_a[STRIP_PIXELS], layer_b[STRIP_PIXELS], scratch[STRIP_PIXELS];
+static uint8_t heat[STRIP_PIXELS];
+
+static const led_rgb_t BLACK = {0, 0, 0}, WHITE = {255, 255, 255};
+static const led_rgb_t RED = {255, 0, 0}, GREEN = {0, 255, 0}, BLUE = {0, 0, 255};
+
+static void test_color_helpers(void) {
+    led_rgb_t c = led_hsv_to_rgb(0, 255, 255);
+    CHECK(c.r == 255 && c.g == 0 && c.b == 0);
+    c = led_hsv_to_rgb(85, 255, 255);
+    CHECK(c.g == 255 && c.r < 8);
+    c = led_hsv_to_rgb(170, 255, 255);
+    CHECK_EQ(c.b, 255);
+    c = led_hsv_to_rgb(9, 0, 77);
+    CHECK(c.r == 77 && c.g == 77 && c.b == 77);
+
+    CHECK_EQ(led_blend(BLACK, WHITE, 255).r, 255);
+    CHECK_EQ(led_blend(BLACK, WHITE, 0).r, 0);
+    CHECK_EQ(led_blend(WHITE, BLACK, 255).r, 0);
+
+    for (uint16_t n = 1; n <= STRIP_PIXELS; n++) {
+        led_fill_gradient(scratch, n, RED, BLUE);
+        CHECK_EQ(scratch[0].r, 255);
+        CHECK_EQ(scratch[n - 1].b, n == 1 ? 0 : 255);
+    }
+
+    const led_rgb_t colors[3] = {RED, GREEN, BLUE};
+    led_palette_t palette = {colors, 3};
+    CHECK_EQ(led_palette_sample(&palette, 0).r, 255);
+}
+
+static void test_effects(void) {
+    led_effect_t fx;
+
+    // A fast chase leaves an unbroken trail behind the block
+    led_effect_chase(&fx, WHITE, 2, 1000, 64);
+    memset(scratch, 0, sizeof(scratch));
+    led_effect_render(&fx, scratch, 100, 0);
+    CHECK(scratch[0].r == 255 && scratch[1].r == 255 && scratch[2].r == 0);
+    led_effect_render(&fx, scratch, 100, 10);
+    for (int i = 0; i < 12; i++) CHECK(scratch[i].r > 0);
+    CHECK(scratch[10].r == 255 && scratch[11].r == 255 && scratch[12].r == 0);
+
+    // Fire copes with strips shorter than its drift kernel
+    for (uint16_t n = 1; n < 5; n++) {
+        memset(heat, 0, sizeof(heat));
+        led_effect_fire(&fx, heat, 55, 120);
+        for (int k = 0; k < 100; k++) led_effect_render(&fx, scratch, n, 16);
+    }
+
+    led_effect_breathing(&fx, WHITE, 1000);
+    led_effect_render(&fx, scratch, 1, 0);
+    CHECK_EQ(scratch[0].r, 0);
+    led_effect_render(&fx, scratch, 1, 500);
+    CHECK(scratch[0].r >= 254);
+}
+
+static void test_engine(hw_ws2812_t *ws) {
+    led_engine_t engine;
+    led_effect_t bottom, top;
+
+    fake_time_us = 1000;
+    CHECK_EQ(led_engine_init(&engine, ws, 50), HW_OK);
+    CHECK_EQ(engine.count, STRIP_PIXELS);
+    CHECK_EQ(engine.frame_us, 20000);
+
+    led_effect_solid(&bottom, (led_rgb_t){100, 0, 0});
+    led_effect_solid(&top, (led_rgb_t){0, 0, 200});
+    CHECK_EQ(led_engine_add_layer(&engine, &bottom, layer_a, LED_BLEND_NORMAL, 255), HW_OK);
+    CHECK_EQ(led_engine_add_layer(&engine, &top, layer_b, LED_BLEND_ADD, 128), HW_OK);
+
+    CHECK(led_engine_task(&engine));
+    uint32_t pixel = ws->pixels[3];
+    CHECK_EQ((pixel >> 16) & 0xFF, 100);
+    CHECK((pixel & 0xFF) >= 99 && (pixel & 0xFF) <= 101);
+    CHECK_EQ(hw_ws2812_wait(ws), HW_OK);
+
+    // Not due yet; then on time; then late by several slots
+    fake_time_us = 2000;
+    CHECK(!led_engine_task(&engine));
+    fake_time_us = 21000;
+    CHECK(led_engine_task(&engine));
+    CHECK_EQ(hw_ws2812_wait(ws), HW_OK);
+    fake_time_us = 100000;
+    CHECK(led_engine_task(&engine));
+    CHECK_EQ(hw_ws2812_wait(ws), HW_OK);
+    CHECK_EQ(engine.frames, 3);
+    CHECK_EQ(engine.dropped, 2);
+    CHECK_EQ(engine.next_frame_us, 101000);
+
+    // No frame goes out while a clip player holds the strip, and the time
+    // it held it is handed to the next frame that does
+    uint64_t last = engine.last_frame_us;
+    ws->player_attached = true;
+    fake_time_us = 101500;
+    CHECK(!led_engine_task(&engine));
+    CHECK_EQ(engine.last_frame_us, last);
+    CHECK_EQ(engine.frames, 3);
+    ws->player_attached = false;
+    fake_time_us = 121700;
+    CHECK(led_engine_task(&engine));
+    CHECK_EQ(hw_ws2812_wait(ws), HW_OK);
+    CHECK_EQ(engine.last_frame_us, 121000);
+    CHECK_EQ(engine.frames, 4);
+
+    // Swapping a layer's effect keeps its place in the stack
+    led_effect_t green;
+    led_effect_solid(&green, (led_rgb_t){0, 100, 0});
+    CHECK_EQ(led_engine_set_layer_effect(&engine, 2, &green), HW_INVALID_PARAM);
+    CHECK_EQ(led_engine_set_layer_effect(&engine, 0, NULL), HW_INVALID_PARAM);
+    CHECK_EQ(led_engine_set_layer_effect(&engine, 0, &green), HW_OK);
+    led_engine_render(&engine, 16);
+    CHECK_EQ((ws->pixels[3] >> 16) & 0xFF, 0);
+    CHECK_EQ((ws->pixels[3] >> 8) & 0xFF, 100);
+}
+
+static double render_ns(led_effect_t *fx, int frames) {
+    uint64_t t0 = test_now_ns();
+    for (int k = 0; k < frames; k++) led_effect_render(fx, scratch, STRIP_PIXELS, 16);
+    test_sink = scratch[STRIP_PIXELS / 2].r;
+    return (double)(test_now_ns() - t0) / frames;
+}
+
+static void bench(hw_ws2812_t *ws) {
+    enum { FRAMES = 5000 };
+    const led_rgb_t colors[3] = {RED, GREEN, BLUE};
+    led_palette_t palette = {colors, 3};
+    led_effect_t fx;
+
+    printf("render cost, %d pixels (host us/frame)\n", STRIP_PIXELS);
+    led_effect_rainbow(&fx, 100, 3);
+    printf("  rainbow   %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_palette(&fx, &palette, 100, 3);
+    printf("  palette   %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_chase(&fx, WHITE, 5, 60, 40);
+    printf("  chase     %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_fire(&fx, heat, 55, 120);
+    printf("  fire      %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_twinkle(&fx, WHITE, 10, 30);
+    printf("  twinkle   %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_breathing(&fx, WHITE, 3000);
+    printf("  breathing %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+    led_effect_gradient(&fx, RED, BLUE);
+    printf("  gradient  %7.2f\n", render_ns(&fx, FRAMES) / 1000);
+
+    led_engine_t engine;
+    led_effect_t bottom, top;
+    led_engine_init(&engine, ws, 0);
+    led_effect_rainbow(&bottom, 100, 3);
+    led_effect_twinkle(&top, WHITE, 10, 30);
+    led_engine_add_layer(&engine, &bottom, layer_a, LED_BLEND_NORMAL, 255);
+    led_engine_add_layer(&engine, &top, layer_b, LED_BLEND_SCREEN, 200);
+
+    uint64_t t0 = test_now_ns();
+    for (int k = 0; k < FRAMES; k++) led_engine_render(&engine, 16);
+    printf("  2 layers + composite %7.2f\n", (double)(test_now_ns() - t0) / FRAMES / 1000);
+    test_sink = ws->pixels[STRIP_PIXELS / 2];
+}
+
+int main(void) {
+    hw_ws2812_config_t config = { .pio = pio0, .sm = 0, .data_pin = 2, .num_pixels = STRIP_PIXELS };
+    hw_ws2812_t ws;
+    CHECK_EQ(hw_ws2812_init(&ws, &config), HW_OK);
+
+    test_color_helpers();
+    test_effects();
+    test_engine(&ws);
+    bench(&ws);
+
+    hw_ws2812_deinit(&ws);
+    return TEST_RESULT();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_led_matrix.c
+ * @brief Layout index maps, clipped matrix drawing and zone offsets
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+static uint16_t lut[512];
+
+// Every logical pixel maps to a distinct strip index in [base, base + w * h)
+static void check_permutation(const led_map_t *map, uint16_t base) {
+    static bool seen[1024];
+    uint32_t n = (uint32_t)map->width * map->height;
+    memset(seen, 0, sizeof(seen));
+    int bad = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t index = map->lut[i];
+        if (index < base || index >= base + n || seen[index]) bad++;
+        else seen[index] = true;
+    }
+    CHECK_EQ(bad, 0);
+}
+
+static void test_maps(void) {
+    led_map_t map;
+
+    // Serpentine rows
+    led_layout_t layout = { .tile_width = 4, .tile_height = 3, .serpentine = true };
+    CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+    CHECK(map.width == 4 && map.height == 3);
+    CHECK_EQ(led_map_index(&map, 0, 0), 0);
+    CHECK_EQ(led_map_index(&map, 3, 0), 3);
+    CHECK_EQ(led_map_index(&map, 3, 1), 4);
+    CHECK_EQ(led_map_index(&map, 0, 1), 7);
+    CHECK_EQ(led_map_index(&map, 0, 2), 8);
+    check_permutation(&map, 0);
+
+    // Serpentine columns within the tile
+    layout.column_major = true;
+    CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+    CHECK_EQ(led_map_index(&map, 0, 2), 2);
+    CHECK_EQ(led_map_index(&map, 1, 2), 3);
+    CHECK_EQ(led_map_index(&map, 1, 0), 5);
+
+    // Rotated a quarter turn: width and height swap
+    layout = (led_layout_t){ .tile_width = 4, .tile_height = 3, .rotation = LED_ROTATE_90 };
+    CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+    CHECK(map.width == 3 && map.height == 4);
+    CHECK_EQ(led_map_index(&map, 0, 0), 3);
+    CHECK_EQ(led_map_index(&map, 2, 3), 8);
+    check_permutation(&map, 0);
+
+    // Tiles chained row by row, alternate tile rows right to left
+    layout = (led_layout_t){ .tile_width = 8, .tile_height = 8, .tiles_x = 2, .tiles_y = 2, .tile_serpentine = true };
+    CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+    CHECK_EQ(led_map_index(&map, 8, 0), 64);
+    CHECK_EQ(led_map_index(&map, 8, 8), 128);
+    CHECK_EQ(led_map_index(&map, 0, 8), 192);
+    CHECK_EQ(led_map_init(&map, lut, 10, &layout), HW_INVALID_PARAM);
+
+    // Every rotation and mirror of a multi-tile panel stays a permutation
+    for (int r = 0; r < 4; r++) {
+        for (int f = 0; f < 4; f++) {
+            layout = (led_layout_t){
+                .tile_width = 8, .tile_height = 8, .tiles_x = 2, .tiles_y = 3,
+                .serpentine = r & 1, .tile_serpentine = true, .rotation = (led_rotation_t)r,
+                .flip_x = f & 1, .flip_y = f >> 1, .first_index = 10,
+            };
+            CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+            check_permutation(&map, 10);
+        }
+    }
+}
+
+static void test_matrix(hw_ws2812_t *ws) {
+    led_map_t map;
+    led_layout_t layout = { .tile_width = 8, .tile_height = 8, .serpentine = true };
+    CHECK_EQ(led_map_init(&map, lut, 512, &layout), HW_OK);
+
+    led_matrix_t matrix;
+    CHECK_EQ(led_matrix_init(&matrix, ws, &map), HW_OK);
+
+    // A map reaching past the strip is refused
+    led_map_t big;
+    static uint16_t big_lut[128];
+    led_layout_t wide = { .tile_width = 16, .tile_height = 8 };
+    CHECK_EQ(led_map_init(&big, big_lut, 128, &wide), HW_OK);
+    led_matrix_t bad;
+    CHECK_EQ(led_matrix_init(&bad, ws, &big), HW_INVALID_PARAM);
+
+    // fill_rect clips at every edge
+    hw_ws2812_clear(ws);
+    led_matrix_fill_rect(&matrix, -2, 6, 4, 5, (led_rgb_t){1, 2, 3});
+    int lit = 0;
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 8; x++) {
+            bool inside = x < 2 && y >= 6;
+            uint32_t want = inside ? 0x010203 : 0;
+            if (ws->pixels[led_map_index(&map, x, y)] != want) lit = -1000;
+            else if (inside) lit++;
+        }
+    }
+    CHECK_EQ(lit, 4);
+
+    // Blit clips its source window consistently
+    hw_ws2812_clear(ws);
+    const led_rgb_t img[6] = {{9, 9, 9}, {8, 8, 8}, {7, 7, 7}, {6, 6, 6}, {5, 5, 5}, {4, 4, 4}};
+    led_matrix_blit(&matrix, 6, -1, img, 3, 2);
+    CHECK_EQ(ws->pixels[led_map_index(&map, 6, 0)], 0x060606);
+    CHECK_EQ(ws->pixels[led_map_index(&map, 7, 0)], 0x050505);
+    CHECK_EQ(ws->pixels[led_map_index(&map, 6, 1)], 0);
+
+    // gfx primitives through the matrix target
+    hw_ws2812_clear(ws);
+    matrix.color = (led_rgb_t){1, 2, 3};
+    gfx_target_t target = led_matrix_target(&matrix);
+    gfx_fill_circle(&target, 3, 3, 2);
+    gfx_line(&target, -5, 7, 20, 7);
+    CHECK_EQ(ws->pixels[led_map_index(&map, 3, 3)], 0x010203);
+    CHECK_EQ(ws->pixels[led_map_index(&map, 0, 0)], 0);
+    for (int x = 0; x < 8; x++) CHECK_EQ(ws->pixels[led_map_index(&map, x, 7)], 0x010203);
+
+    // With an output pipeline, writes still reach its linear copy
+    CHECK_EQ(hw_ws2812_enable_pipeline(ws, false, false), HW_OK);
+    led_matrix_fill(&matrix, (led_rgb_t){255, 0, 0});
+    CHECK_EQ(ws->pixels[5], 0xFF0000);
+    CHECK_EQ(ws->work[ws->channels * 5], 0xFFFF);
+}
+
+static void test_zones(hw_ws2812_t *ws) {
+    led_zone_t zone;
+    CHECK_EQ(led_zone_init(&zone, ws, 60, 5, false), HW_INVALID_PARAM);
+    CHECK_EQ(led_zone_init(&zone, ws, 60, 4, true), HW_OK);
+
+    const led_rgb_t img[4] = {{9, 9, 9}, {8, 8, 8}, {7, 7, 7}, {6, 6, 6}};
+    led_zone_blit(&zone, img);
+    CHECK_EQ(ws->pixels[63], 0x090909);
+    CHECK_EQ(ws->pixels[60], 0x060606);
+
+    led_zone_set_pixel(&zone, 1, (led_rgb_t){0, 0, 1});
+    CHECK_EQ(ws->pixels[62], 0x000001);
+    led_zone_set_pixel(&zone, 4, (led_rgb_t){0, 0, 2});
+    CHECK_EQ(ws->pixels[59], 0);
+
+    led_zone_t forward;
+    CHECK_EQ(led_zone_init(&forward, ws, 10, 3, false), HW_OK);
+    led_zone_fill(&forward, (led_rgb_t){4, 5, 6});
+    CHECK_EQ(ws->pixels[9], 0);
+    CHECK_EQ(ws->pixels[10], 0x040506);
+    CHECK_EQ(ws->pixels[12], 0x040506);
+    CHECK_EQ(ws->pixels[13], 0);
+}
+
+int main(void) {
+    hw_ws2812_config_t config = { .pio = pio0, .sm = 0, .data_pin = 2, .num_pixels = 64 };
+    hw_ws2812_t ws;
+    CHECK_EQ(hw_ws2812_init(&ws, &config), HW_OK);
+
+    test_maps();
+    test_zones(&ws);
+    test_matrix(&ws);
+
+    hw_ws2812_deinit(&ws);
+    return TEST_RESULT();
+}
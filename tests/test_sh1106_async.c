@@ -0,0 +1,136 @@
+/**
+ * @file test_sh1106_async.c
+ * @brief Completion of DMA frame updates: busy and the callback track the bus
+ */
+
+#include "lib.h"
+#include "fake_sdk.h"
+#include "hardware/irq.h"
+#include "test_common.h"
+
+static sh1106_t display;
+static sh1106_async_t async;
+static int callbacks;
+static hw_result_t requeue_result;
+
+// Queue the next frame straight from the completion callback
+static void on_done(void *user_data) {
+    callbacks++;
+    if (user_data) {
+        sh1106_set_pixel(&display, 1, 1, true);
+        requeue_result = sh1106_update_async(&display, false);
+    }
+}
+
+// Controller still shifting out the tail of the frame
+static void bus_active(void) {
+    fake_i2c0_hw.status = I2C_IC_STATUS_ACTIVITY_BITS;
+}
+
+static void bus_stopped(void) {
+    fake_i2c0_hw.status = I2C_IC_STATUS_TFE_BITS;
+    fake_i2c0_hw.intr_stat = I2C_IC_INTR_STAT_R_STOP_DET_BITS;
+}
+
+static void test_callback_waits_for_stop(void) {
+    sh1106_async_set_callback(&display, on_done, NULL);
+    sh1106_set_pixel(&display, 0, 0, true);
+    CHECK_EQ(sh1106_update_async(&display, false), HW_OK);
+    CHECK(async.busy);
+    CHECK_EQ(fake_i2c0_hw.intr_mask, I2C_IC_INTR_MASK_M_TX_ABRT_BITS);
+
+    // DMA has queued the last byte: not done yet
+    bus_active();
+    fake_irq_fire(DMA_IRQ_0);
+    CHECK_EQ(callbacks, 0);
+    CHECK(async.busy);
+    CHECK(fake_i2c0_hw.intr_mask & I2C_IC_INTR_MASK_M_STOP_DET_BITS);
+    CHECK_EQ(sh1106_command(&display, SH1106_CMD_NOP), HW_BUSY);
+
+    // Final STOP on the bus
+    bus_stopped();
+    fake_irq_fire(I2C0_IRQ);
+    CHECK_EQ(callbacks, 1);
+    CHECK(!async.busy);
+    CHECK_EQ(async.result, HW_OK);
+    CHECK_EQ(fake_i2c0_hw.intr_mask, 0);
+
+    // A second STOP_DET after completion is ignored
+    fake_irq_fire(I2C0_IRQ);
+    CHECK_EQ(callbacks, 1);
+}
+
+// If the bus went idle before the DMA IRQ ran, that IRQ completes the frame
+static void test_stop_before_dma_irq(void) {
+    sh1106_set_pixel(&display, 2, 0, true);
+    CHECK_EQ(sh1106_update_async(&display, false), HW_OK);
+    fake_i2c0_hw.status = I2C_IC_STATUS_TFE_BITS;
+    fake_irq_fire(DMA_IRQ_0);
+    CHECK_EQ(callbacks, 2);
+    CHECK(!async.busy);
+}
+
+static void test_callback_can_queue_next_frame(void) {
+    sh1106_async_set_callback(&display, on_done, &display);
+    sh1106_set_pixel(&display, 3, 0, true);
+    CHECK_EQ(sh1106_update_async(&display, false), HW_OK);
+    uint32_t starts = fake_dma[async.dma_chan].starts;
+
+    bus_active();
+    fake_irq_fire(DMA_IRQ_0);
+    bus_stopped();
+    fake_irq_fire(I2C0_IRQ);
+    CHECK_EQ(callbacks, 3);
+    CHECK_EQ(requeue_result, HW_OK);
+    CHECK_EQ(fake_dma[async.dma_chan].starts, starts + 1);
+    CHECK(async.busy);
+
+    sh1106_async_set_callback(&display, on_done, NULL);
+    fake_irq_fire(DMA_IRQ_0);
+    fake_irq_fire(I2C0_IRQ);
+    CHECK(!async.busy);
+}
+
+// Nothing dirty: no transfer, no callback, and the caller is told
+static void test_nothing_to_send(void) {
+    sh1106_async_set_callback(&display, on_done, &display);
+    sh1106_mark_clean(&display);
+    int before = callbacks;
+    uint32_t starts = fake_dma[async.dma_chan].starts;
+    CHECK_EQ(sh1106_update_async(&display, false), HW_NOT_FOUND);
+    CHECK_EQ(callbacks, before);
+    CHECK_EQ(fake_dma[async.dma_chan].starts, starts);
+    CHECK(!async.busy);
+    sh1106_async_set_callback(&display, on_done, NULL);
+}
+
+// NACK mid-frame: finished with an error and the whole frame marked for resend
+static void test_abort(void) {
+    sh1106_set_pixel(&display, 4, 0, true);
+    CHECK_EQ(sh1106_update_async(&display, false), HW_OK);
+    bus_active();
+    fake_i2c0_hw.intr_stat = I2C_IC_INTR_STAT_R_TX_ABRT_BITS;
+    fake_irq_fire(I2C0_IRQ);
+    CHECK(!async.busy);
+    CHECK_EQ(async.result, HW_ERROR);
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        CHECK_EQ(display.dirty_x0[page], 0);
+        CHECK_EQ(display.dirty_x1[page], SH1106_WIDTH - 1);
+    }
+    fake_i2c0_hw.status = I2C_IC_STATUS_TFE_BITS;
+    fake_i2c0_hw.intr_stat = 0;
+}
+
+int main(void) {
+    CHECK_EQ(sh1106_init(&display, i2c0, 0x3C, 4, 5), HW_OK);
+    CHECK_EQ(sh1106_async_init(&display, &async), HW_OK);
+
+    test_callback_waits_for_stop();
+    test_stop_before_dma_irq();
+    test_callback_can_queue_next_frame();
+    test_nothing_to_send();
+    test_abort();
+
+    sh1106_async_deinit(&display);
+    return TEST_RESULT();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_sh1106_commands.c
+ * @brief Command batching: transaction shapes and counts for init and updates
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "hardware/irq.h"
+#include "test_common.h"
+
+#define LOG_MAX 64
+
+// Captured write shapes: control byte and length of each transaction
+typedef struct {
+    uint8_t ctrl[LOG_MAX];
+    uint8_t len[LOG_MAX];
+    uint8_t cmds[256];
+    uint32_t count;
+    uint32_t cmd_bytes;
+} tx_log_t;
+
+static tx_log_t tx_log;
+static sh1106_t display;
+static sh1106_async_t async;
+
+static void log_write(uint8_t addr, const uint8_t *data, size_t len, void *user_data) {
+    tx_log_t *log = user_data;
+    (void)addr;
+    if (len == 0) return;
+    if (log->count < LOG_MAX) {
+        log->ctrl[log->count] = data[0];
+        log->len[log->count] = (uint8_t)len;
+    }
+    log->count++;
+    if (data[0] == SH1106_CTRL_CMD_STREAM) {
+        for (size_t i = 1; i < len && log->cmd_bytes < sizeof(log->cmds); i++) {
+            log->cmds[log->cmd_bytes++] = data[i];
+        }
+    }
+}
+
+static void log_reset(void) {
+    memset(&tx_log, 0, sizeof(tx_log));
+    fake_i2c_reset();
+}
+
+// Init: presence probe, then display off, timing, panel setup; clear; display on
+static void test_init_sequence(void) {
+    static const uint8_t expected_cmds[] = {
+        SH1106_CMD_DISPLAY_OFF,
+        SH1106_CMD_SET_DISPLAY_CLOCK, 0x80, SH1106_CMD_SET_MULTIPLEX, 0x3F,
+        SH1106_CMD_SET_DISPLAY_OFFSET, 0x00, SH1106_CMD_SET_START_LINE,
+        SSD1306_CMD_CHARGE_PUMP, SSD1306_CHARGE_PUMP_ENABLE,
+        SH1106_CMD_SET_SEGMENT_REMAP | 0x01, SH1106_CMD_SET_COM_SCAN_DIR | 0x08,
+        SH1106_CMD_SET_COM_PINS, 0x12, SH1106_CMD_SET_CONTRAST, 0xFF,
+        SH1106_CMD_SET_PRECHARGE, 0xF1, SH1106_CMD_SET_VCOM_DESELECT, 0x40,
+        SH1106_CMD_RESUME_FROM_RAM, SH1106_CMD_SET_NORMAL_DISPLAY,
+    };
+
+    log_reset();
+    CHECK_EQ(sh1106_init(&display, i2c0, 0x3C, 4, 5), HW_OK);
+
+    // Probe (empty write) + 3 setup lists + 8 pages x (addressing + 8 data chunks) + display on
+    CHECK_EQ(fake_i2c.transactions, 1 + 3 + SH1106_PAGES * 9 + 1);
+    CHECK_EQ(tx_log.ctrl[0], SH1106_CTRL_CMD_STREAM);
+    CHECK_EQ(tx_log.len[0], 2);
+    CHECK_EQ(tx_log.len[1], 1 + 9);
+    CHECK_EQ(tx_log.len[2], 1 + 12);
+    CHECK(memcmp(tx_log.cmds, expected_cmds, sizeof(expected_cmds)) == 0);
+    CHECK_EQ(tx_log.cmds[tx_log.cmd_bytes - 1], SH1106_CMD_DISPLAY_ON);
+}
+
+// Full update: one 3-command addressing transaction per page, no single-command writes
+static void test_full_update_shape(void) {
+    log_reset();
+    CHECK_EQ(sh1106_update(&display), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 72);
+    CHECK_EQ(fake_i2c.bus_bytes, 1192);
+    for (uint32_t i = 0; i < tx_log.count; i += 9) {
+        CHECK_EQ(tx_log.ctrl[i], SH1106_CTRL_CMD_STREAM);
+        CHECK_EQ(tx_log.len[i], 1 + 3);
+        CHECK_EQ(tx_log.cmds[(i / 9) * 3], SH1106_CMD_SET_PAGE_ADDR | (i / 9));
+    }
+}
+
+static void test_command_list_limits(void) {
+    uint8_t cmds[SH1106_CMD_LIST_MAX + 1];
+    memset(cmds, SH1106_CMD_NOP, sizeof(cmds));
+
+    log_reset();
+    CHECK_EQ(sh1106_command_list(&display, cmds, 0), HW_INVALID_PARAM);
+    CHECK_EQ(sh1106_command_list(&display, cmds, SH1106_CMD_LIST_MAX + 1), HW_INVALID_PARAM);
+    CHECK_EQ(fake_i2c.transactions, 0);
+
+    CHECK_EQ(sh1106_command_list(&display, cmds, SH1106_CMD_LIST_MAX), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 1);
+    CHECK_EQ(tx_log.len[0], 1 + SH1106_CMD_LIST_MAX);
+
+    log_reset();
+    CHECK_EQ(sh1106_set_contrast(&display, 0x42), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 1);
+    CHECK_EQ(tx_log.cmds[0], SH1106_CMD_SET_CONTRAST);
+    CHECK_EQ(tx_log.cmds[1], 0x42);
+}
+
+// DMA frame: the same transaction layout encoded as IC_DATA_CMD words
+static void test_async_frame_words(void) {
+    CHECK_EQ(sh1106_async_init(&display, &async), HW_OK);
+    CHECK_EQ(sh1106_update_async(&display, true), HW_OK);
+
+    const uint16_t *w = async.words;
+    uint32_t count = fake_dma[async.dma_chan].count;
+    CHECK_EQ(count, 1064);
+    CHECK_EQ(count, SH1106_ASYNC_FRAME_WORDS - 2);
+
+    // Each page: CMD_STREAM + 3 commands (STOP on the last), DATA_STREAM + 128 bytes (STOP on the last)
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        const uint16_t *p = &w[page * 133];
+        CHECK_EQ(p[0], SH1106_CTRL_CMD_STREAM);
+        CHECK_EQ(p[1], SH1106_CMD_SET_PAGE_ADDR | page);
+        CHECK(p[3] & I2C_IC_DATA_CMD_STOP_BITS);
+        CHECK_EQ(p[4], SH1106_CTRL_DATA_STREAM);
+        CHECK(!(p[131] & I2C_IC_DATA_CMD_STOP_BITS));
+        CHECK(p[132] & I2C_IC_DATA_CMD_STOP_BITS);
+    }
+
+    fake_irq_fire(DMA_IRQ_0);
+    sh1106_async_deinit(&display);
+}
+
+int main(void) {
+    fake_i2c.hook = log_write;
+    fake_i2c.hook_data = &tx_log;
+
+    test_init_sequence();
+    test_full_update_shape();
+    test_command_list_limits();
+    test_async_frame_words();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_sh1106_diff.c
+ * @brief Frame diff replay: segment coverage, wire byte counts and merge quality
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+#include "sh1106_panel.h"
+
+static sh1106_t display;
+static sh1106_diff_t diff;
+static sh1106_panel_t panel;
+static uint32_t rng = 777;
+
+static uint32_t next_rand(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+// Wire cost of one span as sent by sh1106_write_span
+static uint32_t span_bytes(uint32_t len) {
+    return 5 + 2 * ((len + SH1106_WRITE_CHUNK - 1) / SH1106_WRITE_CHUNK) + len;
+}
+
+// Cheapest possible cover of one page's changed columns (any grouping of runs)
+static uint32_t optimal_page_bytes(const uint8_t *cur, const uint8_t *old) {
+    int run_start[SH1106_WIDTH], run_end[SH1106_WIDTH], runs = 0;
+    for (int x = 0; x < SH1106_WIDTH; x++) {
+        if (cur[x] == old[x]) continue;
+        if (runs && run_end[runs - 1] == x - 1) {
+            run_end[runs - 1] = x;
+        } else {
+            run_start[runs] = run_end[runs] = x;
+            runs++;
+        }
+    }
+
+    uint32_t best[SH1106_WIDTH + 1];
+    best[0] = 0;
+    for (int j = 1; j <= runs; j++) {
+        best[j] = UINT32_MAX;
+        for (int i = 1; i <= j; i++) {
+            uint32_t c = best[i - 1] + span_bytes(run_end[j - 1] - run_start[i - 1] + 1);
+            if (c < best[j]) best[j] = c;
+        }
+    }
+    return best[runs];
+}
+
+// Segments are ordered, disjoint, in bounds and cover every changed byte
+static bool segments_valid(const uint8_t *frame, const sh1106_segment_t *segs, uint16_t count) {
+    uint8_t covered[SH1106_WIDTH * SH1106_PAGES] = {0};
+    uint8_t per_page[SH1106_PAGES] = {0};
+    int last = -1;
+    for (uint16_t i = 0; i < count; i++) {
+        int first = segs[i].page * SH1106_WIDTH + segs[i].x;
+        if (segs[i].page >= SH1106_PAGES || segs[i].len == 0 ||
+            segs[i].x + segs[i].len > SH1106_WIDTH || first <= last) {
+            return false;
+        }
+        if (++per_page[segs[i].page] > SH1106_DIFF_MAX_SEGMENTS_PER_PAGE) return false;
+        memset(&covered[first], 1, segs[i].len);
+        last = first + segs[i].len - 1;
+    }
+    for (int i = 0; i < SH1106_WIDTH * SH1106_PAGES; i++) {
+        if (frame[i] != diff.shadow[i] && !covered[i]) return false;
+    }
+    return true;
+}
+
+// Sparse edits typical of a UI: a few short runs, a sprite, a changed digit
+static void mutate_frame(void) {
+    int edits = 1 + next_rand() % 6;
+    for (int e = 0; e < edits; e++) {
+        switch (next_rand() % 3) {
+            case 0: {
+                uint8_t page = next_rand() % SH1106_PAGES;
+                uint8_t x = next_rand() % SH1106_WIDTH;
+                uint8_t len = 1 + next_rand() % 8;
+                for (uint8_t i = 0; i < len && x + i < SH1106_WIDTH; i++) {
+                    display.buffer[page * SH1106_WIDTH + x + i] ^= (uint8_t)(1 + next_rand() % 255);
+                }
+                break;
+            }
+            case 1:
+                sh1106_fill_rect(&display, next_rand() % 120, next_rand() % 56, 2 + next_rand() % 30,
+                                 1 + next_rand() % 12, next_rand() & 1);
+                break;
+            default: {
+                char text[2] = {(char)('0' + next_rand() % 10), 0};
+                sh1106_draw_string_opaque(&display, next_rand() % 120, next_rand() % 56, text);
+                break;
+            }
+        }
+    }
+}
+
+static void test_replay(void) {
+    sh1106_segment_t segs[SH1106_DIFF_MAX_SEGMENTS];
+    uint64_t greedy_total = 0, optimal_total = 0, run_total = 0;
+
+    for (int frame = 0; frame < 5000; frame++) {
+        mutate_frame();
+
+        uint16_t count = sh1106_diff_compute(&diff, display.buffer, segs);
+        if (!segments_valid(display.buffer, segs, count)) {
+            printf("invalid segments at frame %d\n", frame);
+            CHECK(false);
+            return;
+        }
+        uint32_t predicted = sh1106_diff_bus_bytes(segs, count);
+        for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+            const uint8_t *cur = &display.buffer[page * SH1106_WIDTH];
+            const uint8_t *old = &diff.shadow[page * SH1106_WIDTH];
+            optimal_total += optimal_page_bytes(cur, old);
+            for (int x = 0; x < SH1106_WIDTH; x++) {
+                if (cur[x] != old[x] && (x == 0 || cur[x - 1] == old[x - 1])) run_total += 5 + 2;
+                if (cur[x] != old[x]) run_total += 1;
+            }
+        }
+        greedy_total += predicted;
+
+        fake_i2c_reset();
+        CHECK_EQ(sh1106_diff_update(&display, &diff), HW_OK);
+        CHECK_EQ(fake_i2c.bus_bytes, predicted);
+        CHECK(panel_matches(&panel, &display));
+        CHECK(memcmp(diff.shadow, display.buffer, sizeof(diff.shadow)) == 0);
+    }
+
+    printf("5000 frames: %llu bytes (optimal %llu, +%.2f%%; one segment per run %llu)\n",
+           (unsigned long long)greedy_total, (unsigned long long)optimal_total,
+           100.0 * (double)(greedy_total - optimal_total) / (double)optimal_total,
+           (unsigned long long)run_total);
+    CHECK(greedy_total * 100 <= optimal_total * 102);
+    CHECK(greedy_total <= run_total);
+}
+
+// Two full chunks split by a 6-byte gap: merging would add a chunk header (49 > 46)
+static void test_gap_priced_with_chunks(void) {
+    sh1106_segment_t segs[SH1106_DIFF_MAX_SEGMENTS];
+    sh1106_fill_rect(&display, 0, 0, 128, 8, false);
+    CHECK_EQ(sh1106_diff_update(&display, &diff), HW_OK);
+
+    sh1106_fill_rect(&display, 10, 0, 16, 8, true);
+    sh1106_fill_rect(&display, 32, 0, 16, 8, true);
+    uint16_t count = sh1106_diff_compute(&diff, display.buffer, segs);
+    CHECK_EQ(count, 2);
+    CHECK_EQ(sh1106_diff_bus_bytes(segs, count), 2 * span_bytes(16));
+
+    // A short gap inside one chunk is still cheaper to resend
+    sh1106_fill_rect(&display, 60, 0, 4, 8, true);
+    sh1106_fill_rect(&display, 66, 0, 4, 8, true);
+    count = sh1106_diff_compute(&diff, display.buffer, segs);
+    CHECK_EQ(count, 3);
+    CHECK_EQ(segs[2].x, 60);
+    CHECK_EQ(segs[2].len, 10);
+    CHECK_EQ(sh1106_diff_update(&display, &diff), HW_OK);
+}
+
+int main(void) {
+    panel_attach(&panel);
+    CHECK_EQ(sh1106_init(&display, i2c0, 0x3C, 4, 5), HW_OK);
+    sh1106_diff_init(&diff, NULL);
+
+    // First update sends the whole frame
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_diff_update(&display, &diff), HW_OK);
+    CHECK_EQ(fake_i2c.bus_bytes, SH1106_PAGES * span_bytes(SH1106_WIDTH));
+
+    test_gap_priced_with_chunks();
+    test_replay();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_sh1106_dirty.c
+ * @brief I2C cost of sh1106_update_dirty for typical small redraws
+ *
+ * Every span costs one addressing transaction (address + control + 3
+ * commands = 5 bus bytes) plus one data transaction per 16 columns
+ * (address + control + up to 16 data bytes).
+ */
+
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+#include "sh1106_panel.h"
+
+#define ADDR_TX_BYTES 5
+#define DATA_TX_BYTES(n) (2 + (n))
+
+static sh1106_t display;
+static sh1106_panel_t panel;
+
+// Bus bytes for one span of len columns
+static uint32_t span_bytes(uint32_t len) {
+    uint32_t bytes = ADDR_TX_BYTES;
+    while (len > 0) {
+        uint32_t n = len < 16 ? len : 16;
+        bytes += DATA_TX_BYTES(n);
+        len -= n;
+    }
+    return bytes;
+}
+
+static void test_full_update(void) {
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update(&display), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, SH1106_PAGES * (1 + SH1106_WIDTH / 16));
+    CHECK_EQ(fake_i2c.bus_bytes, SH1106_PAGES * span_bytes(SH1106_WIDTH));
+    CHECK(!sh1106_is_dirty(&display));
+}
+
+static void test_clean_update_sends_nothing(void) {
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update_dirty(&display), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 0);
+}
+
+// One line of 8 characters in page 2: a single 48-column span
+static void test_one_line_change(void) {
+    sh1106_draw_string_opaque(&display, 0, 16, "Speed 42");
+
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update_dirty(&display), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 1 + 3);
+    CHECK_EQ(fake_i2c.data_bytes, 48);
+    CHECK_EQ(fake_i2c.bus_bytes, span_bytes(48));
+    CHECK(panel_matches(&panel, &display));
+    CHECK(!sh1106_is_dirty(&display));
+}
+
+// A 16x16 sprite at an unaligned y touches three pages, 16 columns each
+static void test_sprite_change(void) {
+    static const uint8_t sprite[32] = {
+        0xE0, 0x18, 0x04, 0x02, 0x02, 0x01, 0x01, 0xFF, 0xFF, 0x01, 0x01, 0x02, 0x02, 0x04, 0x18, 0xE0,
+        0x07, 0x18, 0x20, 0x40, 0x40, 0x80, 0x80, 0xFF, 0xFF, 0x80, 0x80, 0x40, 0x40, 0x20, 0x18, 0x07,
+    };
+    sh1106_blit(&display, 40, 20, sprite, 16, 16, true);
+
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update_dirty(&display), HW_OK);
+    CHECK_EQ(fake_i2c.transactions, 3 * 2);
+    CHECK_EQ(fake_i2c.data_bytes, 3 * 16);
+    CHECK_EQ(fake_i2c.bus_bytes, 3 * span_bytes(16));
+    CHECK(panel_matches(&panel, &display));
+
+    // Moving it two pixels right resends the union of old and new columns
+    sh1106_fill_rect(&display, 40, 20, 16, 16, false);
+    sh1106_blit(&display, 42, 20, sprite, 16, 16, true);
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update_dirty(&display), HW_OK);
+    CHECK_EQ(fake_i2c.data_bytes, 3 * 18);
+    CHECK_EQ(fake_i2c.bus_bytes, 3 * span_bytes(18));
+    CHECK(panel_matches(&panel, &display));
+}
+
+// Clearing resends only the columns that held lit pixels
+static void test_clear(void) {
+    uint32_t expected = 0;
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        const uint8_t *row = &display.buffer[page * SH1106_WIDTH];
+        int first = -1, last = -1;
+        for (int x = 0; x < SH1106_WIDTH; x++) {
+            if (row[x]) {
+                if (first < 0) first = x;
+                last = x;
+            }
+        }
+        if (first >= 0) expected += span_bytes(last - first + 1);
+    }
+    CHECK(expected > 0);
+
+    sh1106_clear(&display);
+    fake_i2c_reset();
+    CHECK_EQ(sh1106_update_dirty(&display), HW_OK);
+    CHECK_EQ(fake_i2c.bus_bytes, expected);
+    CHECK(panel_matches(&panel, &display));
+}
+
+int main(void) {
+    panel_attach(&panel);
+    CHECK_EQ(sh1106_init(&display, i2c0, 0x3C, 4, 5), HW_OK);
+    CHECK(panel_matches(&panel, &display));
+
+    test_full_update();
+    test_clean_update_sends_nothing();
+    test_one_line_change();
+    test_sprite_change();
+    test_clear();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_sh1106_fill.c
+ * @brief fill_rect and blit kernels against a per-pixel reference, plus timings
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+static sh1106_t display;
+static uint8_t reference[SH1106_WIDTH * SH1106_PAGES];
+static uint32_t rng = 12345;
+
+static uint32_t next_rand(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static void ref_pixel(int x, int y, bool on) {
+    if (x < 0 || y < 0 || x >= SH1106_WIDTH || y >= SH1106_HEIGHT) return;
+    uint8_t bit = 1u << (y % 8);
+    uint8_t *b = &reference[(y / 8) * SH1106_WIDTH + x];
+    *b = on ? (*b | bit) : (*b & ~bit);
+}
+
+static void ref_fill(int x, int y, int w, int h, bool on) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) ref_pixel(x + i, y + j, on);
+    }
+}
+
+static void ref_blit(int x, int y, const uint8_t *bitmap, int w, int h, bool opaque) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            bool bit = (bitmap[(j / 8) * w + i] >> (j % 8)) & 1;
+            if (bit || opaque) ref_pixel(x + i, y + j, bit);
+        }
+    }
+}
+
+// Every column that differs from the panel copy must lie inside its page's dirty range
+static bool dirty_covers(const uint8_t *before) {
+    for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+        for (uint8_t x = 0; x < SH1106_WIDTH; x++) {
+            uint16_t i = page * SH1106_WIDTH + x;
+            if (display.buffer[i] != before[i] &&
+                (x < display.dirty_x0[page] || x > display.dirty_x1[page])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void test_fill_matches_reference(void) {
+    static uint8_t before[sizeof(reference)];
+    for (int n = 0; n < 20000; n++) {
+        uint8_t x = next_rand() % 140, y = next_rand() % 72;
+        uint8_t w = next_rand() % 140, h = next_rand() % 72;
+        bool on = next_rand() & 1;
+
+        memcpy(before, display.buffer, sizeof(before));
+        sh1106_mark_clean(&display);
+        sh1106_fill_rect(&display, x, y, w, h, on);
+        ref_fill(x, y, w, h, on);
+        if (memcmp(display.buffer, reference, sizeof(reference)) != 0) {
+            printf("fill mismatch: x=%u y=%u w=%u h=%u on=%d\n", x, y, w, h, on);
+            CHECK(false);
+            return;
+        }
+        CHECK(dirty_covers(before));
+    }
+}
+
+static void test_blit_matches_reference(void) {
+    static uint8_t before[sizeof(reference)];
+    uint8_t bitmap[64 * 8];
+    for (int n = 0; n < 20000; n++) {
+        uint8_t w = 1 + next_rand() % 64, h = 1 + next_rand() % 64;
+        uint8_t x = next_rand() % 136, y = next_rand() % 70;
+        bool opaque = next_rand() & 1;
+        for (size_t i = 0; i < sizeof(bitmap); i++) bitmap[i] = (uint8_t)next_rand();
+
+        memcpy(before, display.buffer, sizeof(before));
+        sh1106_mark_clean(&display);
+        sh1106_blit(&display, x, y, bitmap, w, h, opaque);
+        ref_blit(x, y, bitmap, w, h, opaque);
+        if (memcmp(display.buffer, reference, sizeof(reference)) != 0) {
+            printf("blit mismatch: x=%u y=%u w=%u h=%u opaque=%d\n", x, y, w, h, opaque);
+            CHECK(false);
+            return;
+        }
+        CHECK(dirty_covers(before));
+    }
+}
+
+// Kernel time against the set_pixel loop it replaced
+static void bench_fill(void) {
+    const int iters = 20000;
+    uint64_t t0 = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_fill_rect(&display, 3, 5, 100, 40, n & 1);
+    uint64_t t1 = test_now_ns();
+    for (int n = 0; n < iters / 10; n++) {
+        for (uint8_t y = 5; y < 45; y++) {
+            for (uint8_t x = 3; x < 103; x++) sh1106_set_pixel(&display, x, y, n & 1);
+        }
+    }
+    uint64_t t2 = test_now_ns();
+
+    double kernel = (double)(t1 - t0) / iters;
+    double pixels = (double)(t2 - t1) / (iters / 10);
+    printf("fill_rect 100x40: %.0f ns (set_pixel loop %.0f ns, %.1fx)\n", kernel, pixels, pixels / kernel);
+    CHECK(kernel < pixels);
+}
+
+static void bench_blit(void) {
+    static const uint8_t sprite[32] = {
+        0xE0, 0x18, 0x04, 0x02, 0x02, 0x01, 0x01, 0xFF, 0xFF, 0x01, 0x01, 0x02, 0x02, 0x04, 0x18, 0xE0,
+        0x07, 0x18, 0x20, 0x40, 0x40, 0x80, 0x80, 0xFF, 0xFF, 0x80, 0x80, 0x40, 0x40, 0x20, 0x18, 0x07,
+    };
+    const int iters = 200000;
+    uint64_t t0 = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_blit(&display, (uint8_t)(n % 112), 21, sprite, 16, 16, true);
+    uint64_t t1 = test_now_ns();
+    for (int n = 0; n < iters / 10; n++) {
+        uint8_t x0 = (uint8_t)(n % 112);
+        for (uint8_t j = 0; j < 16; j++) {
+            for (uint8_t i = 0; i < 16; i++) {
+                sh1106_set_pixel(&display, x0 + i, 21 + j, (sprite[(j / 8) * 16 + i] >> (j % 8)) & 1);
+            }
+        }
+    }
+    uint64_t t2 = test_now_ns();
+
+    double kernel = (double)(t1 - t0) / iters;
+    double pixels = (double)(t2 - t1) / (iters / 10);
+    printf("blit 16x16 at y%%8=5: %.0f ns (set_pixel loop %.0f ns, %.1fx)\n", kernel, pixels, pixels / kernel);
+    CHECK(kernel < pixels);
+}
+
+int main(void) {
+    memset(&display, 0, sizeof(display));
+    sh1106_mark_clean(&display);
+
+    test_fill_matches_reference();
+    test_blit_matches_reference();
+    bench_fill();
+    bench_blit();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file test_sh1106_shapes.c
+ * @brief Shape primitives: clipping against an unclipped canvas, geometry, timings
+ */
+
+#include <math.h>
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+// Large canvas: the screen window sits at CANVAS_OFF, so nothing drawn here clips
+#define CANVAS_SIZE 512
+#define CANVAS_OFF 192
+
+static sh1106_t display;
+static uint8_t canvas[CANVAS_SIZE][CANVAS_SIZE];
+static uint32_t rng = 4242;
+
+static uint32_t next_rand(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static void canvas_plot(void *ctx, int16_t x, int16_t y) {
+    (void)ctx;
+    canvas[y][x]++;
+}
+
+static const gfx_target_t canvas_target = { CANVAS_SIZE, CANVAS_SIZE, canvas_plot, NULL, NULL, NULL };
+
+static bool pixel(uint8_t x, uint8_t y) {
+    return (display.buffer[(y / 8) * SH1106_WIDTH + x] >> (y % 8)) & 1;
+}
+
+// The screen shows exactly the canvas window, and the dirty ranges cover it
+static bool screen_matches_canvas(void) {
+    for (uint8_t y = 0; y < SH1106_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SH1106_WIDTH; x++) {
+            bool lit = canvas[y + CANVAS_OFF][x + CANVAS_OFF] != 0;
+            if (pixel(x, y) != lit) return false;
+            uint8_t page = y / 8;
+            if (lit && (x < display.dirty_x0[page] || x > display.dirty_x1[page])) return false;
+        }
+    }
+    return true;
+}
+
+static void reset(void) {
+    memset(display.buffer, 0, sizeof(display.buffer));
+    sh1106_mark_clean(&display);
+    memset(canvas, 0, sizeof(canvas));
+}
+
+// Random shapes straddling every edge draw the same pixels as unclipped ones
+static void test_clipping_matches_unclipped(void) {
+    for (int n = 0; n < 3000; n++) {
+        reset();
+        int16_t cx = (int16_t)(next_rand() % 200) - 36;
+        int16_t cy = (int16_t)(next_rand() % 140) - 38;
+        uint8_t r = 1 + next_rand() % 50, r2 = 1 + next_rand() % 40;
+        int kind = n % 6;
+        sh1106_point_t pts[5];
+        for (int i = 0; i < 5; i++) {
+            pts[i].x = (int16_t)(next_rand() % 240) - 56;
+            pts[i].y = (int16_t)(next_rand() % 160) - 48;
+        }
+        gfx_point_t cpts[5];
+        for (int i = 0; i < 5; i++) cpts[i] = (gfx_point_t){pts[i].x + CANVAS_OFF, pts[i].y + CANVAS_OFF};
+        int16_t ccx = cx + CANVAS_OFF, ccy = cy + CANVAS_OFF;
+        int16_t a0 = (int16_t)(next_rand() % 720) - 360, a1 = a0 + (int16_t)(next_rand() % 400);
+
+        switch (kind) {
+            case 0: sh1106_draw_circle(&display, cx, cy, r, true); gfx_circle(&canvas_target, ccx, ccy, r); break;
+            case 1: sh1106_fill_circle(&display, cx, cy, r, true); gfx_fill_circle(&canvas_target, ccx, ccy, r); break;
+            case 2: sh1106_draw_ellipse(&display, cx, cy, r, r2, true); gfx_ellipse(&canvas_target, ccx, ccy, r, r2); break;
+            case 3: sh1106_fill_ellipse(&display, cx, cy, r, r2, true); gfx_fill_ellipse(&canvas_target, ccx, ccy, r, r2); break;
+            case 4: sh1106_draw_arc(&display, cx, cy, r, a0, a1, true); gfx_arc(&canvas_target, ccx, ccy, r, a0, a1); break;
+            default:
+                sh1106_fill_polygon(&display, pts, 5, true);
+                gfx_fill_polygon(&canvas_target, cpts, 5);
+                break;
+        }
+        if (!screen_matches_canvas()) {
+            printf("clip mismatch: kind %d centre (%d,%d) r %u/%u\n", kind, cx, cy, r, r2);
+            CHECK(false);
+            return;
+        }
+    }
+}
+
+// Outline pixels lie within half a pixel of the true circle; fills have no gaps
+static void test_circle_geometry(void) {
+    for (uint8_t r = 1; r <= 30; r++) {
+        reset();
+        gfx_circle(&canvas_target, 256, 256, r);
+        for (int y = 256 - r - 1; y <= 256 + r + 1; y++) {
+            for (int x = 256 - r - 1; x <= 256 + r + 1; x++) {
+                if (!canvas[y][x]) continue;
+                double d = hypot(x - 256, y - 256);
+                CHECK(fabs(d - r) <= 0.75);
+                CHECK(canvas[512 - y][x] && canvas[y][512 - x] && canvas[x][y]);
+            }
+        }
+
+        reset();
+        gfx_fill_circle(&canvas_target, 256, 256, r);
+        for (int y = 256 - r; y <= 256 + r; y++) {
+            int first = -1, last = -1;
+            for (int x = 256 - r - 1; x <= 256 + r + 1; x++) {
+                if (!canvas[y][x]) continue;
+                CHECK_EQ(canvas[y][x], 1);
+                if (first < 0) first = x;
+                last = x;
+            }
+            CHECK(first >= 0);
+            for (int x = first; x <= last; x++) CHECK(canvas[y][x]);
+        }
+    }
+}
+
+// Two triangles sharing a diagonal tile their rectangle exactly once (half-open coverage)
+static void test_polygon_tiling(void) {
+    reset();
+    gfx_point_t a[3] = {{210, 205}, {290, 205}, {290, 247}};
+    gfx_point_t b[3] = {{210, 205}, {290, 247}, {210, 247}};
+    gfx_fill_polygon(&canvas_target, a, 3);
+    gfx_fill_polygon(&canvas_target, b, 3);
+    for (int y = 200; y < 252; y++) {
+        for (int x = 205; x < 295; x++) {
+            bool inside = x >= 210 && x < 290 && y >= 205 && y < 247;
+            CHECK_EQ(canvas[y][x], inside ? 1 : 0);
+        }
+    }
+}
+
+// Nanoseconds per call for each primitive, plus a filled circle drawn per pixel
+static void bench_shapes(void) {
+    static const sh1106_point_t star[10] = {
+        {64, 2}, {72, 24}, {96, 24}, {77, 38}, {84, 61}, {64, 47}, {44, 61}, {51, 38}, {32, 24}, {56, 24},
+    };
+    const int iters = 20000;
+    uint64_t t[9];
+
+    t[0] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_draw_circle(&display, 64, 32, 28, n & 1);
+    t[1] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_fill_circle(&display, 64, 32, 28, n & 1);
+    t[2] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_fill_circle(&display, 4, 32, 28, n & 1);
+    t[3] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_draw_ellipse(&display, 64, 32, 60, 28, n & 1);
+    t[4] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_draw_arc(&display, 64, 32, 28, -30, 210, n & 1);
+    t[5] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_draw_polyline(&display, star, 10, true, n & 1);
+    t[6] = test_now_ns();
+    for (int n = 0; n < iters; n++) sh1106_fill_polygon(&display, star, 10, n & 1);
+    t[7] = test_now_ns();
+    for (int n = 0; n < iters / 10; n++) {
+        for (int y = -28; y <= 28; y++) {
+            for (int x = -28; x <= 28; x++) {
+                if (x * x + y * y <= 28 * 28 + 28) sh1106_set_pixel(&display, 64 + x, 32 + y, n & 1);
+            }
+        }
+    }
+    t[8] = test_now_ns();
+
+    static const char *names[] = {
+        "draw_circle r28", "fill_circle r28", "fill_circle r28 clipped", "draw_ellipse 60x28",
+        "draw_arc r28 240deg", "draw_polyline star", "fill_polygon star",
+    };
+    for (int i = 0; i < 7; i++) {
+        printf("%-24s %6.0f ns\n", names[i], (double)(t[i + 1] - t[i]) / iters);
+    }
+    double per_pixel = (double)(t[8] - t[7]) / (iters / 10);
+    printf("%-24s %6.0f ns (%.1fx fill_circle)\n", "set_pixel disk r28", per_pixel,
+           per_pixel / ((double)(t[2] - t[1]) / iters));
+    CHECK(t[2] - t[1] < (t[8] - t[7]) * 10);
+}
+
+int main(void) {
+    reset();
+    test_clipping_matches_unclipped();
+    test_circle_geometry();
+    test_polygon_tiling();
+    bench_shapes();
+    return TEST_RESULT();
+}
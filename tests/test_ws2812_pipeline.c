@@ -0,0 +1,204 @@
+/**
+ * @file test_ws2812_pipeline.c
+ * @brief Gamma, brightness, dithering and wire byte order of the output stage
+ */
+
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+#define BENCH_PIXELS 1000
+
+static hw_ws2812_t ws;
+
+static void open_strip(uint pixels, hw_ws2812_order_t order, uint8_t bits) {
+    hw_ws2812_config_t config = {
+        .pio = pio0, .sm = 0, .data_pin = 2, .num_pixels = pixels, .format = {order, bits},
+    };
+    CHECK_EQ(hw_ws2812_init(&ws, &config), HW_OK);
+}
+
+// Encode a frame and return pixel 0's wire word, first byte in bits 31..24
+static uint32_t show_word(void) {
+    CHECK_EQ(hw_ws2812_show(&ws), HW_OK);
+    CHECK_EQ(hw_ws2812_wait(&ws), HW_OK);
+    return ws.wire[0];
+}
+
+// GRB: G in the first byte, R in the second, B in the third
+static uint8_t wire_red(uint32_t word) { return (uint8_t)(word >> 16); }
+
+// =============================================================================
+// Byte order
+// =============================================================================
+
+static void test_color_order(void) {
+    // Wire byte (0 = first) that carries R, G and B for each order
+    static const uint8_t slots[][3] = {
+        [HW_WS2812_ORDER_GRB] = {1, 0, 2},
+        [HW_WS2812_ORDER_RGB] = {0, 1, 2},
+        [HW_WS2812_ORDER_BRG] = {1, 2, 0},
+        [HW_WS2812_ORDER_RBG] = {0, 2, 1},
+        [HW_WS2812_ORDER_GBR] = {2, 0, 1},
+        [HW_WS2812_ORDER_BGR] = {2, 1, 0},
+    };
+    for (int pipeline = 0; pipeline < 2; pipeline++) {
+        for (uint order = 0; order < ARRAY_SIZE(slots); order++) {
+            for (uint8_t bits = 24; bits <= 32; bits += 8) {
+                open_strip(4, (hw_ws2812_order_t)order, bits);
+                if (pipeline) CHECK_EQ(hw_ws2812_enable_pipeline(&ws, false, false), HW_OK);
+                CHECK_EQ(hw_ws2812_set_pixel_rgbw(&ws, 0, 0x11, 0x82, 0xF3, 0xC4), HW_OK);
+
+                uint32_t want = (0x11u << (24 - 8 * slots[order][0])) |
+                                (0x82u << (24 - 8 * slots[order][1])) |
+                                (0xF3u << (24 - 8 * slots[order][2]));
+                // RGBW sends W last; 24-bit autopull never shifts out the low byte
+                uint32_t got = show_word();
+                if (bits == 32) {
+                    want |= 0xC4;
+                } else {
+                    got &= 0xFFFFFF00;
+                }
+                if (got != want) {
+                    printf("order %u, %u bits, pipeline %d: 0x%08x, expected 0x%08x\n",
+                           order, bits, pipeline, (unsigned)got, (unsigned)want);
+                }
+                CHECK_EQ(got, want);
+                hw_ws2812_deinit(&ws);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Brightness and gamma
+// =============================================================================
+
+static void test_brightness_limits(void) {
+    for (int pipeline = 0; pipeline < 3; pipeline++) {
+        open_strip(4, HW_WS2812_ORDER_RGB, 32);
+        if (pipeline) CHECK_EQ(hw_ws2812_enable_pipeline(&ws, false, pipeline == 2), HW_OK);
+
+        // 255 is an exact identity for every 8-bit level
+        CHECK_EQ(hw_ws2812_set_brightness(&ws, 255), HW_OK);
+        int wrong = 0;
+        for (uint x = 0; x < 256; x++) {
+            hw_ws2812_set_pixel_rgbw(&ws, 0, (uint8_t)x, (uint8_t)(255 - x), (uint8_t)x, (uint8_t)(x ^ 0x5A));
+            uint32_t want = (x << 24) | ((255 - x) << 16) | (x << 8) | (x ^ 0x5A);
+            if (show_word() != want) wrong++;
+        }
+        if (wrong) printf("pipeline mode %d: %d levels not passed through at 255\n", pipeline, wrong);
+        CHECK_EQ(wrong, 0);
+
+        // 0 is dark, and stays dark over frames with dithering
+        CHECK_EQ(hw_ws2812_set_brightness(&ws, 0), HW_OK);
+        hw_ws2812_set_pixel_rgbw(&ws, 0, 255, 255, 255, 255);
+        int lit = 0;
+        for (int frame = 0; frame < 300; frame++) {
+            if (show_word() != 0) lit++;
+        }
+        CHECK_EQ(lit, 0);
+        hw_ws2812_deinit(&ws);
+    }
+}
+
+static void test_gamma(void) {
+    open_strip(4, HW_WS2812_ORDER_GRB, 24);
+    CHECK_EQ(hw_ws2812_enable_pipeline(&ws, true, false), HW_OK);
+
+    // Endpoints are exact and the curve never steps backwards
+    uint8_t out[256];
+    for (uint x = 0; x < 256; x++) {
+        hw_ws2812_set_pixel(&ws, 0, (uint8_t)x, 0, 0);
+        out[x] = wire_red(show_word());
+    }
+    CHECK_EQ(out[0], 0);
+    CHECK_EQ(out[255], 255);
+    int backwards = 0;
+    for (uint x = 1; x < 256; x++) {
+        if (out[x] < out[x - 1]) backwards++;
+    }
+    CHECK_EQ(backwards, 0);
+    // 2.2 gamma: half input is about a fifth of the output
+    CHECK_EQ(out[128], 56);
+    hw_ws2812_deinit(&ws);
+}
+
+// =============================================================================
+// Dithering
+// =============================================================================
+
+// Over 256 frames the dithered 8-bit outputs add up to exactly the 8.8
+// fixed-point level (linear / 257 * 256), each frame on the floor or ceiling of it
+static void check_dither(uint16_t linear, uint8_t brightness) {
+    open_strip(1, HW_WS2812_ORDER_GRB, 24);
+    CHECK_EQ(hw_ws2812_enable_pipeline(&ws, false, true), HW_OK);
+    CHECK_EQ(hw_ws2812_set_brightness(&ws, brightness), HW_OK);
+    CHECK_EQ(hw_ws2812_set_pixel16(&ws, 0, linear, 0, 0), HW_OK);
+
+    uint32_t scaled = ((uint32_t)linear * ws.brightness) >> 8;
+    uint32_t level = scaled - (scaled >> 8);
+    uint32_t sum = 0;
+    int off = 0;
+    for (int frame = 0; frame < 256; frame++) {
+        uint32_t r = wire_red(show_word());
+        if (r != level >> 8 && r != (level >> 8) + 1) off++;
+        sum += r;
+    }
+    if (sum != level) printf("dither %u at %u: sum %u, expected %u\n", linear, brightness, (unsigned)sum, (unsigned)level);
+    CHECK_EQ(sum, level);
+    CHECK_EQ(off, 0);
+    hw_ws2812_deinit(&ws);
+}
+
+static void test_dither(void) {
+    static const uint16_t levels[] = {1, 200, 257, 385, 1000, 12345, 40000, 65535};
+    static const uint8_t brightness[] = {255, 128, 17};
+    for (unsigned i = 0; i < ARRAY_SIZE(levels); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(brightness); j++) {
+            check_dither(levels[i], brightness[j]);
+        }
+    }
+}
+
+// =============================================================================
+// Benchmark
+// =============================================================================
+
+static double convert_us(bool pipeline, bool gamma, bool dither) {
+    enum { FRAMES = 2000 };
+    open_strip(BENCH_PIXELS, HW_WS2812_ORDER_GRB, 24);
+    if (pipeline) hw_ws2812_enable_pipeline(&ws, gamma, dither);
+    hw_ws2812_set_brightness(&ws, 180);
+    for (uint i = 0; i < BENCH_PIXELS; i++) {
+        hw_ws2812_set_pixel(&ws, i, (uint8_t)i, (uint8_t)(i * 7), (uint8_t)(i * 13));
+    }
+
+    // Time the conversion in show, not the fake transfer and latch wait
+    uint64_t total = 0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        uint64_t t0 = test_now_ns();
+        hw_ws2812_show(&ws);
+        total += test_now_ns() - t0;
+        hw_ws2812_wait(&ws);
+    }
+    test_sink = ws.wire[BENCH_PIXELS / 2];
+    hw_ws2812_deinit(&ws);
+    return (double)total / FRAMES / 1000;
+}
+
+static void bench(void) {
+    printf("conversion, %d pixels (host us/frame)\n", BENCH_PIXELS);
+    printf("  8-bit + brightness   %7.2f\n", convert_us(false, false, false));
+    printf("  pipeline             %7.2f\n", convert_us(true, false, false));
+    printf("  pipeline + dither    %7.2f\n", convert_us(true, true, true));
+}
+
+int main(void) {
+    test_color_order();
+    test_brightness_limits();
+    test_gamma();
+    test_dither();
+    bench();
+    return TEST_RESULT();
+}
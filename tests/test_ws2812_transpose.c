@@ -0,0 +1,139 @@
+/**
+ * @file test_ws2812_transpose.c
+ * @brief Bit-plane transpose and parallel frame encoding against the wire spec
+ */
+
+#include <string.h>
+#include "lib.h"
+#include "fake_sdk.h"
+#include "test_common.h"
+
+static uint32_t rng = 2024;
+
+static uint32_t next_rand(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+// Spec: planes[k] holds bit (7 - k) of every lane, lane L in bit L
+static void transpose_reference(const uint8_t lanes[8], uint8_t planes[8]) {
+    for (int k = 0; k < 8; k++) {
+        planes[k] = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            planes[k] |= (uint8_t)(((lanes[lane] >> (7 - k)) & 1) << lane);
+        }
+    }
+}
+
+static void test_transpose_spec(void) {
+    uint8_t lanes[8], planes[8], expected[8];
+
+    // Every single set bit lands in exactly one place
+    for (int lane = 0; lane < 8; lane++) {
+        for (int bit = 0; bit < 8; bit++) {
+            memset(lanes, 0, sizeof(lanes));
+            lanes[lane] = (uint8_t)(1u << bit);
+            hw_ws2812_transpose8(lanes, planes);
+            for (int k = 0; k < 8; k++) {
+                CHECK_EQ(planes[k], k == 7 - bit ? (1u << lane) : 0);
+            }
+        }
+    }
+
+    int mismatches = 0;
+    for (int n = 0; n < 100000; n++) {
+        for (int i = 0; i < 8; i++) lanes[i] = (uint8_t)next_rand();
+        hw_ws2812_transpose8(lanes, planes);
+        transpose_reference(lanes, expected);
+        if (memcmp(planes, expected, 8) != 0) mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+// Rebuild each lane's wire bytes from the planes in wire[] and compare
+static void check_parallel_frame(uint lanes, uint pixels, const hw_ws2812_format_t *format,
+                                 const uint8_t *expected_bytes, uint channels) {
+    hw_ws2812_config_t config = {
+        .pio = pio0, .sm = 0, .data_pin = 2, .num_pixels = pixels, .num_lanes = lanes, .format = *format,
+    };
+    hw_ws2812_t ws;
+    CHECK_EQ(hw_ws2812_init(&ws, &config), HW_OK);
+
+    for (uint lane = 0; lane < lanes; lane++) {
+        for (uint i = 0; i < pixels; i++) {
+            const uint8_t *rgbw = &expected_bytes[(lane * pixels + i) * 4];
+            hw_ws2812_set_pixel_rgbw(&ws, lane * pixels + i, rgbw[0], rgbw[1], rgbw[2], rgbw[3]);
+        }
+    }
+    CHECK_EQ(hw_ws2812_show(&ws), HW_OK);
+    CHECK_EQ(ws.wire_words, pixels * channels * 2);
+
+    // GRB wire order (plus W last for 32-bit)
+    static const int order[4] = {1, 0, 2, 3};
+    const uint8_t *wire = (const uint8_t *)ws.wire;
+    int mismatches = 0;
+    for (uint i = 0; i < pixels; i++) {
+        for (uint c = 0; c < channels; c++) {
+            const uint8_t *planes = &wire[(i * channels + c) * 8];
+            for (uint lane = 0; lane < HW_WS2812_MAX_LANES; lane++) {
+                uint8_t byte = 0;
+                for (int k = 0; k < 8; k++) byte = (uint8_t)((byte << 1) | ((planes[k] >> lane) & 1));
+                uint8_t want = lane < lanes ? expected_bytes[(lane * pixels + i) * 4 + order[c]] : 0;
+                if (byte != want) mismatches++;
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+
+    hw_ws2812_deinit(&ws);
+}
+
+static void test_parallel_encoding(void) {
+    static uint8_t colors[8 * 40 * 4];
+    for (size_t i = 0; i < sizeof(colors); i++) colors[i] = (uint8_t)next_rand();
+
+    hw_ws2812_format_t grb = {HW_WS2812_ORDER_GRB, 24};
+    hw_ws2812_format_t grbw = {HW_WS2812_ORDER_GRB, 32};
+    for (size_t i = 3; i < sizeof(colors); i += 4) colors[i] = 0;
+    check_parallel_frame(8, 40, &grb, colors, 3);
+    check_parallel_frame(3, 17, &grb, colors, 3);
+
+    for (size_t i = 3; i < sizeof(colors); i += 4) colors[i] = (uint8_t)next_rand();
+    check_parallel_frame(4, 25, &grbw, colors, 4);
+}
+
+static void bench(void) {
+    enum { N = 1 << 20 };
+    static uint8_t in[N / 8][8];
+    uint8_t out[8];
+    for (int i = 0; i < N / 8; i++) {
+        for (int j = 0; j < 8; j++) in[i][j] = (uint8_t)next_rand();
+    }
+    uint32_t acc = 0;
+
+    uint64_t t0 = test_now_ns();
+    for (int r = 0; r < 8; r++) {
+        for (int i = 0; i < N / 8; i++) {
+            hw_ws2812_transpose8(in[i], out);
+            acc += out[0] ^ out[7];
+        }
+    }
+    uint64_t t1 = test_now_ns();
+    for (int r = 0; r < 8; r++) {
+        for (int i = 0; i < N / 8; i++) {
+            transpose_reference(in[i], out);
+            acc += out[0] ^ out[7];
+        }
+    }
+    uint64_t t2 = test_now_ns();
+    test_sink = acc;
+
+    printf("transpose8 %.2f ns (bit loop %.2f ns)\n", (double)(t1 - t0) / N, (double)(t2 - t1) / N);
+}
+
+int main(void) {
+    test_transpose_spec();
+    test_parallel_encoding();
+    bench();
+    return TEST_RESULT();
+}
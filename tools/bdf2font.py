@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Convert a BDF bitmap font into a packed sh1106_font_t table.
+
+Glyphs are packed page-aligned, matching the SH1106 framebuffer layout:
+ceil(height / 8) rows of `width` column bytes, LSB = top pixel. Leading and
+trailing blank columns are trimmed; the BDF DWIDTH becomes the advance.
+
+Usage:
+    tools/bdf2font.py tools/fonts/prop8.bdf sh1106_font_prop8 \
+        -o lib/oled/fonts/font_prop8.c [--first 32] [--last 126] [--fallback '?']
+"""
+
+import argparse
+import os
+import sys
+
+
+def parse_bdf(path):
+    """Return (height, ascent, {code: glyph}) where glyph holds advance and pixel rows."""
+    glyphs = {}
+    ascent = descent = None
+    bbox = None
+    cur = None
+    rows = None
+
+    with open(path) as f:
+        for raw in f:
+            line = raw.strip()
+            if not line:
+                continue
+            key, _, rest = line.partition(" ")
+            if rows is not None:
+                if key == "ENDCHAR":
+                    cur["rows"] = rows
+                    if cur["code"] >= 0:
+                        glyphs[cur["code"]] = cur
+                    cur = rows = None
+                else:
+                    rows.append(int(key, 16))
+                continue
+            if key == "FONTBOUNDINGBOX":
+                bbox = [int(v) for v in rest.split()]
+            elif key == "FONT_ASCENT":
+                ascent = int(rest)
+            elif key == "FONT_DESCENT":
+                descent = int(rest)
+            elif key == "STARTCHAR":
+                cur = {"code": -1, "advance": 0, "bbx": (0, 0, 0, 0)}
+            elif key == "ENCODING":
+                cur["code"] = int(rest.split()[0])
+            elif key == "DWIDTH":
+                cur["advance"] = int(rest.split()[0])
+            elif key == "BBX":
+                cur["bbx"] = tuple(int(v) for v in rest.split())
+            elif key == "BITMAP":
+                rows = []
+
+    if bbox is None:
+        sys.exit(f"{path}: missing FONTBOUNDINGBOX")
+    if ascent is None:
+        ascent = bbox[1] + bbox[3]
+    if descent is None:
+        descent = -bbox[3]
+    return ascent + descent, ascent, glyphs
+
+
+def pack_glyph(glyph, height, ascent):
+    """Render a BDF glyph into page-major column bytes; returns (width, bytes)."""
+    w, h, xoff, yoff = glyph["bbx"]
+    row_bits = ((w + 7) // 8) * 8
+    cols = {}
+    for r, bits in enumerate(glyph["rows"][:h]):
+        y = ascent - (yoff + h) + r
+        if not 0 <= y < height:
+            continue
+        for c in range(w):
+            if bits & (1 << (row_bits - 1 - c)):
+                x = xoff + c
+                if x >= 0:
+                    cols[x] = cols.get(x, 0) | (1 << y)
+
+    if not cols:
+        return 0, b""
+
+    # Keep the left bearing relative to the cursor, trim the right edge
+    width = max(cols) + 1
+    pages = (height + 7) // 8
+    out = bytearray()
+    for p in range(pages):
+        for x in range(width):
+            out.append((cols.get(x, 0) >> (p * 8)) & 0xFF)
+    return width, bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("bdf", help="input BDF font")
+    ap.add_argument("name", help="C symbol for the sh1106_font_t")
+    ap.add_argument("-o", "--output", help="output .c file (default: stdout)")
+    ap.add_argument("--first", type=int, default=32, help="first character code (default 32)")
+    ap.add_argument("--last", type=int, default=126, help="last character code (default 126)")
+    ap.add_argument("--fallback", default="?", help="character used for missing codes (default '?')")
+    args = ap.parse_args()
+
+    height, ascent, glyphs = parse_bdf(args.bdf)
+    codes = [c for c in range(args.first, args.last + 1) if c in glyphs]
+    if not codes:
+        sys.exit("no glyphs in range")
+    first, last = codes[0], codes[-1]
+
+    fallback = ord(args.fallback)
+    if fallback not in glyphs or not first <= fallback <= last:
+        fallback = 32 if 32 in glyphs and first <= 32 <= last else first
+
+    bitmap = bytearray()
+    entries = {}
+    for code in codes:
+        width, data = pack_glyph(glyphs[code], height, ascent)
+        entries[code] = (len(bitmap), width, glyphs[code]["advance"])
+        bitmap += data
+    if len(bitmap) > 0xFFFF:
+        sys.exit("bitmap exceeds 64 KiB glyph offset range")
+
+    def label(code):
+        ch = chr(code)
+        return {"\\": "backslash", "'": "quote"}.get(ch, ch)
+
+    src = os.path.basename(args.bdf)
+    out = []
+    out.append(f"// Generated by tools/bdf2font.py from {src} - do not edit.")
+    out.append(f"// {last - first + 1} glyphs, {height}px high, {len(bitmap)} bitmap bytes")
+    out.append("")
+    out.append('#include "../../lib.h"')
+    out.append("")
+    out.append(f"static const uint8_t {args.name}_bitmap[] = {{")
+    for code in codes:
+        off, width, _ = entries[code]
+        size = width * ((height + 7) // 8)
+        if size:
+            data = ", ".join(f"0x{b:02X}" for b in bitmap[off:off + size])
+            out.append(f"    {data}, // {label(code)}")
+    out.append("};")
+    out.append("")
+    out.append(f"static const sh1106_glyph_t {args.name}_glyphs[] = {{")
+    for code in range(first, last + 1):
+        off, width, adv = entries.get(code, entries[fallback])
+        out.append(f"    {{{off:5d}, {width:2d}, {adv:2d}}}, // {label(code)}")
+    out.append("};")
+    out.append("")
+    out.append(f"const sh1106_font_t {args.name} = {{")
+    out.append(f"    .bitmap = {args.name}_bitmap,")
+    out.append(f"    .glyphs = {args.name}_glyphs,")
+    out.append(f"    .first = {first},")
+    out.append(f"    .last = {last},")
+    out.append(f"    .fallback = {fallback},")
+    out.append(f"    .height = {height},")
+    out.append("};")
+
+    text = "\n".join(out) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
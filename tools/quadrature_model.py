@@ -0,0 +1,349 @@
+#!/usr/bin/env python3
+"""Replay quadrature edge traces through a model of the encoder PIO program.
+
+The program is assembled from lib/encoder/encoder_quadrature.pio and run
+instruction by instruction (one instruction per state machine cycle) against
+the trace. Its count is checked against the reference decoder, which applies
+the IRQ backend's transition_table (parsed from encoder_ec11.c) to every state in
+the trace. The IRQ backend is also modeled with a given interrupt latency and
+handler time, to show how many counts it loses on the same trace.
+
+A trace is CSV with one sample per line: time in microseconds, A, B (a header
+line and any further columns are ignored), e.g. a logic analyzer export.
+Without a trace, --synth generates a spin with contact bounce. ctest runs the
+model on the traces in tests/traces/ and fails on any mismatch.
+
+Usage:
+    tools/quadrature_model.py capture.csv [more.csv ...] [--sys-hz 150e6] \\
+        [--clkdiv 1] [--irq-latency-us 1] [--irq-handler-us 2]
+    tools/quadrature_model.py --synth 2000 --rate 20000 --bounce-us 50 \\
+        [--seed 1] [--write-trace spin.csv]
+"""
+
+import argparse
+import os
+import random
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+PIO_SRC = os.path.join(ROOT, "lib", "encoder", "encoder_quadrature.pio")
+DRIVER_SRC = os.path.join(ROOT, "lib", "encoder", "encoder_ec11.c")
+
+MASK = 0xFFFFFFFF
+LOOP_MAX_CYCLES = 10  # Longest trip around the program (an up-count)
+
+
+def assemble(path):
+    """Assemble the first program in a .pio file (the subset it uses)."""
+    text = open(path).read().split("% c-sdk")[0]
+    lines = []
+    labels = {}
+    wrap_target = wrap = None
+    origin = 0
+    for raw in text.splitlines():
+        line = raw.split(";")[0].strip()
+        if not line or line.startswith(".program"):
+            continue
+        if line.startswith(".origin"):
+            origin = int(line.split()[1])
+            continue
+        if line == ".wrap_target":
+            wrap_target = len(lines)
+            continue
+        if line == ".wrap":
+            wrap = len(lines) - 1
+            continue
+        m = re.match(r"(?:public\s+)?(\w+):$", line)
+        if m:
+            labels[m.group(1)] = len(lines)
+            continue
+        lines.append(line)
+
+    if origin != 0:
+        sys.exit(f"{path}: model assumes .origin 0")
+    prog = []
+    for line in lines:
+        op, _, rest = line.partition(" ")
+        args = [a.strip() for a in rest.split(",")] if rest else []
+        if op == "jmp":
+            cond, target = (args[0], args[1]) if len(args) == 2 else ("", args[0])
+            prog.append(("jmp", cond, labels[target]))
+        elif op == "mov":
+            src = args[1]
+            invert = src[0] in "~!"
+            prog.append(("mov", args[0], src.lstrip("~!"), invert))
+        elif op == "push":
+            prog.append(("push", "noblock" in args))
+        elif op in ("in", "out"):
+            prog.append((op, args[0], int(args[1])))
+        else:
+            sys.exit(f"{path}: model does not implement '{line}'")
+    return prog, labels, wrap_target, wrap
+
+
+def driver_transition_table(path):
+    """The IRQ backend's [from][to] step table, state = (a << 1) | b.
+
+    Illegal transitions (both inputs changed) count as 0, as in the PIO
+    program, which ignores them.
+    """
+    src = open(path).read()
+    m = re.search(r"transition_table\[16\]\s*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        sys.exit(f"{path}: transition_table not found")
+    body = re.sub(r"//.*|/\*.*?\*/", "", m.group(1))
+    vals = [0 if v == "TRANSITION_ILLEGAL" else int(v)
+            for v in re.findall(r"[+-]?\d+|TRANSITION_ILLEGAL", body)]
+    if len(vals) != 16:
+        sys.exit(f"{path}: transition_table has {len(vals)} entries")
+    return [vals[i * 4:i * 4 + 4] for i in range(4)]
+
+
+class StateMachine:
+    """One PIO state machine running the decoder, pins = (B << 1) | A."""
+
+    def __init__(self, asm, pins):
+        self.prog, labels, self.wrap_target, self.wrap = asm
+        self.update = labels["update"]
+        # As encoder_quadrature_program_init: y = 0, previous sample = pins
+        self.pc = self.update
+        self.x = self.y = 0
+        self.isr = self.osr = pins
+        self.last_push = 0
+
+    def count(self):
+        """What the driver reads (drain, then one fresh push), as a position."""
+        v = -self.last_push & MASK
+        return v - (1 << 32) if v & 0x80000000 else v
+
+    def step(self, pins):
+        ins = self.prog[self.pc]
+        nxt = self.wrap_target if self.pc == self.wrap else self.pc + 1
+        op = ins[0]
+        if op == "jmp":
+            _, cond, target = ins
+            if cond == "":
+                take = True
+            elif cond in ("y--", "x--"):
+                reg = cond[0]
+                take = getattr(self, reg) != 0
+                setattr(self, reg, (getattr(self, reg) - 1) & MASK)
+            elif cond in ("!x", "!y"):
+                take = getattr(self, cond[1]) == 0
+            else:
+                sys.exit(f"model does not implement jmp condition '{cond}'")
+            if take:
+                nxt = target
+        elif op == "mov":
+            _, dst, src, invert = ins
+            v = {"x": self.x, "y": self.y, "isr": self.isr, "osr": self.osr,
+                 "null": 0, "pins": pins}[src]
+            if invert:
+                v = ~v & MASK
+            if dst == "pc":
+                nxt = v & 31
+            else:
+                setattr(self, dst, v)
+        elif op == "push":
+            # The driver drains stale entries, so it always sees the newest push
+            self.last_push = self.isr
+            self.isr = 0
+        elif op == "out":
+            _, dst, n = ins
+            v = self.osr & ((1 << n) - 1)
+            self.osr >>= n
+            setattr(self, dst, v)
+        elif op == "in":
+            _, src, n = ins
+            v = pins if src == "pins" else getattr(self, src)
+            self.isr = ((self.isr << n) | (v & ((1 << n) - 1))) & MASK
+        self.pc = nxt
+
+    def key(self):
+        return (self.pc, self.x, self.y, self.isr, self.osr)
+
+
+def pins_of(a, b):
+    return (b << 1) | a
+
+
+def check_table(asm, table):
+    """Every single transition must move the count like the driver's table."""
+    bad = []
+    for prev in range(4):
+        for cur in range(4):
+            sm = StateMachine(asm, prev)
+            for _ in range(3 * LOOP_MAX_CYCLES):
+                sm.step(prev)
+            base = sm.count()
+            for _ in range(3 * LOOP_MAX_CYCLES):
+                sm.step(cur)
+            pa, pb = prev & 1, prev >> 1
+            ca, cb = cur & 1, cur >> 1
+            want = table[(pa << 1) | pb][(ca << 1) | cb]
+            if sm.count() - base != want:
+                bad.append((prev, cur, sm.count() - base, want))
+    return bad
+
+
+def load_trace(path):
+    samples = []
+    for line in open(path):
+        fields = line.replace(";", ",").split(",")
+        try:
+            t, a, b = float(fields[0]), int(float(fields[1])), int(float(fields[2]))
+        except (ValueError, IndexError):
+            continue
+        samples.append((t, a & 1, b & 1))
+    samples.sort(key=lambda s: s[0])
+    # Keep only changes
+    out = []
+    for s in samples:
+        if not out or (s[1], s[2]) != (out[-1][1], out[-1][2]):
+            out.append(s)
+    return out
+
+
+def synth_trace(edges, rate, bounce_us, seed):
+    """Spin forward then back, peaking at `rate` edges/s, with contact bounce."""
+    rng = random.Random(seed)
+    seq = [(0, 0), (1, 0), (1, 1), (0, 1)]  # A leads B: the driver's positive direction
+    t, phase = 0.0, 0
+    out = [(t, 0, 0)]
+    for i in range(edges):
+        forward = i < edges * 2 // 3
+        # Ramp up and down within each direction
+        span = edges * 2 // 3 if forward else edges - edges * 2 // 3
+        k = i if forward else i - edges * 2 // 3
+        speed = rate * max(0.05, 1 - abs(2 * k / max(span, 1) - 1))
+        t += 1e6 / speed * rng.uniform(0.8, 1.2)
+        prev = seq[phase]
+        phase = (phase + (1 if forward else -1)) % 4
+        cur = seq[phase]
+        # The channel that changes chatters before settling
+        bt = t
+        for _ in range(rng.randint(0, 4) if bounce_us > 0 else 0):
+            bt += rng.uniform(0.02, bounce_us / 4)
+            out.append((bt, *cur))
+            bt += rng.uniform(0.02, bounce_us / 4)
+            out.append((bt, *prev))
+        t = max(t, bt) + 0.05
+        out.append((t, *cur))
+    return out
+
+
+def reference_positions(trace, table):
+    pos, state = 0, None
+    result = []
+    for _, a, b in trace:
+        s = (a << 1) | b
+        if state is not None:
+            pos += table[state][s]
+        state = s
+        result.append(pos)
+    return result
+
+
+def irq_model(trace, table, latency_us, handler_us):
+    """IRQ backend: the handler reads both pins once it runs; edges coalesce."""
+    pos = 0
+    state = (trace[0][1] << 1) | trace[0][2]
+    free_at = float("-inf")
+    i, n = 1, len(trace)
+    while i < n:
+        # Next handler run reads the pins at this time
+        read_t = max(trace[i][0] + latency_us, free_at + latency_us)
+        while i + 1 < n and trace[i + 1][0] <= read_t:
+            i += 1
+        s = (trace[i][1] << 1) | trace[i][2]
+        pos += table[state][s]
+        state = s
+        free_at = read_t + handler_us
+        i += 1
+    return pos
+
+
+def run_pio(trace, asm, cycle_us):
+    """Run the state machine over a trace; return its count before each change."""
+    sm = StateMachine(asm, pins_of(trace[0][1], trace[0][2]))
+    t0 = trace[0][0]
+    cycle = 0
+    counts = []
+    for idx, (t, a, b) in enumerate(trace):
+        pins = pins_of(a, b)
+        end = int((trace[idx + 1][0] - t0) / cycle_us) if idx + 1 < len(trace) else cycle + 20 * LOOP_MAX_CYCLES
+        seen = None
+        while cycle < end:
+            if sm.pc == sm.update:
+                key = sm.key()
+                if seen and seen[0] == key:
+                    # Idle loop: skip whole periods up to the next edge
+                    period = cycle - seen[1]
+                    cycle += max(0, (end - cycle) // period - 1) * period
+                seen = (key, cycle)
+            sm.step(pins)
+            cycle += 1
+        counts.append((sm.count(), end - int((t - t0) / cycle_us)))
+    return counts
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("traces", nargs="*", help="CSV edge traces (time_us, A, B)")
+    ap.add_argument("--sys-hz", type=float, default=150e6, help="system clock (default 150e6; RP2040: 125e6)")
+    ap.add_argument("--clkdiv", type=float, default=1, help="state machine clock divider (default 1)")
+    ap.add_argument("--irq-latency-us", type=float, default=1.0, help="IRQ model: edge to pin read (default 1)")
+    ap.add_argument("--irq-handler-us", type=float, default=2.0, help="IRQ model: pin read to return (default 2)")
+    ap.add_argument("--synth", type=int, metavar="EDGES", help="generate a trace with this many edges")
+    ap.add_argument("--rate", type=float, default=20000, help="synth: peak edges per second (default 20000)")
+    ap.add_argument("--bounce-us", type=float, default=50, help="synth: contact bounce window (default 50)")
+    ap.add_argument("--seed", type=int, default=1, help="synth: random seed (default 1)")
+    ap.add_argument("--write-trace", help="synth: also save the trace as CSV")
+    args = ap.parse_args()
+
+    asm = assemble(PIO_SRC)
+    table = driver_transition_table(DRIVER_SRC)
+    bad = check_table(asm, table)
+    for prev, cur, got, want in bad:
+        print(f"table: B:A {prev:02b} -> {cur:02b} counts {got:+d}, driver {want:+d}")
+    print(f"jump table vs driver transition_table: {16 - len(bad)}/16 transitions agree")
+
+    traces = [(p, load_trace(p)) for p in args.traces]
+    if args.synth:
+        trace = synth_trace(args.synth, args.rate, args.bounce_us, args.seed)
+        if args.write_trace:
+            with open(args.write_trace, "w") as f:
+                f.write("time_us,a,b\n")
+                f.writelines(f"{t:.3f},{a},{b}\n" for t, a, b in trace)
+        traces.append((f"synth({args.synth} edges, {args.rate:g}/s, bounce {args.bounce_us:g} us)", trace))
+    if not traces:
+        ap.error("need a trace file or --synth")
+
+    cycle_us = args.clkdiv * 1e6 / args.sys_hz
+    failed = bool(bad)
+    for name, trace in traces:
+        if len(trace) < 2:
+            print(f"{name}: no edges")
+            continue
+        ref = reference_positions(trace, table)
+        pio = run_pio(trace, asm, cycle_us)
+        # A state held for two loops has been sampled, counted and pushed
+        checked = [(r, c) for r, (c, held) in zip(ref, pio) if held >= 2 * LOOP_MAX_CYCLES]
+        wrong = sum(1 for r, c in checked if r != c)
+        irq = irq_model(trace, table, args.irq_latency_us, args.irq_handler_us)
+        gaps = [b[0] - a[0] for a, b in zip(trace, trace[1:])]
+        ok = wrong == 0 and pio[-1][0] == ref[-1]
+        failed |= not ok
+        print(f"{name}: {len(trace) - 1} edges, shortest gap {min(gaps):.3f} us")
+        print(f"  reference {ref[-1]:+d}  pio {pio[-1][0]:+d}  "
+              f"({len(checked)} settled states checked, {wrong} wrong)  {'ok' if ok else 'MISMATCH'}")
+        print(f"  irq model {irq:+d} ({abs(ref[-1] - irq)} counts off at "
+              f"{args.irq_latency_us:g} us latency + {args.irq_handler_us:g} us handler)")
+    print(f"pio samples every {LOOP_MAX_CYCLES * cycle_us * 1000:.0f} ns or faster "
+          f"(edges up to {1 / (LOOP_MAX_CYCLES * cycle_us):.2f} MHz)")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""Encode an animation into a led_clip_t blob of pre-encoded WS2812 FIFO words.
+
+Frames are packed exactly as lib/rgb_led/ws2812.c puts them on the wire: one
+MSB-first word per pixel for a single strip, or 8-lane bit-planes for parallel
+output. Brightness and gamma are baked in, since clip playback bypasses the
+strip's output pipeline. Delta encoding stores frame 0 whole and later frames
+as skip / copy / fill runs against the previous frame.
+
+Input is raw 8-bit RGB (or RGBW with --bits 32) frames, back to back, laid out
+in strip index order (lane L, LED i at L * pixels + i). With Pillow installed,
+image files (an animated GIF or a list of frames) are read row-major instead.
+
+Usage:
+    tools/ws2812clip.py anim.rgb clip_fire --pixels 60 --fps 30 \\
+        -o demos/clip_fire.c [--lanes 1] [--bits 24] [--order GRB] \\
+        [--brightness 64] [--gamma] [--encoding auto|raw|delta]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x50494C43  # "CLIP"
+VERSION = 1
+RAW, DELTA = 0, 1
+OP_SKIP, OP_COPY, OP_FILL = 0, 1, 2
+OP_SHIFT = 30
+COUNT_MASK = 0x3FFFFFFF
+
+# Wire byte slot of R, G, B for each hw_ws2812_order_t (W always last)
+ORDERS = {
+    "GRB": (1, 0, 2),
+    "RGB": (0, 1, 2),
+    "BRG": (1, 2, 0),
+    "RBG": (0, 2, 1),
+    "GBR": (2, 0, 1),
+    "BGR": (2, 1, 0),
+}
+ORDER_IDS = {name: i for i, name in enumerate(ORDERS)}
+
+
+def load_frames(paths, channels, count):
+    """Return a list of frames, each a list of `count` channel tuples."""
+    size = count * channels
+    frames = []
+    for path in paths:
+        ext = os.path.splitext(path)[1].lower()
+        if ext in (".rgb", ".rgbw", ".bin", ".raw"):
+            data = open(path, "rb").read()
+            if len(data) % size:
+                sys.exit(f"{path}: {len(data)} bytes is not a whole number of {size}-byte frames")
+            for off in range(0, len(data), size):
+                chunk = data[off:off + size]
+                frames.append([tuple(chunk[i:i + channels]) for i in range(0, size, channels)])
+        else:
+            frames.extend(load_images(path, channels, count))
+    return frames
+
+
+def load_images(path, channels, count):
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        sys.exit(f"{path}: reading images needs Pillow (or convert to raw .rgb)")
+    out = []
+    for im in ImageSequence.Iterator(Image.open(path)):
+        px = list(im.convert("RGBA" if channels == 4 else "RGB").getdata())
+        if len(px) != count:
+            sys.exit(f"{path}: frame has {len(px)} pixels, expected {count}")
+        out.append([p[:channels] for p in px])
+    return out
+
+
+def output_stage(value, scale, gamma):
+    """8-bit channel after the baked brightness/gamma stage."""
+    if gamma:
+        value = round(255 * (value / 255) ** 2.2)
+    return (value * scale) >> 8
+
+
+def pixel_word(color, slots, channels, scale, gamma):
+    """MSB-first wire word for one pixel, as output_pixel() builds it."""
+    c = [output_stage(v, scale, gamma) for v in color]
+    word = 0
+    for ch in range(3):
+        word |= c[ch] << (24 - 8 * slots[ch])
+    if channels == 4:
+        word |= c[3]
+    return word
+
+
+def transpose8(lanes):
+    """planes[k] holds bit (7 - k) of every lane byte, lane L in bit L."""
+    planes = []
+    for k in range(8):
+        bit = 7 - k
+        planes.append(sum(((lanes[l] >> bit) & 1) << l for l in range(8)))
+    return planes
+
+
+def encode_frame(frame, args, slots, channels, scale):
+    n = args.pixels
+    words = [pixel_word(frame[i], slots, channels, scale, args.gamma) for i in range(n * args.lanes)]
+    if args.lanes == 1:
+        return words
+
+    out = bytearray()
+    for i in range(n):
+        lane_words = [words[lane * n + i] if lane < args.lanes else 0 for lane in range(8)]
+        for c in range(channels):
+            out += bytes(transpose8([(w >> (24 - 8 * c)) & 0xFF for w in lane_words]))
+    return list(struct.unpack(f"<{len(out) // 4}I", out))
+
+
+def delta_record(cur, prev):
+    """Skip / copy / fill ops turning prev into cur (prev None: keyframe)."""
+    ops = []
+    lit = []
+
+    def flush():
+        if lit:
+            ops.append((OP_COPY << OP_SHIFT) | len(lit))
+            ops.extend(lit)
+            lit.clear()
+
+    i, n = 0, len(cur)
+    while i < n:
+        if prev is not None and cur[i] == prev[i]:
+            j = i
+            while j < n and cur[j] == prev[j]:
+                j += 1
+            if j - i >= 2 or j == n:
+                flush()
+                ops.append((OP_SKIP << OP_SHIFT) | (j - i))
+                i = j
+                continue
+        j = i
+        while j < n and cur[j] == cur[i]:
+            j += 1
+        if j - i >= 3:
+            flush()
+            ops.extend([(OP_FILL << OP_SHIFT) | (j - i), cur[i]])
+            i = j
+            continue
+        lit.append(cur[i])
+        i += 1
+    flush()
+    return [len(ops)] + ops
+
+
+def apply_record(rec, wire):
+    """Reference decoder, mirroring decode_delta() in led_clip.c."""
+    pos, k, stop = 0, 1, 1 + rec[0]
+    while k < stop:
+        code, count = rec[k] >> OP_SHIFT, rec[k] & COUNT_MASK
+        k += 1
+        if code == OP_COPY:
+            wire[pos:pos + count] = rec[k:k + count]
+            k += count
+        elif code == OP_FILL:
+            wire[pos:pos + count] = [rec[k]] * count
+            k += 1
+        pos += count
+    return stop
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="raw .rgb/.rgbw frame files or images (last positional is the C name)")
+    ap.add_argument("--pixels", type=int, required=True, help="LEDs per strip (per lane)")
+    ap.add_argument("--lanes", type=int, default=1, help="parallel strips (default 1)")
+    ap.add_argument("--bits", type=int, choices=(24, 32), default=24, help="wire bits per pixel (default 24)")
+    ap.add_argument("--order", choices=ORDERS, default="GRB", help="color byte order (default GRB)")
+    ap.add_argument("--fps", type=float, default=30, help="playback rate (default 30)")
+    ap.add_argument("--brightness", type=int, default=255, help="baked brightness 0-255 (default 255)")
+    ap.add_argument("--gamma", action="store_true", help="bake gamma 2.2")
+    ap.add_argument("--encoding", choices=("auto", "raw", "delta"), default="auto",
+                    help="frame storage (default auto: the smaller)")
+    ap.add_argument("-o", "--output", help="output .c (const array) or .bin file (default: stdout, C)")
+    args = ap.parse_args()
+
+    if len(args.inputs) < 2:
+        ap.error("need at least one input and a C symbol name")
+    *paths, name = args.inputs
+    if not 1 <= args.lanes <= 8:
+        ap.error("--lanes must be 1..8")
+    if args.pixels * args.lanes > 0xFFFF:
+        ap.error("too many pixels")
+
+    channels = args.bits // 8
+    slots = ORDERS[args.order]
+    scale = args.brightness + (args.brightness >> 7)
+    frames = load_frames(paths, channels, args.pixels * args.lanes)
+    if not frames:
+        sys.exit("no frames")
+
+    wire = [encode_frame(f, args, slots, channels, scale) for f in frames]
+    frame_words = len(wire[0])
+
+    raw = [w for frame in wire for w in frame]
+    delta = []
+    prev = None
+    for frame in wire:
+        delta += delta_record(frame, prev)
+        prev = frame
+
+    # Round-trip the delta stream through the reference decoder
+    buf = [0] * frame_words
+    k = 0
+    for frame in wire:
+        k += apply_record(delta[k:], buf)
+        assert buf == frame, "delta encoder round-trip failed"
+
+    encoding = args.encoding
+    if encoding == "auto":
+        encoding = "delta" if len(delta) < len(raw) else "raw"
+    data = delta if encoding == "delta" else raw
+
+    frame_us = round(1e6 / args.fps)
+    header = struct.pack("<IBBBBHHIIII", MAGIC, VERSION, DELTA if encoding == "delta" else RAW,
+                         args.bits, ORDER_IDS[args.order], args.pixels, args.lanes,
+                         frame_words, len(frames), frame_us, len(data))
+    words = list(struct.unpack(f"<{len(header) // 4}I", header)) + data
+
+    changed = sum(sum(1 for a, b in zip(cur, prev) if a != b) for prev, cur in zip(wire, wire[1:]))
+    sys.stderr.write(
+        f"{name}: {len(frames)} frames x {frame_words} words, {encoding}\n"
+        f"  raw   {len(raw) * 4:8d} bytes (streamed by DMA from flash, no per-frame CPU)\n"
+        f"  delta {len(delta) * 4:8d} bytes ({100 * len(delta) / len(raw):.1f}% of raw, "
+        f"{changed / max(len(wire) - 1, 1):.0f} of {frame_words} words rewritten per frame)\n")
+
+    if args.output and args.output.endswith(".bin"):
+        with open(args.output, "wb") as f:
+            f.write(struct.pack(f"<{len(words)}I", *words))
+        return
+
+    src = ", ".join(os.path.basename(p) for p in paths)
+    out = []
+    out.append(f"// Generated by tools/ws2812clip.py from {src} - do not edit.")
+    out.append(f"// {len(frames)} frames, {args.pixels} px x {args.lanes} lane(s), {args.bits}-bit {args.order}, "
+               f"{encoding}, {len(words) * 4} bytes")
+    out.append("")
+    out.append("#include <stddef.h>")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append(f"const uint32_t {name}[] = {{")
+    for i in range(0, len(words), 6):
+        out.append("    " + ", ".join(f"0x{w:08X}" for w in words[i:i + 6]) + ",")
+    out.append("};")
+    out.append("")
+    out.append(f"const size_t {name}_words = sizeof({name}) / sizeof({name}[0]);")
+
+    text = "\n".join(out) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()